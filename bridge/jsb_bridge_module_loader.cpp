@@ -2,6 +2,7 @@
 #include "jsb_type_convert.h"
 #include "jsb_editor_utility_funcs.h"
 #include "jsb_callable.h"
+#include "jsb_json.h"
 
 namespace jsb
 {
@@ -26,6 +27,38 @@ namespace jsb
             info.GetReturnValue().Set(impl::Helper::to_array_buffer(isolate, var));
         }
 
+        // [js] function to_shared_array_buffer(packed: PackedByteArray): ArrayBuffer;
+        // the returned ArrayBuffer takes over the memory of the PackedByteArray (it's left empty),
+        // it's copied only if the memory is still shared with other PackedByteArray values (copy-on-write)
+        void _to_shared_array_buffer(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            if (info[0]->IsObject() && TypeConvert::is_variant(info[0].As<v8::Object>()))
+            {
+                // move the data out of the wrapper, otherwise the wrapper still holds a reference and it always copies
+                Variant* target = (Variant*) info[0].As<v8::Object>()->GetAlignedPointerFromInternalField(IF_Pointer);
+                if (target && target->get_type() == Variant::PACKED_BYTE_ARRAY)
+                {
+                    Vector<uint8_t> packed = *target;
+                    *target = PackedByteArray();
+                    info.GetReturnValue().Set(impl::Helper::to_shared_array_buffer(isolate, packed));
+                    return;
+                }
+            }
+
+            // converted from other types (a fresh copy)
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            Variant var;
+            if (!TypeConvert::js_to_gd_var(isolate, context, info[0], Variant::PACKED_BYTE_ARRAY, var))
+            {
+                jsb_throw(isolate, "bad parameter");
+                return;
+            }
+            Vector<uint8_t> packed = var;
+            var = Variant();
+            info.GetReturnValue().Set(impl::Helper::to_shared_array_buffer(isolate, packed));
+        }
+
         // construct a callable object
         // [js] function callable(fn: Function): godot.Callable;
         // [js] function callable(thiz: godot.Object, fn: Function): godot.Callable;
@@ -121,6 +154,244 @@ namespace jsb
             environment->notify_microtasks_run();
         }
 
+        // [js] function read_file_async(path: string, callback: (error: string | undefined, data: ArrayBuffer | undefined) => void): void;
+        // the underlying function of `jsb.fs.read`
+        void _read_file_async(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            if (!info[0]->IsString() || !info[1]->IsFunction())
+            {
+                jsb_throw(isolate, "bad param");
+                return;
+            }
+            Environment* environment = Environment::wrap(isolate);
+            environment->load_file_async(impl::Helper::to_string(isolate, info[0]), info[1].As<v8::Function>());
+        }
+
+        // [js] function parse_json_async(text: string | ArrayBuffer | PackedByteArray, callback: (error: string | undefined, data: any) => void): void;
+        // the underlying function of `jsb.json.parseAsync`
+        void _parse_json_async(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            if (!info[1]->IsFunction())
+            {
+                jsb_throw(isolate, "bad param");
+                return;
+            }
+            Environment* environment = Environment::wrap(isolate);
+            if (info[0]->IsString())
+            {
+                environment->parse_json_async(impl::Helper::to_string(isolate, info[0]), info[1].As<v8::Function>());
+                return;
+            }
+            Variant var;
+            if (!TypeConvert::js_to_gd_var(isolate, context, info[0], Variant::PACKED_BYTE_ARRAY, var))
+            {
+                jsb_throw(isolate, "bad param");
+                return;
+            }
+            environment->parse_json_async((PackedByteArray) var, info[1].As<v8::Function>());
+        }
+
+        // [js] function stringify_json(value: any, space?: string | number): PackedByteArray | undefined;
+        // the underlying function of `jsb.json.stringifyToBuffer`
+        void _stringify_json(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            PackedByteArray buffer;
+            if (!JSONHelper::stringify(isolate, context, info[0], info[1], buffer))
+            {
+                // an exception is thrown, or the value is not serializable
+                return;
+            }
+            v8::Local<v8::Value> rval;
+            if (!TypeConvert::gd_var_to_js(isolate, context, buffer, rval))
+            {
+                jsb_throw(isolate, "failed to translate PackedByteArray");
+                return;
+            }
+            info.GetReturnValue().Set(rval);
+        }
+
+        // [js] function stringify_json_to_file(path: string, value: any, space?: string | number): boolean;
+        // the underlying function of `jsb.json.stringifyToFile`
+        void _stringify_json_to_file(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            if (!info[0]->IsString())
+            {
+                jsb_throw(isolate, "bad param");
+                return;
+            }
+            // serialized before opening the file, the existing file is left untouched if it fails
+            PackedByteArray buffer;
+            if (!JSONHelper::stringify(isolate, context, info[1], info[2], buffer))
+            {
+                // an exception is thrown, or the value is not serializable
+                info.GetReturnValue().Set(v8::Boolean::New(isolate, false));
+                return;
+            }
+            const String path = impl::Helper::to_string(isolate, info[0]);
+            Error err;
+            const Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE, &err);
+            if (file.is_null())
+            {
+                impl::Helper::throw_error(isolate, jsb_format("failed to open %s (%s)", path, error_names[err]));
+                return;
+            }
+            file->store_buffer(buffer.ptr(), buffer.size());
+            info.GetReturnValue().Set(v8::Boolean::New(isolate, true));
+        }
+
+        // [js] function load_resource_async(path: string, type_hint: string, use_sub_threads: boolean, callback: (error: string | undefined, resource: Resource | undefined) => void): number;
+        // the underlying function of `jsb.load`, return the token for `cancel_load_resource`
+        void _load_resource_async(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            if (!info[0]->IsString() || !info[3]->IsFunction())
+            {
+                jsb_throw(isolate, "bad param");
+                return;
+            }
+            Environment* environment = Environment::wrap(isolate);
+            const String type_hint = info[1]->IsString() ? impl::Helper::to_string(isolate, info[1]) : String();
+            const uint32_t token = environment->load_resource_async(impl::Helper::to_string(isolate, info[0]), type_hint, info[2]->BooleanValue(isolate), info[3].As<v8::Function>());
+            info.GetReturnValue().Set(v8::Uint32::NewFromUnsigned(isolate, token));
+        }
+
+        // [js] function cancel_load_resource(token: number): boolean;
+        void _cancel_load_resource(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            int32_t token;
+            if (!info[0]->IsNumber() || !info[0]->Int32Value(context).To(&token))
+            {
+                jsb_throw(isolate, "bad param");
+                return;
+            }
+            Environment* environment = Environment::wrap(isolate);
+            info.GetReturnValue().Set(v8::Boolean::New(isolate, environment->cancel_load_resource((uint32_t) token)));
+        }
+
+        // [js] function eval_script(source: string, filename?: string): any;
+        // unlike indirect `eval`, top-level let/const/class declarations of a global script are kept in the global lexical scope (used by REPL)
+        void _eval_script(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            if (!info[0]->IsString())
+            {
+                jsb_throw(isolate, "bad param");
+                return;
+            }
+            const CharString source = impl::Helper::to_string(isolate, info[0]).utf8();
+            const String filename = info[1]->IsString() ? impl::Helper::to_string(isolate, info[1]) : String();
+
+            // the exception (if any) is left to the caller
+            v8::Local<v8::Value> rval;
+            if (impl::Helper::eval(context, source.get_data(), source.length(), filename).ToLocal(&rval))
+            {
+                info.GetReturnValue().Set(rval);
+            }
+        }
+
+        // [js] function commands.call(target: godot.Object, method: string, ...args: any[]): void;
+        void _commands_call(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            Object* gd_object;
+            if (info.Length() < 2 || !TypeConvert::js_to_gd_obj(isolate, context, info[0], gd_object) || !gd_object || !info[1]->IsString())
+            {
+                jsb_throw(isolate, "bad param");
+                return;
+            }
+
+            // resolve the MethodBind while recording, script methods are called by name
+            const StringName method_name = impl::Helper::to_string(isolate, info[1]);
+            const MethodBind* method_bind = ClassDB::get_method(gd_object->get_class_name(), method_name);
+            const int argc = info.Length() - 2;
+            int method_argc = 0;
+            if (method_bind)
+            {
+                method_argc = method_bind->get_argument_count();
+                if (!internal::VariantUtil::check_argc(method_bind->is_vararg(), argc, method_bind->get_default_argument_count(), method_argc))
+                {
+                    jsb_throw(isolate, "num of arguments does not meet the requirement");
+                    return;
+                }
+            }
+            else if (!gd_object->has_method(method_name))
+            {
+                jsb_throw(isolate, "method not found");
+                return;
+            }
+
+            // the conversion may run scripts (e.g. getters) which record other commands,
+            // the command is recorded only after all arguments converted.
+            Variant* args = jsb_stackalloc(Variant, argc);
+            for (int index = 0; index < argc; ++index)
+            {
+                memnew_placement(&args[index], Variant);
+                const Variant::Type type = index >= method_argc
+                    ? Variant::Type::NIL
+                    : method_bind->get_argument_type(index);
+                if (!TypeConvert::js_to_gd_var(isolate, context, info[index + 2], type, args[index]))
+                {
+                    // revert all constructors
+                    const String error_message = jsb_errorf("bad argument: %d", index);
+                    while (index >= 0) { args[index--].~Variant(); }
+                    impl::Helper::throw_error(isolate, error_message);
+                    return;
+                }
+            }
+            Environment::wrap(isolate)->get_command_buffer().add_call(gd_object->get_instance_id(), method_bind, method_name, args, argc);
+
+            // don't forget to destruct all stack allocated variants
+            for (int index = 0; index < argc; ++index)
+            {
+                args[index].~Variant();
+            }
+        }
+
+        // [js] function commands.set(target: godot.Object, property: string, value: any): void;
+        void _commands_set(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+            Object* gd_object;
+            if (!TypeConvert::js_to_gd_obj(isolate, context, info[0], gd_object) || !gd_object || !info[1]->IsString())
+            {
+                jsb_throw(isolate, "bad param");
+                return;
+            }
+            Variant value;
+            if (!TypeConvert::js_to_gd_var(isolate, context, info[2], value))
+            {
+                jsb_throw(isolate, "bad value");
+                return;
+            }
+            Environment::wrap(isolate)->get_command_buffer().add_set(gd_object->get_instance_id(), impl::Helper::to_string(isolate, info[1]), value);
+        }
+
+        // [js] function commands.flush(): number;
+        void _commands_flush(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            info.GetReturnValue().Set(v8::Uint32::NewFromUnsigned(isolate, Environment::wrap(isolate)->get_command_buffer().flush()));
+        }
+
+        // [js] function commands.size(): number;
+        void _commands_size(const v8::FunctionCallbackInfo<v8::Value>& info)
+        {
+            v8::Isolate* isolate = info.GetIsolate();
+            info.GetReturnValue().Set(v8::Uint32::NewFromUnsigned(isolate, Environment::wrap(isolate)->get_command_buffer().size()));
+        }
+
         // interface RPCConfig {
         //     mode?: MultiplayerAPI.RPCMode,
         //     sync?: boolean,
@@ -385,13 +656,13 @@ namespace jsb
             info.GetReturnValue().Set(module.module);
         }
 
-        // function add_script_signal(target: any, signal_name: string): void;
+        // function add_script_signal(target: any, signal_name: string, arguments?: string[]): void;
         void _add_script_signal(const v8::FunctionCallbackInfo<v8::Value> &info)
         {
             v8::Isolate* isolate = info.GetIsolate();
             v8::HandleScope handle_scope(isolate);
             v8::Local<v8::Context> context = isolate->GetCurrentContext();
-            if (info.Length() != 2 || !info[0]->IsObject() || !info[1]->IsString())
+            if (info.Length() < 2 || info.Length() > 3 || !info[0]->IsObject() || !info[1]->IsString())
             {
                 jsb_throw(isolate, "bad param");
                 return;
@@ -418,7 +689,18 @@ namespace jsb
                 index = collection->Length();
             }
 
-            collection->Set(context, index, signal).Check();
+            if (info.Length() == 3 && info[2]->IsArray())
+            {
+                // signal with declared arguments
+                const v8::Local<v8::Object> details = v8::Object::New(isolate);
+                details->Set(context, jsb_name(environment, name), signal).Check();
+                details->Set(context, jsb_name(environment, arguments), info[2]).Check();
+                collection->Set(context, index, details).Check();
+            }
+            else
+            {
+                collection->Set(context, index, signal).Check();
+            }
             JSB_LOG(VeryVerbose, "script %s define signal %s",
                 impl::Helper::to_string_opt(isolate, target->Get(context, jsb_name(environment, name))),
                 impl::Helper::to_string(isolate, signal));
@@ -456,6 +738,7 @@ namespace jsb
             jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "impl"), impl::Helper::new_string(isolate, JSB_IMPL_VERSION_STRING)).Check();
             jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "callable"), JSB_NEW_FUNCTION(context, _new_callable, {})).Check();
             jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "to_array_buffer"), JSB_NEW_FUNCTION(context, _to_array_buffer, {})).Check();
+            jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "to_shared_array_buffer"), JSB_NEW_FUNCTION(context, _to_shared_array_buffer, {})).Check();
 
             // jsb.internal
             {
@@ -475,6 +758,25 @@ namespace jsb
                 internal_obj->Set(context, impl::Helper::new_string_ascii(isolate, "set_script_doc"), JSB_NEW_FUNCTION(context, _set_script_doc, {})).Check();
                 internal_obj->Set(context, impl::Helper::new_string_ascii(isolate, "notify_microtasks_run"), JSB_NEW_FUNCTION(context, _notify_microtasks_run, {})).Check();
                 internal_obj->Set(context, impl::Helper::new_string_ascii(isolate, "get_type_name"), JSB_NEW_FUNCTION(context, _get_type_name, {})).Check();
+                internal_obj->Set(context, impl::Helper::new_string_ascii(isolate, "read_file_async"), JSB_NEW_FUNCTION(context, _read_file_async, {})).Check();
+                internal_obj->Set(context, impl::Helper::new_string_ascii(isolate, "parse_json_async"), JSB_NEW_FUNCTION(context, _parse_json_async, {})).Check();
+                internal_obj->Set(context, impl::Helper::new_string_ascii(isolate, "stringify_json"), JSB_NEW_FUNCTION(context, _stringify_json, {})).Check();
+                internal_obj->Set(context, impl::Helper::new_string_ascii(isolate, "stringify_json_to_file"), JSB_NEW_FUNCTION(context, _stringify_json_to_file, {})).Check();
+                internal_obj->Set(context, impl::Helper::new_string_ascii(isolate, "load_resource_async"), JSB_NEW_FUNCTION(context, _load_resource_async, {})).Check();
+                internal_obj->Set(context, impl::Helper::new_string_ascii(isolate, "cancel_load_resource"), JSB_NEW_FUNCTION(context, _cancel_load_resource, {})).Check();
+                internal_obj->Set(context, impl::Helper::new_string_ascii(isolate, "eval_script"), JSB_NEW_FUNCTION(context, _eval_script, {})).Check();
+            }
+
+            // jsb.commands
+            {
+                v8::Local<v8::Object> commands_obj = v8::Object::New(isolate);
+
+                jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "commands"), commands_obj).Check();
+
+                commands_obj->Set(context, impl::Helper::new_string_ascii(isolate, "call"), JSB_NEW_FUNCTION(context, _commands_call, {})).Check();
+                commands_obj->Set(context, impl::Helper::new_string_ascii(isolate, "set"), JSB_NEW_FUNCTION(context, _commands_set, {})).Check();
+                commands_obj->Set(context, impl::Helper::new_string_ascii(isolate, "flush"), JSB_NEW_FUNCTION(context, _commands_flush, {})).Check();
+                commands_obj->Set(context, impl::Helper::new_string_ascii(isolate, "size"), JSB_NEW_FUNCTION(context, _commands_size, {})).Check();
             }
 
             // internal 'jsb.editor'
@@ -2,6 +2,8 @@
 #include "jsb_object_bindings.h"
 #include "jsb_type_convert.h"
 
+#include <algorithm>
+
 //TODO it breaks the isolation of 'bridge'
 #include "../weaver/jsb_script.h"
 
@@ -188,9 +190,24 @@ namespace jsb
                 for (uint32_t index = 0; index < len; ++index)
                 {
                     v8::Local<v8::Value> element = collection->Get(p_context, index).ToLocalChecked();
+                    ScriptSignalInfo signal_info;
+                    if (element->IsObject())
+                    {
+                        // { name, arguments } if arguments are declared
+                        const v8::Local<v8::Object> obj = element.As<v8::Object>();
+                        if (v8::Local<v8::Value> val; obj->Get(p_context, jsb_name(environment, arguments)).ToLocal(&val) && val->IsArray())
+                        {
+                            const v8::Local<v8::Array> arguments = val.As<v8::Array>();
+                            for (uint32_t arg_index = 0, arg_len = arguments->Length(); arg_index < arg_len; ++arg_index)
+                            {
+                                signal_info.arguments.push_back(impl::Helper::to_string(isolate, arguments->Get(p_context, arg_index).ToLocalChecked()));
+                            }
+                        }
+                        element = obj->Get(p_context, jsb_name(environment, name)).ToLocalChecked();
+                    }
                     jsb_check(element->IsString());
                     const StringName signal = impl::Helper::to_string(isolate, element);
-                    p_class_info->signals.insert(signal, {});
+                    p_class_info->signals.insert(signal, signal_info);
 
                     // instantiate a fake Signal property
                     const StringNameID string_id = environment->get_string_name_cache().get_string_id(signal);
@@ -237,6 +254,160 @@ namespace jsb
         }
     }
 
+#if JSB_SUPPORT_RELOAD && defined(TOOLS_ENABLED)
+    // the part of a script class which must be unchanged to reload the class in place
+    struct ScriptClassShape
+    {
+        NativeClassID native_class_id;
+        StringName base_script_module_id;
+        HashMap<StringName, ScriptPropertyInfo> properties;
+        HashMap<StringName, ScriptSignalInfo> signals;
+
+        explicit ScriptClassShape(const ScriptClassInfo& p_class_info)
+            : native_class_id(p_class_info.native_class_id), base_script_module_id(p_class_info.base_script_module_id),
+              properties(p_class_info.properties), signals(p_class_info.signals)
+        {}
+
+        bool is_compatible(const ScriptClassInfo& p_class_info) const
+        {
+            if (native_class_id != p_class_info.native_class_id
+                || base_script_module_id != p_class_info.base_script_module_id
+                || properties.size() != p_class_info.properties.size()
+                || signals.size() != p_class_info.signals.size())
+            {
+                return false;
+            }
+            for (const KeyValue<StringName, ScriptSignalInfo>& kv : signals)
+            {
+                const ScriptSignalInfo* other = p_class_info.signals.getptr(kv.key);
+                if (!other || other->arguments.size() != kv.value.arguments.size()) return false;
+            }
+            for (const KeyValue<StringName, ScriptPropertyInfo>& kv : properties)
+            {
+                const ScriptPropertyInfo* other = p_class_info.properties.getptr(kv.key);
+                if (!other
+                    || other->type != kv.value.type || other->hint != kv.value.hint || other->usage != kv.value.usage
+                    || other->hint_string != kv.value.hint_string || other->class_name != kv.value.class_name)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    // call `Reflect[p_name](argv...)`
+    template<size_t N>
+    bool _call_reflect(const v8::Local<v8::Context>& p_context, const v8::Local<v8::Object>& p_reflect, const v8::Local<v8::Value>& p_name, v8::Local<v8::Value> (&argv)[N], v8::Local<v8::Value>& r_result)
+    {
+        v8::Local<v8::Value> func;
+        return p_reflect->Get(p_context, p_name).ToLocal(&func) && func->IsFunction()
+            && func.As<v8::Function>()->Call(p_context, p_reflect, (int) N, argv).ToLocal(&r_result);
+    }
+
+    // replace all members (except `constructor`) of `p_target` with the members of `p_source`, and inherit from the same base prototype.
+    // members are copied with their property descriptors (accessors and non-enumerable methods are kept as they are).
+    bool _patch_prototype(const v8::Local<v8::Context>& p_context, const v8::Local<v8::Object>& p_target, const v8::Local<v8::Object>& p_source)
+    {
+        v8::Isolate* isolate = p_context->GetIsolate();
+        Environment* environment = Environment::wrap(isolate);
+        v8::Local<v8::Value> reflect;
+        if (!p_context->Global()->Get(p_context, jsb_name(environment, Reflect)).ToLocal(&reflect) || !reflect->IsObject())
+        {
+            return false;
+        }
+        const v8::Local<v8::Object> reflect_obj = reflect.As<v8::Object>();
+        const auto is_constructor = [isolate](const v8::Local<v8::Value>& p_key)
+        {
+            return p_key->IsString() && impl::Helper::to_string(isolate, p_key) == "constructor";
+        };
+
+        // remove members which do not exist in the latest version
+        v8::Local<v8::Value> keys;
+        v8::Local<v8::Value> target_argv[] = { p_target };
+        if (!_call_reflect(p_context, reflect_obj, jsb_name(environment, ownKeys), target_argv, keys) || !keys->IsArray())
+        {
+            return false;
+        }
+        {
+            const v8::Local<v8::Array> array = keys.As<v8::Array>();
+            for (uint32_t index = 0, len = array->Length(); index < len; ++index)
+            {
+                const v8::Local<v8::Value> key = array->Get(p_context, index).ToLocalChecked();
+                if (is_constructor(key) || p_source->HasOwnProperty(p_context, key.As<v8::Name>()).FromMaybe(false)) continue;
+                v8::Local<v8::Value> rval;
+                v8::Local<v8::Value> argv[] = { p_target, key };
+                if (!_call_reflect(p_context, reflect_obj, jsb_name(environment, deleteProperty), argv, rval)) return false;
+            }
+        }
+
+        // copy members of the latest version
+        v8::Local<v8::Value> source_argv[] = { p_source };
+        if (!_call_reflect(p_context, reflect_obj, jsb_name(environment, ownKeys), source_argv, keys) || !keys->IsArray())
+        {
+            return false;
+        }
+        {
+            const v8::Local<v8::Array> array = keys.As<v8::Array>();
+            for (uint32_t index = 0, len = array->Length(); index < len; ++index)
+            {
+                const v8::Local<v8::Value> key = array->Get(p_context, index).ToLocalChecked();
+                if (is_constructor(key)) continue;
+                v8::Local<v8::Value> descriptor, rval;
+                v8::Local<v8::Value> get_argv[] = { p_source, key };
+                if (!_call_reflect(p_context, reflect_obj, jsb_name(environment, getOwnPropertyDescriptor), get_argv, descriptor) || !descriptor->IsObject()) return false;
+                v8::Local<v8::Value> define_argv[] = { p_target, key, descriptor };
+                if (!_call_reflect(p_context, reflect_obj, jsb_name(environment, defineProperty), define_argv, rval)) return false;
+            }
+        }
+        return p_target->SetPrototype(p_context, p_source->GetPrototype()).FromMaybe(false);
+    }
+
+    // patch prototypes of previous versions instead of rebinding all live instances if the shape of class is not changed
+    void _update_live_prototypes(const v8::Local<v8::Context>& p_context, const ScriptClassInfoPtr& p_class_info, const v8::Local<v8::Object>& p_class_obj, bool p_compatible)
+    {
+        v8::Isolate* isolate = p_context->GetIsolate();
+        Environment* environment = Environment::wrap(isolate);
+        const v8::Local<v8::Object> prototype = p_class_obj->Get(p_context, jsb_name(environment, prototype)).ToLocalChecked().As<v8::Object>();
+
+        // prototypes of previous versions are collected if no instance references them anymore
+        std::vector<v8::Global<v8::Object>>& live_prototypes = p_class_info->live_prototypes;
+        live_prototypes.erase(std::remove_if(live_prototypes.begin(), live_prototypes.end(),
+            [](const v8::Global<v8::Object>& p_prototype) { return p_prototype.IsEmpty(); }), live_prototypes.end());
+
+        if (p_compatible && !live_prototypes.empty())
+        {
+            const impl::TryCatch try_catch(isolate);
+            bool patched = true;
+            for (const v8::Global<v8::Object>& live_prototype : live_prototypes)
+            {
+                if (!_patch_prototype(p_context, live_prototype.Get(isolate), prototype))
+                {
+                    patched = false;
+                    if (try_catch.has_caught())
+                    {
+                        JSB_LOG(Warning, "failed to patch prototype of %s\n%s", p_class_info->js_class_name, BridgeHelper::get_exception(try_catch));
+                    }
+                    break;
+                }
+            }
+            if (patched)
+            {
+                p_class_info->flags = (ScriptClassFlags::Type) (p_class_info->flags | ScriptClassFlags::_Patched);
+                JSB_LOG(Verbose, "%s reloaded in place (%d prototypes patched)", p_class_info->js_class_name, (int) live_prototypes.size());
+                live_prototypes.emplace_back(isolate, prototype);
+                live_prototypes.back().SetWeak();
+                return;
+            }
+        }
+
+        // all live instances will be rebound to the latest prototype
+        live_prototypes.clear();
+        live_prototypes.emplace_back(isolate, prototype);
+        live_prototypes.back().SetWeak();
+    }
+#endif
+
     void ScriptClassInfo::instantiate(const StringName& p_module_id, const v8::Local<v8::Object>& p_self)
     {
         const String source_path = internal::PathUtil::convert_javascript_path(p_module_id);
@@ -307,6 +478,11 @@ namespace jsb
             p_module.script_class_id = script_class_id;
             existed_class_info->module_id = p_module.id;
         }
+#if JSB_SUPPORT_RELOAD && defined(TOOLS_ENABLED)
+        // the shape of the previous version (if reloading)
+        const bool reloading = !existed_class_info->js_class.IsEmpty();
+        const ScriptClassShape previous_shape(*existed_class_info);
+#endif
 
         // trick: save godot class id for convenience of getting it in JS class constructor
         class_obj->Set(p_context, jsb_symbol(environment, CrossBind), environment->get_string_value(p_module.id)).Check();
@@ -328,6 +504,9 @@ namespace jsb
         existed_class_info->native_class_id = native_class_id;
 
         _parse_script_class_iterate(p_context, existed_class_info, class_obj);
+#if JSB_SUPPORT_RELOAD && defined(TOOLS_ENABLED)
+        _update_live_prototypes(p_context, existed_class_info, class_obj, reloading && previous_shape.is_compatible(*existed_class_info));
+#endif
         return true;
     }
 
@@ -49,6 +49,16 @@ namespace jsb
             // unnecessary but used to avoid class lookup.
             Worker = 38,
 
+            // types for TextEncoder/TextDecoder.
+            TextEncoder = 40,
+            TextDecoder = 42,
+
+            // type for SceneBuilder (worker).
+            SceneBuilder = 44,
+
+            // type for GodotWeakRef.
+            GodotWeakRef = 46,
+
             // reserved for future use
             Custom = 64,
         };
@@ -126,6 +136,8 @@ namespace jsb
 
     struct ScriptSignalInfo
     {
+        // names of arguments (empty if not declared)
+        Vector<String> arguments;
     };
 
     struct ScriptMethodInfo
@@ -177,6 +189,10 @@ namespace jsb
 
             // (INTERNAL USE ONLY) whether the default value of properties are evaluated or not
             _Evaluated = 1 << 2,
+
+            // (INTERNAL USE ONLY) the class is reloaded by patching the prototypes of previous versions in place,
+            // live instances are not necessary to rebind
+            _Patched = 1 << 3,
         };
     }
 
@@ -232,6 +248,13 @@ namespace jsb
 
         internal::TypeGen<StringName, v8::Global<v8::Function>>::UnorderedMap method_cache;
 
+#if JSB_SUPPORT_RELOAD && defined(TOOLS_ENABLED)
+        // prototypes of all versions of the class which may be still referenced by live instances (including the latest one).
+        // they are patched in place on reload if the shape of the class is not changed.
+        // the handles are weak, the collected ones are pruned on reload.
+        std::vector<v8::Global<v8::Object>> live_prototypes;
+#endif
+
         static void instantiate(const StringName& p_module_id, const v8::Local<v8::Object>& p_self);
 
         static bool _parse_script_class(const v8::Local<v8::Context>& p_context, JavaScriptModule& p_module);
@@ -0,0 +1,92 @@
+#include "jsb_command_buffer.h"
+
+namespace jsb
+{
+    void CommandBuffer::add_call(ObjectID p_target, const MethodBind* p_method, const StringName& p_name, const Variant* p_args, int p_argc)
+    {
+        commands_.push_back({ Command::TYPE_CALL, (uint32_t) p_argc, (uint32_t) args_.size(), p_target, p_method, p_name });
+        args_.insert(args_.end(), p_args, p_args + p_argc);
+    }
+
+    void CommandBuffer::add_set(ObjectID p_target, const StringName& p_name, const Variant& p_value)
+    {
+        commands_.push_back({ Command::TYPE_SET, 1, (uint32_t) args_.size(), p_target, nullptr, p_name });
+        args_.push_back(p_value);
+    }
+
+    uint32_t CommandBuffer::flush()
+    {
+        // a command may record new commands (script methods), leave them to the next flush.
+        // it's also not allowed to flush recursively.
+        if (commands_.empty() || flushing_) return 0;
+        flushing_ = true;
+        std::swap(commands_, flushing_commands_);
+        std::swap(args_, flushing_args_);
+
+        uint32_t max_argc = 0;
+        for (const Command& command : flushing_commands_)
+        {
+            if (command.argc > max_argc) max_argc = command.argc;
+        }
+        const Variant** argv = jsb_stackalloc(const Variant*, max_argc);
+
+        uint32_t executed = 0;
+        for (const Command& command : flushing_commands_)
+        {
+            Object* obj = ObjectDB::get_instance(command.target);
+            if (!obj)
+            {
+                JSB_LOG(Verbose, "skip command on freed object %s", command.name);
+                continue;
+            }
+
+            switch (command.type)
+            {
+            case Command::TYPE_CALL:
+                {
+                    for (uint32_t index = 0; index < command.argc; ++index)
+                    {
+                        argv[index] = &flushing_args_[command.first_arg + index];
+                    }
+                    Callable::CallError error;
+                    if (command.method)
+                    {
+                        command.method->call(obj, argv, (int) command.argc, error);
+                    }
+                    else
+                    {
+                        obj->callp(command.name, argv, (int) command.argc, error);
+                    }
+                    if (error.error != Callable::CallError::CALL_OK)
+                    {
+                        JSB_LOG(Error, "failed to call %s.%s: %s", obj->get_class_name(), command.name,
+                            Variant::get_callable_error_text(Callable(obj, command.name), argv, (int) command.argc, error));
+                    }
+                } break;
+            case Command::TYPE_SET:
+                {
+                    bool valid;
+                    obj->set(command.name, flushing_args_[command.first_arg], &valid);
+                    if (!valid)
+                    {
+                        JSB_LOG(Error, "failed to set %s.%s", obj->get_class_name(), command.name);
+                    }
+                } break;
+            default: jsb_checkf(false, "unknown command: %d", command.type); break;
+            }
+            ++executed;
+        }
+
+        // release the values (Resources etc.) as soon as possible, but keep the capacity
+        flushing_commands_.clear();
+        flushing_args_.clear();
+        flushing_ = false;
+        return executed;
+    }
+
+    void CommandBuffer::clear()
+    {
+        commands_.clear();
+        args_.clear();
+    }
+}
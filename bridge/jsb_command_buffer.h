@@ -0,0 +1,63 @@
+#ifndef GODOTJS_COMMAND_BUFFER_H
+#define GODOTJS_COMMAND_BUFFER_H
+#include "jsb_bridge_pch.h"
+
+namespace jsb
+{
+    // engine calls recorded by `jsb.commands`, they're executed in one batch at the end of frame (in `Environment::update`)
+    // or explicitly by `jsb.commands.flush()` (e.g. at the beginning of `_physics_process`).
+    // unlike `call_deferred`/`set_deferred`, no Callable/Message is allocated in `MessageQueue` for each call,
+    // and the MethodBind is resolved while recording.
+    class CommandBuffer
+    {
+    public:
+        jsb_force_inline bool is_empty() const { return commands_.empty(); }
+        jsb_force_inline uint32_t size() const { return (uint32_t) commands_.size(); }
+
+        // record a method call, `p_method` is null for non-native methods (they're called with `Object::callp` by name).
+        // the arguments are copied, the caller converts them before recording (the conversion may record other commands).
+        void add_call(ObjectID p_target, const MethodBind* p_method, const StringName& p_name, const Variant* p_args, int p_argc);
+
+        // record a property assignment
+        void add_set(ObjectID p_target, const StringName& p_name, const Variant& p_value);
+
+        // execute all recorded commands in order, commands on freed objects are skipped.
+        // commands recorded while flushing are deferred to the next flush.
+        // return the number of executed commands.
+        uint32_t flush();
+
+        void clear();
+
+    private:
+        struct Command
+        {
+            enum Type : uint8_t
+            {
+                TYPE_CALL,
+                TYPE_SET,
+            };
+
+            Type type;
+            uint32_t argc;
+
+            // index of the first argument in `args_`
+            uint32_t first_arg;
+
+            ObjectID target;
+            const MethodBind* method;
+
+            // method name (TYPE_CALL) or property name (TYPE_SET)
+            StringName name;
+        };
+
+        // arguments of all commands are packed in one array.
+        // both of them are double buffered to keep the capacity.
+        std::vector<Command> commands_;
+        std::vector<Variant> args_;
+        std::vector<Command> flushing_commands_;
+        std::vector<Variant> flushing_args_;
+        bool flushing_ = false;
+    };
+}
+
+#endif
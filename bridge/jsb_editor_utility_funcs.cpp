@@ -295,14 +295,10 @@ namespace jsb
             set_field(isolate, context, signal_obj, "method_", method_obj);
         }
 
-        v8::Local<v8::Object> build_class_info(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const StringName& class_name)
+        v8::Local<v8::Object> build_class_info(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const ClassDB::ClassInfo& class_info)
         {
             v8::Local<v8::Object> class_info_obj = v8::Object::New(isolate);
-            const HashMap<StringName, ClassDB::ClassInfo>::Iterator class_it = ClassDB::classes.find(class_name);
-
-            jsb_check(class_it != ClassDB::classes.end());
-            const ClassDB::ClassInfo& class_info = class_it->value;
-            set_field(isolate, context, class_info_obj, "name", class_name);
+            set_field(isolate, context, class_info_obj, "name", class_info.name);
             set_field(isolate, context, class_info_obj, "super", class_info.inherits);
 
 #if JSB_EXCLUDE_GETSET_METHODS
@@ -439,6 +435,191 @@ namespace jsb
 
             return class_info_obj;
         }
+
+        // a content hash of class info (and class doc) for incremental codegen.
+        // it covers everything `build_class_info` and `_get_class_doc` return, no JS object is constructed.
+        struct ContentHasher
+        {
+            uint64_t value = 14695981039346656037ULL;
+
+            // for resolving the enum references (`A.B`) in PropertyInfo
+            const HashMap<StringName, ClassDB::ClassInfo>* classes = nullptr;
+
+            void add(uint64_t p_value)
+            {
+                value = (value ^ p_value) * 1099511628211ULL;
+            }
+
+            void add(int64_t p_value) { add((uint64_t) p_value); }
+            void add(int32_t p_value) { add((uint64_t) (int64_t) p_value); }
+            void add(uint32_t p_value) { add((uint64_t) p_value); }
+            void add(bool p_value) { add((uint64_t) p_value); }
+            void add(const String& p_value) { add(p_value.hash64()); add((int64_t) p_value.length()); }
+            void add(const StringName& p_value) { add(String(p_value)); }
+            void add(const Variant& p_value) { add((uint32_t) p_value.get_type()); add(p_value.recursive_hash(0)); }
+
+            void add(const PropertyInfo& p_info)
+            {
+                add(p_info.name);
+                add((uint32_t) p_info.type);
+                add(p_info.class_name);
+                if (classes)
+                {
+                    // `A.B` is emitted as is only if the class A has the enum B (see `make_classname` in codegen),
+                    // the class referencing it must be regenerated if the enum is added or removed.
+                    const String class_name = p_info.class_name;
+                    const int dot = class_name.find(".");
+                    if (dot > 0)
+                    {
+                        const ClassDB::ClassInfo* enum_owner = classes->getptr(class_name.substr(0, dot));
+                        add(enum_owner && enum_owner->enum_map.has(class_name.substr(dot + 1)));
+                    }
+                }
+                add((uint32_t) p_info.hint);
+                add(p_info.hint_string);
+                add((uint32_t) p_info.usage);
+            }
+
+            void add(const MethodInfo& p_info)
+            {
+                add(p_info.name);
+                add((uint32_t) p_info.flags);
+                add(p_info.return_val);
+                add((int32_t) p_info.arguments.size());
+                for (const PropertyInfo& arg_info : p_info.arguments) add(arg_info);
+                add((int32_t) p_info.default_arguments.size());
+                for (const Variant& value : p_info.default_arguments) add(value);
+            }
+
+            void add(MethodBind const* p_bind)
+            {
+                add(p_bind->get_name());
+                add((uint32_t) p_bind->get_hint_flags());
+                add(p_bind->is_static());
+                add(p_bind->is_const());
+                add(p_bind->is_vararg());
+                add(p_bind->has_return());
+                if (p_bind->has_return()) add(p_bind->get_return_info());
+                const int argc = p_bind->get_argument_count();
+                add(argc);
+                for (int index = 0; index < argc; ++index) add(p_bind->get_argument_info(index));
+                const Vector<Variant>& default_arguments = p_bind->get_default_arguments();
+                add((int32_t) default_arguments.size());
+                for (const Variant& value : default_arguments) add(value);
+            }
+
+            void add(const DocData::ClassDoc& p_doc)
+            {
+                add(p_doc.brief_description);
+                add((int32_t) p_doc.constants.size());
+                for (const DocData::ConstantDoc& doc : p_doc.constants) { add(doc.name); add(doc.description); }
+                add((int32_t) p_doc.methods.size());
+                for (const DocData::MethodDoc& doc : p_doc.methods) { add(doc.name); add(doc.description); }
+                add((int32_t) p_doc.properties.size());
+                for (const DocData::PropertyDoc& doc : p_doc.properties) { add(doc.name); add(doc.description); }
+                add((int32_t) p_doc.signals.size());
+                for (const DocData::MethodDoc& doc : p_doc.signals) { add(doc.name); add(doc.description); }
+            }
+
+            String to_string() const { return String::num_uint64(value, 16); }
+        };
+
+        // ClassDB and the doc data of the editor are not thread-safe,
+        // the codegen worker reads a copy of them taken on the main thread instead (see `_take_class_snapshot`).
+        struct ClassDataSnapshot
+        {
+            List<StringName> class_list;
+            HashMap<StringName, ClassDB::ClassInfo> classes;
+            HashMap<String, DocData::ClassDoc> docs;
+        };
+
+        Mutex class_snapshot_lock;
+        std::shared_ptr<const ClassDataSnapshot> class_snapshot;
+
+        // the class data read by the editor utility functions,
+        // it's the current snapshot if taken, otherwise ClassDB and the doc data themselves (only on the main thread).
+        struct ClassDataSource
+        {
+            std::shared_ptr<const ClassDataSnapshot> snapshot;
+            const HashMap<StringName, ClassDB::ClassInfo>* classes = nullptr;
+            const HashMap<String, DocData::ClassDoc>* docs = nullptr;
+
+            void get_class_list(List<StringName>* r_list) const
+            {
+                if (snapshot) *r_list = snapshot->class_list;
+                else ClassDB::get_class_list(r_list);
+            }
+        };
+
+        bool get_class_data_source(v8::Isolate* isolate, ClassDataSource& r_source)
+        {
+            {
+                MutexLock lock(class_snapshot_lock);
+                r_source.snapshot = class_snapshot;
+            }
+            if (r_source.snapshot)
+            {
+                r_source.classes = &r_source.snapshot->classes;
+                r_source.docs = &r_source.snapshot->docs;
+                return true;
+            }
+            if (!Thread::is_main_thread())
+            {
+                impl::Helper::throw_error(isolate, "class data is not accessible off the main thread without a snapshot (jsb.editor.take_class_snapshot)");
+                return false;
+            }
+            r_source.classes = &ClassDB::classes;
+            r_source.docs = &EditorHelp::get_doc_data()->class_list;
+            return true;
+        }
+
+        String hash_class(const ClassDataSource& p_source, const ClassDB::ClassInfo& p_class_info)
+        {
+            ContentHasher hasher;
+            hasher.classes = p_source.classes;
+            hasher.add(p_class_info.name);
+            hasher.add(p_class_info.inherits);
+            for (const KeyValue<StringName, ClassDB::PropertySetGet>& pair : p_class_info.property_setget)
+            {
+                hasher.add(pair.key);
+                hasher.add((uint32_t) pair.value.type);
+                hasher.add(pair.value.index);
+                hasher.add(pair.value.setter);
+                hasher.add(pair.value.getter);
+                if (const PropertyInfo* property_info = p_class_info.property_map.getptr(pair.key)) hasher.add(*property_info);
+            }
+            for (const KeyValue<StringName, MethodBind*>& pair : p_class_info.method_map) hasher.add(pair.value);
+            for (const KeyValue<StringName, MethodInfo>& pair : p_class_info.virtual_methods_map) hasher.add(pair.value);
+            for (const KeyValue<StringName, ClassDB::ClassInfo::EnumInfo>& pair : p_class_info.enum_map)
+            {
+                hasher.add(pair.key);
+                hasher.add(pair.value.is_bitfield);
+                for (const StringName& name : pair.value.constants) hasher.add(name);
+            }
+            for (const KeyValue<StringName, int64_t>& pair : p_class_info.constant_map)
+            {
+                hasher.add(pair.key);
+                hasher.add(pair.value);
+            }
+            for (const KeyValue<StringName, MethodInfo>& pair : p_class_info.signal_map) hasher.add(pair.value);
+            if (const DocData::ClassDoc* class_doc = p_source.docs->getptr(p_class_info.name))
+            {
+                hasher.add(*class_doc);
+            }
+            return hasher.to_string();
+        }
+
+        HashSet<StringName> get_ignored_classes()
+        {
+            const PackedStringArray ignored_classes = internal::Settings::get_ignored_classes();
+            const int ignored_classes_num = (int) ignored_classes.size();
+            HashSet<StringName> ignored_classes_set(ignored_classes_num);
+            for (int i = 0; i < ignored_classes_num; ++i)
+            {
+                ignored_classes_set.insert(ignored_classes[i]);
+            }
+            return ignored_classes_set;
+        }
     }
 
     struct OverloadedBinaryOperator
@@ -679,8 +860,11 @@ namespace jsb
         v8::HandleScope handle_scope(isolate);
         v8::Local<v8::Context> context = isolate->GetCurrentContext();
 
+        ClassDataSource source;
+        if (!get_class_data_source(isolate, source)) return;
+
         const String name = impl::Helper::to_string(isolate, info[0]);
-        if (const DocData::ClassDoc* ptr = EditorHelp::get_doc_data()->class_list.getptr(name))
+        if (const DocData::ClassDoc* ptr = source.docs->getptr(name))
         {
             const DocData::ClassDoc& class_doc = *ptr;
             v8::Local<v8::Object> class_doc_obj = v8::Object::New(isolate);
@@ -761,18 +945,15 @@ namespace jsb
         v8::HandleScope handle_scope(isolate);
         v8::Local<v8::Context> context = isolate->GetCurrentContext();
 
+        ClassDataSource source;
+        if (!get_class_data_source(isolate, source)) return;
+
         List<StringName> list;
-        ClassDB::get_class_list(&list);
+        source.get_class_list(&list);
 
         v8::Local<v8::Array> array = v8::Array::New(isolate);
         int index = 0;
-        const PackedStringArray ignored_classes = internal::Settings::get_ignored_classes();
-        const int ignored_classes_num = (int) ignored_classes.size();
-        HashSet<StringName> ignored_classes_set(ignored_classes_num);
-        for (int i = 0; i < ignored_classes_num; ++i)
-        {
-            ignored_classes_set.insert(ignored_classes[i]);
-        }
+        const HashSet<StringName> ignored_classes_set = get_ignored_classes();
         for (auto it = list.begin(); it != list.end(); ++it)
         {
             if (ignored_classes_set.has(*it))
@@ -781,12 +962,119 @@ namespace jsb
                 continue;
             }
 
+            const ClassDB::ClassInfo* class_info = source.classes->getptr(*it);
+            jsb_check(class_info);
+
             JSB_HANDLE_SCOPE(isolate);
-            array->Set(context, index++, build_class_info(isolate, context, *it)).Check();
+            array->Set(context, index++, build_class_info(isolate, context, *class_info)).Check();
         }
         info.GetReturnValue().Set(array);
     }
 
+    // a brief of all classes in a single pre-serialized JSON text (no JS object is constructed for each class):
+    //   { hash: <hash of class list, singletons and global enums>, classes: [{ name, super, hash, enums }] }
+    // the full class info should be requested with `get_class_info` only if the class hash is changed.
+    static void _get_class_dump(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        v8::HandleScope handle_scope(isolate);
+
+        ClassDataSource source;
+        if (!get_class_data_source(isolate, source)) return;
+
+        List<StringName> list;
+        source.get_class_list(&list);
+
+        ContentHasher context_hasher;
+        context_hasher.add(String(VERSION_DOCS_URL));
+        context_hasher.add((int32_t) JSB_MAJOR_VERSION);
+        context_hasher.add((int32_t) JSB_MINOR_VERSION);
+        context_hasher.add((int32_t) JSB_PATCH_VERSION);
+
+        Array classes;
+        const HashSet<StringName> ignored_classes_set = get_ignored_classes();
+        for (const StringName& class_name : list)
+        {
+            if (ignored_classes_set.has(class_name)) continue;
+            const ClassDB::ClassInfo* class_info = source.classes->getptr(class_name);
+            jsb_check(class_info);
+
+            Array enums;
+            for (const KeyValue<StringName, ClassDB::ClassInfo::EnumInfo>& pair : class_info->enum_map)
+            {
+                enums.push_back(String(pair.key));
+            }
+            Dictionary entry;
+            entry["name"] = String(class_name);
+            entry["super"] = String(class_info->inherits);
+            entry["hash"] = hash_class(source, *class_info);
+            entry["enums"] = enums;
+            classes.push_back(entry);
+            context_hasher.add(class_name);
+        }
+
+        List<Engine::Singleton> singletons;
+        Engine::get_singleton()->get_singletons(&singletons);
+        for (const Engine::Singleton& singleton : singletons)
+        {
+            context_hasher.add(singleton.name);
+            context_hasher.add(singleton.class_name);
+        }
+        const int global_constant_num = CoreConstants::get_global_constant_count();
+        for (int index = 0; index < global_constant_num; ++index)
+        {
+            context_hasher.add(CoreConstants::get_global_constant_enum(index));
+        }
+
+        Dictionary dump;
+        dump["hash"] = context_hasher.to_string();
+        dump["classes"] = classes;
+        info.GetReturnValue().Set(impl::Helper::new_string(isolate, JSON::stringify(dump, "", false)));
+    }
+
+    static void _get_class_info(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        v8::HandleScope handle_scope(isolate);
+        v8::Local<v8::Context> context = isolate->GetCurrentContext();
+
+        ClassDataSource source;
+        if (!get_class_data_source(isolate, source)) return;
+
+        const StringName class_name = impl::Helper::to_string(isolate, info[0]);
+        const ClassDB::ClassInfo* class_info = source.classes->getptr(class_name);
+        if (!class_info)
+        {
+            return;
+        }
+        info.GetReturnValue().Set(build_class_info(isolate, context, *class_info));
+    }
+
+    // copy ClassDB and the doc data on the main thread, the class data functions read the copy (from any thread) until it's released
+    static void _take_class_snapshot(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        if (!Thread::is_main_thread())
+        {
+            impl::Helper::throw_error(isolate, "class snapshot can only be taken on the main thread");
+            return;
+        }
+
+        const std::shared_ptr<ClassDataSnapshot> snapshot = std::make_shared<ClassDataSnapshot>();
+        ClassDB::get_class_list(&snapshot->class_list);
+        snapshot->classes = ClassDB::classes;
+        snapshot->docs = EditorHelp::get_doc_data()->class_list;
+
+        MutexLock lock(class_snapshot_lock);
+        class_snapshot = snapshot;
+    }
+
+    static void _release_class_snapshot(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        MutexLock lock(class_snapshot_lock);
+        class_snapshot.reset();
+    }
+
     static void _get_global_constants(const v8::FunctionCallbackInfo<v8::Value>& info)
     {
         v8::Isolate* isolate = info.GetIsolate();
@@ -917,6 +1205,10 @@ namespace jsb
         jsb_obj->Set(context, impl::Helper::new_string_ascii(isolate, "editor"), editor_obj).Check();
         editor_obj->Set(context, impl::Helper::new_string_ascii(isolate, "get_class_doc"), JSB_NEW_FUNCTION(context, _get_class_doc, {})).Check();
         editor_obj->Set(context, impl::Helper::new_string_ascii(isolate, "get_classes"), JSB_NEW_FUNCTION(context, _get_classes, {})).Check();
+        editor_obj->Set(context, impl::Helper::new_string_ascii(isolate, "get_class_dump"), JSB_NEW_FUNCTION(context, _get_class_dump, {})).Check();
+        editor_obj->Set(context, impl::Helper::new_string_ascii(isolate, "get_class_info"), JSB_NEW_FUNCTION(context, _get_class_info, {})).Check();
+        editor_obj->Set(context, impl::Helper::new_string_ascii(isolate, "take_class_snapshot"), JSB_NEW_FUNCTION(context, _take_class_snapshot, {})).Check();
+        editor_obj->Set(context, impl::Helper::new_string_ascii(isolate, "release_class_snapshot"), JSB_NEW_FUNCTION(context, _release_class_snapshot, {})).Check();
         editor_obj->Set(context, impl::Helper::new_string_ascii(isolate, "get_global_constants"), JSB_NEW_FUNCTION(context, _get_global_constants, {})).Check();
         editor_obj->Set(context, impl::Helper::new_string_ascii(isolate, "get_singletons"), JSB_NEW_FUNCTION(context, _get_singletons, {})).Check();
         editor_obj->Set(context, impl::Helper::new_string_ascii(isolate, "get_utility_functions"), JSB_NEW_FUNCTION(context, _get_utility_functions, {})).Check();
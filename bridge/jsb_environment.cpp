@@ -1,10 +1,13 @@
 #include "jsb_environment.h"
 
+#include <algorithm>
+
 #include "jsb_bridge_module_loader.h"
 #include "jsb_godot_module_loader.h"
 #include "jsb_transpiler.h"
 #include "jsb_ref.h"
 #include "jsb_bridge_helper.h"
+#include "jsb_json.h"
 #include "jsb_builtins.h"
 #include "jsb_object_bindings.h"
 #include "jsb_type_convert.h"
@@ -37,15 +40,25 @@
 
 namespace jsb
 {
+    // the detached script instance state of an object in the transferred subtree
+    struct TransferObjectState
+    {
+        ObjectID id;
+        String script_path;
+        List<Pair<StringName, Variant>> state;
+    };
+
     struct TransferObjectData : TransferData
     {
         NativeObjectID worker_id;
         Variant target;
-        String script_path;
-        List<Pair<StringName, Variant>> state;
 
-        TransferObjectData(NativeObjectID p_worker_id, const Variant& p_target, const String& p_script_path, const List<Pair<StringName, Variant>>& p_state)
-            : worker_id(p_worker_id), target(p_target), script_path(p_script_path), state(p_state)
+        // all objects in the subtree with a script instance to restore,
+        // objects without script instance are not listed since they're rebound lazily on the first access from JS.
+        LocalVector<TransferObjectState> objects;
+
+        TransferObjectData(NativeObjectID p_worker_id, const Variant& p_target)
+            : worker_id(p_worker_id), target(p_target)
         {}
 
         virtual ~TransferObjectData() override = default;
@@ -167,6 +180,12 @@ namespace jsb
         {
             if (const std::shared_ptr<Environment> env = EnvironmentStore::get_shared().access(p_token))
             {
+                // look up the ObjectDB only once in the owner thread
+                if (Thread::get_caller_id() == env->thread_id_)
+                {
+                    //NOTE Always return false to avoid `delete` in godot unreference() call (see below)
+                    return !env->reference_object(p_binding, p_reference);
+                }
                 if (env->verify_object(p_binding) && env->add_async_call(
                     p_reference ? Environment::AsyncCall::TYPE_REF : Environment::AsyncCall::TYPE_DEREF,
                     p_binding))
@@ -243,6 +262,10 @@ namespace jsb
             }
         }
 
+#if JSB_WITH_ESSENTIALS
+        time_origin_ = OS::get_singleton()->get_ticks_usec();
+        time_origin_unix_msec_ = OS::get_singleton()->get_unix_time() * 1000.0;
+#endif
         native_classes_.reserve(p_params.initial_class_slots);
         script_classes_.reserve(p_params.initial_script_slots);
 
@@ -300,6 +323,8 @@ namespace jsb
 #if JSB_WITH_ESSENTIALS
         timer_tags_.tags.clear();
         timer_manager_.clear_all();
+        performance_marks_.tags.clear();
+        frame_callbacks_.clear();
 #endif
 
         for (IModuleResolver* resolver : module_resolvers_)
@@ -361,6 +386,14 @@ namespace jsb
 
             function_refs_.clear();
             while (!function_bank_.is_empty()) function_bank_.remove_last();
+
+            // unfinished file/json requests are discarded
+            file_manager_.cancel_all();
+            json_parser_.cancel_all();
+            resource_cache_.cancel_all();
+            async_callbacks_.clear();
+            command_buffer_.clear();
+            valuetype_pool_.clear(isolate);
             // function_bank_.clear();
 
 #if JSB_WITH_DEBUGGER
@@ -394,6 +427,11 @@ namespace jsb
             JSB_LOG(VeryVerbose, " - %s", (uintptr_t) pointer);
             free_object(pointer, FinalizationType::Default /* Force? */);
         }
+        _finalize_pending_objects(UINT64_MAX);
+        identity_cache_.clear();
+        weak_ref_watchers_.clear();
+        released_weak_refs_.clear();
+        parked_weak_refs_.clear();
 
         EnvironmentStore::get_shared().remove(this);
 
@@ -402,6 +440,18 @@ namespace jsb
     void Environment::update(uint64_t p_delta_msecs)
     {
 #if JSB_WITH_ESSENTIALS
+        // animation frame callbacks are invoked on every frame without going through the timer wheel
+        if (!frame_callbacks_.is_empty())
+        {
+            v8::Isolate::Scope isolate_scope(isolate_);
+            v8::HandleScope handle_scope(isolate_);
+
+            if (frame_callbacks_.invoke(isolate_, (double) get_time_usec() / 1000.0))
+            {
+                microtasks_run_ = true;
+            }
+        }
+
         if (timer_manager_.tick(p_delta_msecs))
         {
             v8::Isolate::Scope isolate_scope(isolate_);
@@ -433,7 +483,100 @@ namespace jsb
             }
         }
 
+#if !JSB_WITH_WEB && !JSB_WITH_JAVASCRIPTCORE
+        // replay scenes built in workers
+        {
+            std::vector<PendingSceneBuild>& builds = scene_build_inbox_.swap();
+            for (PendingSceneBuild& build : builds)
+            {
+                scene_builds_.push_back(std::move(build));
+            }
+            builds.clear();
+            if (!scene_builds_.empty())
+            {
+                v8::Isolate::Scope isolate_scope(isolate_);
+                v8::HandleScope handle_scope(isolate_);
+                const v8::Local<v8::Context> context = context_.Get(isolate_);
+                v8::Context::Scope context_scope(context);
+                _replay_scene_builds(context);
+            }
+        }
+#endif
+
+        // handle loaded files (`jsb.fs.read`)
+        if (!file_manager_.is_empty())
+        {
+            std::vector<internal::FileManager::LoadResult>& results = file_manager_.poll();
+            if (!results.empty())
+            {
+                v8::Isolate::Scope isolate_scope(isolate_);
+                v8::HandleScope handle_scope(isolate_);
+                const v8::Local<v8::Context> context = context_.Get(isolate_);
+                v8::Context::Scope context_scope(context);
+
+                for (internal::FileManager::LoadResult& result : results)
+                {
+                    _on_file_loaded(context, result);
+                }
+                results.clear();
+                microtasks_run_ = true;
+            }
+        }
+
+        // handle parsed JSON (`jsb.json.parseAsync`)
+        if (!json_parser_.is_empty())
+        {
+            std::vector<internal::AsyncJSONParser::ParseResult>& results = json_parser_.poll();
+            if (!results.empty())
+            {
+                v8::Isolate::Scope isolate_scope(isolate_);
+                v8::HandleScope handle_scope(isolate_);
+                const v8::Local<v8::Context> context = context_.Get(isolate_);
+                v8::Context::Scope context_scope(context);
+
+                for (const internal::AsyncJSONParser::ParseResult& result : results)
+                {
+                    _on_json_parsed(context, result);
+                }
+                results.clear();
+                microtasks_run_ = true;
+            }
+        }
+
+        // handle loaded resources (`jsb.load`)
+        if (resource_cache_.is_loading())
+        {
+            std::vector<internal::ResourceCache::LoadResult>& results = resource_cache_.poll();
+            if (!results.empty())
+            {
+                v8::Isolate::Scope isolate_scope(isolate_);
+                v8::HandleScope handle_scope(isolate_);
+                const v8::Local<v8::Context> context = context_.Get(isolate_);
+                v8::Context::Scope context_scope(context);
+
+                for (const internal::ResourceCache::LoadResult& result : results)
+                {
+                    _on_resource_loaded(context, result);
+                }
+                results.clear();
+                microtasks_run_ = true;
+            }
+        }
+
         exec_async_calls();
+        _weaken_pending_objects();
+        if (!pending_finalizations_.empty() || finalizing_cursor_ < finalizing_.size())
+        {
+            _finalize_pending_objects(OS::get_singleton()->get_ticks_usec() + JSB_GC_FINALIZE_BUDGET_USEC);
+        }
+        if (!released_weak_refs_.is_empty())
+        {
+            _update_released_weak_refs();
+        }
+        if (!parked_weak_refs_.is_empty())
+        {
+            _update_parked_weak_refs();
+        }
 
         // quickjs delayed the free op after all HandleScope left, we need to swap the free op list manually explicitly.
         // otherwise, object may leak until next evacuation of HandleScope.
@@ -447,11 +590,162 @@ namespace jsb
         }
 #endif
 
+        // execute engine calls recorded in this frame (`jsb.commands`)
+        command_buffer_.flush();
+
+        // wrappers returned in this frame are either recycled or released
+        valuetype_pool_.collect(isolate_);
+
 #if JSB_WITH_DEBUGGER
         debugger_.update();
 #endif
     }
 
+    void Environment::load_file_async(const String& p_path, const v8::Local<v8::Function>& p_callback)
+    {
+        const internal::Index32 token = async_callbacks_.add(v8::Global<v8::Function>(isolate_, p_callback));
+        file_manager_.load_async(p_path, *token);
+    }
+
+    void Environment::parse_json_async(const Vector<uint8_t>& p_utf8, const v8::Local<v8::Function>& p_callback)
+    {
+        const internal::Index32 token = async_callbacks_.add(v8::Global<v8::Function>(isolate_, p_callback));
+        json_parser_.parse_async(p_utf8, *token);
+    }
+
+    void Environment::parse_json_async(const String& p_text, const v8::Local<v8::Function>& p_callback)
+    {
+        const internal::Index32 token = async_callbacks_.add(v8::Global<v8::Function>(isolate_, p_callback));
+        json_parser_.parse_async(p_text, *token);
+    }
+
+    uint32_t Environment::load_resource_async(const String& p_path, const String& p_type_hint, bool p_use_sub_threads, const v8::Local<v8::Function>& p_callback)
+    {
+        const internal::Index32 token = async_callbacks_.add(v8::Global<v8::Function>(isolate_, p_callback));
+        resource_cache_.load_threaded(p_path, p_type_hint, p_use_sub_threads, *token);
+        return *token;
+    }
+
+    bool Environment::cancel_load_resource(uint32_t p_token)
+    {
+        if (!resource_cache_.cancel(p_token))
+        {
+            return false;
+        }
+        const internal::Index32 token(p_token);
+        if (async_callbacks_.is_valid_index(token))
+        {
+            async_callbacks_.remove_at_checked(token);
+        }
+        return true;
+    }
+
+    void Environment::_on_resource_loaded(const v8::Local<v8::Context>& p_context, const internal::ResourceCache::LoadResult& p_result)
+    {
+        v8::Local<v8::Function> callback;
+        if (!_take_async_callback(p_result.token, callback))
+        {
+            return;
+        }
+
+        v8::Local<v8::Value> argv[2];
+        if (p_result.error == OK)
+        {
+            argv[0] = v8::Undefined(isolate_);
+            if (!TypeConvert::gd_var_to_js(isolate_, p_context, p_result.resource, argv[1]))
+            {
+                argv[0] = impl::Helper::new_string(isolate_, "failed to translate the resource");
+                argv[1] = v8::Undefined(isolate_);
+            }
+        }
+        else
+        {
+            argv[0] = impl::Helper::new_string(isolate_, error_names[p_result.error]);
+            argv[1] = v8::Undefined(isolate_);
+        }
+
+        const impl::TryCatch try_catch(isolate_);
+        const v8::MaybeLocal<v8::Value> rval = callback->Call(p_context, v8::Undefined(isolate_), std::size(argv), argv);
+        jsb_unused(rval);
+        if (try_catch.has_caught())
+        {
+            JSB_LOG(Error, "resource callback error %s", BridgeHelper::get_exception(try_catch));
+        }
+    }
+
+    bool Environment::_take_async_callback(uint32_t p_token, v8::Local<v8::Function>& r_callback)
+    {
+        const internal::Index32 token(p_token);
+        v8::Global<v8::Function>* callback_ptr;
+        if (!async_callbacks_.try_get_value_pointer(token, callback_ptr))
+        {
+            return false;
+        }
+        r_callback = callback_ptr->Get(isolate_);
+        async_callbacks_.remove_at_checked(token);
+        return true;
+    }
+
+    void Environment::_on_json_parsed(const v8::Local<v8::Context>& p_context, const internal::AsyncJSONParser::ParseResult& p_result)
+    {
+        v8::Local<v8::Function> callback;
+        if (!_take_async_callback(p_result.token, callback))
+        {
+            return;
+        }
+
+        v8::Local<v8::Value> argv[2];
+        if (p_result.error == OK)
+        {
+            argv[0] = v8::Undefined(isolate_);
+            // the whole tree is materialized in one pass
+            argv[1] = JSONHelper::to_js(isolate_, p_context, p_result.data);
+        }
+        else
+        {
+            argv[0] = impl::Helper::new_string(isolate_, jsb_format("%s (line %d)", p_result.error_message, p_result.error_line));
+            argv[1] = v8::Undefined(isolate_);
+        }
+
+        const impl::TryCatch try_catch(isolate_);
+        const v8::MaybeLocal<v8::Value> rval = callback->Call(p_context, v8::Undefined(isolate_), std::size(argv), argv);
+        jsb_unused(rval);
+        if (try_catch.has_caught())
+        {
+            JSB_LOG(Error, "json callback error %s", BridgeHelper::get_exception(try_catch));
+        }
+    }
+
+    void Environment::_on_file_loaded(const v8::Local<v8::Context>& p_context, internal::FileManager::LoadResult& p_result)
+    {
+        v8::Local<v8::Function> callback;
+        if (!_take_async_callback(p_result.token, callback))
+        {
+            return;
+        }
+
+        v8::Local<v8::Value> argv[2];
+        if (p_result.error == OK)
+        {
+            argv[0] = v8::Undefined(isolate_);
+            // the ArrayBuffer takes over the loaded data without copying
+            argv[1] = impl::Helper::to_shared_array_buffer(isolate_, p_result.data);
+        }
+        else
+        {
+            argv[0] = impl::Helper::new_string(isolate_, error_names[p_result.error]);
+            argv[1] = v8::Undefined(isolate_);
+        }
+
+        const impl::TryCatch try_catch(isolate_);
+        const v8::MaybeLocal<v8::Value> rval = callback->Call(p_context, v8::Undefined(isolate_), std::size(argv), argv);
+        jsb_unused(rval);
+        if (try_catch.has_caught())
+        {
+            JSB_LOG(Error, "file callback error %s", BridgeHelper::get_exception(try_catch));
+        }
+    }
+
     // handle async calls (from InstanceBindingCallbacks)
     void Environment::exec_async_calls()
     {
@@ -508,49 +802,60 @@ namespace jsb
 
     void Environment::_on_worker_transfer(const v8::Local<v8::Context>& p_context, const TransferObjectData* p_data)
     {
-        jsb_check(p_data->worker_id);
-        if (!object_db_.has_object(p_data->worker_id))
-        {
-            JSB_LOG(Error, "invalid worker");
-            return;
-        }
-
-        //TODO 0. HOW TO HANDLE COMPLICATED SITUATIONS? SUCH AS NESTED OBJECTS?
-        jsb_nop();
-
-        if (p_data->target.get_type() == Variant::Type::OBJECT)
+        // restore the script instances in the whole subtree at once (each script is loaded only once in a batch),
+        // objects are not bound to JS here, except the target which is passed to 'ontransfer'.
+        HashMap<String, Ref<GodotJSScript>> scripts;
+        for (const TransferObjectState& object_state : p_data->objects)
         {
-            const ObjectID target_id = p_data->target;
-            Object* instance = ::ObjectDB::get_instance(target_id);
+            Object* instance = ::ObjectDB::get_instance(object_state.id);
             if (!instance)
             {
-                JSB_LOG(Error, "transferred object not found: %d", (uint64_t) target_id);
-                return;
+                JSB_LOG(Error, "transferred object not found: %d", (uint64_t) object_state.id);
+                continue;
             }
 
-            // restore the object state if it's a GodotJSScript
-            if (!p_data->script_path.is_empty())
+            // 1. create a script and script instance
+            // 2. attach the script & script instance to the object
+            Ref<GodotJSScript>* script = scripts.getptr(object_state.script_path);
+            if (!script)
             {
-                // 1. create a script and script instance
-                // 2. attach the script & script instance to the object
-                const Ref<GodotJSScript> script = ResourceLoader::load(p_data->script_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE_DEEP);
-                jsb_check(script.is_valid());
-                jsb_unused(script->can_instantiate());
-                ScriptInstance* script_instance = script->instance_create(instance, false);
-                jsb_check(script_instance);
-
-                // 3. restore the object state
-                for (const Pair<StringName, Variant>& pair : p_data->state)
+                script = &scripts.insert(object_state.script_path, ResourceLoader::load(object_state.script_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE_DEEP))->value;
+                if (script->is_valid())
                 {
-                    script_instance->set(pair.first, pair.second);
+                    jsb_unused((*script)->can_instantiate());
                 }
             }
+            if (script->is_null())
+            {
+                JSB_LOG(Error, "failed to load the script of transferred object: %s", object_state.script_path);
+                continue;
+            }
+            ScriptInstance* script_instance = (*script)->instance_create(instance, false);
+            jsb_check(script_instance);
+
+            // 3. restore the object state
+            for (const Pair<StringName, Variant>& pair : object_state.state)
+            {
+                script_instance->set(pair.first, pair.second);
+            }
+        }
+
+        jsb_check(p_data->worker_id);
+        if (!object_db_.has_object(p_data->worker_id))
+        {
+            JSB_LOG(Error, "invalid worker");
+            return;
+        }
+        if (p_data->target.get_type() == Variant::Type::OBJECT && !::ObjectDB::get_instance(p_data->target))
+        {
+            JSB_LOG(Error, "transferred object not found: %d", (uint64_t) (ObjectID) p_data->target);
+            return;
         }
 
         // call 'ontransfer'
         {
             ObjectHandleConstPtr handle = object_db_.try_get_object(p_data->worker_id);
-            const v8::Local<v8::Object> worker = handle->ref_.Get(isolate_).As<v8::Object>();
+            const v8::Local<v8::Object> worker = handle->ref->Get(isolate_).As<v8::Object>();
             jsb_check(!worker.IsEmpty());
             handle = nullptr;
 
@@ -619,7 +924,7 @@ namespace jsb
             JSB_LOG(Error, "invalid worker");
             return;
         }
-        const v8::Local<v8::Object> obj = handle->ref_.Get(isolate_).As<v8::Object>();
+        const v8::Local<v8::Object> obj = handle->ref->Get(isolate_).As<v8::Object>();
         jsb_check(!obj.IsEmpty());
         handle = nullptr;
 
@@ -656,11 +961,64 @@ namespace jsb
         }
     }
 
+#if !JSB_WITH_WEB && !JSB_WITH_JAVASCRIPTCORE
+    void Environment::_replay_scene_builds(const v8::Local<v8::Context>& p_context)
+    {
+        const uint64_t deadline = OS::get_singleton()->get_ticks_usec() + JSB_SCENE_BUILD_BUDGET_USEC;
+        size_t num_finished = 0;
+        while (num_finished < scene_builds_.size())
+        {
+            PendingSceneBuild& build = scene_builds_[num_finished];
+            if (!build.buffer->replay(deadline))
+            {
+                // continue in the next update
+                break;
+            }
+            ++num_finished;
+
+            Node* root = build.buffer->take_root();
+            ObjectHandleConstPtr handle = object_db_.try_get_object(build.worker_id);
+            if (!handle || !root)
+            {
+                JSB_LOG(Error, "scene built by a dead worker (or failed to create the root) is discarded");
+                if (root) memdelete(root);
+                continue;
+            }
+            const v8::Local<v8::Object> worker = handle->ref->Get(isolate_).As<v8::Object>();
+            handle = nullptr;
+
+            v8::Local<v8::Value> callback;
+            v8::Local<v8::Object> root_obj;
+            if (!worker->Get(p_context, jsb_name(this, onbuild)).ToLocal(&callback) || !callback->IsFunction()
+                || !TypeConvert::gd_obj_to_js(isolate_, p_context, root, root_obj))
+            {
+                JSB_LOG(Error, "onbuild is not a function");
+                memdelete(root);
+                continue;
+            }
+
+            // the root is owned by scripts from now on (as any other parentless Node created in JS)
+            const impl::TryCatch try_catch(isolate_);
+            v8::Local<v8::Value> argv[] = { root_obj };
+            const v8::MaybeLocal<v8::Value> rval = callback.As<v8::Function>()->Call(p_context, v8::Undefined(isolate_), std::size(argv), argv);
+            jsb_unused(rval);
+            if (try_catch.has_caught())
+            {
+                JSB_LOG(Error, "%s", BridgeHelper::get_exception(try_catch));
+            }
+            microtasks_run_ = true;
+            if (OS::get_singleton()->get_ticks_usec() >= deadline) break;
+        }
+        scene_builds_.erase(scene_builds_.begin(), scene_builds_.begin() + (ptrdiff_t) num_finished);
+    }
+#endif
+
     void Environment::gc()
     {
         check_internal_state();
         string_name_cache_.clear();
         _source_map_cache.clear();
+        _weaken_pending_objects();
 
 #if JSB_EXPOSE_GC_FOR_TESTING
         isolate_->RequestGarbageCollectionForTesting(v8::Isolate::kFullGarbageCollection);
@@ -751,21 +1109,22 @@ namespace jsb
         void* internal_fields[] = { p_pointer,  (void*)(uintptr_t) p_type };
         p_object->SetAlignedPointerInInternalFields(IF_ObjectFieldCount, indices, internal_fields);
 
-        handle->class_id = p_class_id;
+        *handle->class_id = p_class_id;
 #if JSB_DEBUG
-        handle->pointer = p_pointer;
+        *handle->pointer = p_pointer;
 #endif
 
         jsb_v8_check(native_classes_.get_value(p_class_id).type == p_type);
-        handle->ref_.Reset(isolate_, p_object);
+        handle->ref->Reset(isolate_, p_object);
         if (p_external_rc == 0)
         {
-            handle->ref_.SetWeak(p_pointer, &object_gc_callback, v8::WeakCallbackType::kInternalFields);
+            handle->ref->SetWeak(p_pointer, &object_gc_callback, v8::WeakCallbackType::kInternalFields);
+            handle->slot->weak = true;
         }
         else
         {
             jsb_check(p_external_rc > 0);
-            handle->ref_count_ = p_external_rc;
+            handle->slot->ref_count = p_external_rc;
         }
         JSB_LOG(VeryVerbose, "bind object class:%s(%d) addr:%d id:%d",
             (String) native_classes_.get_value(p_class_id).name, p_class_id,
@@ -775,13 +1134,25 @@ namespace jsb
 
     void Environment::mark_as_persistent_object(void* p_pointer)
     {
-        if (!persistent_objects_.has(p_pointer))
+        ObjectHandlePtr object_handle = object_db_.try_get_object(p_pointer);
+        if (!object_handle)
+        {
+            JSB_LOG(Error, "can not mark an unbound object as persistent: %d", (uintptr_t) p_pointer);
+            return;
+        }
+        if (object_handle->slot->persistent)
         {
-            persistent_objects_.insert(p_pointer);
-            reference_object(p_pointer, true);
+            JSB_LOG(Error, "duplicate adding persistent object: %d", (uintptr_t) p_pointer);
             return;
         }
-        JSB_LOG(Error, "duplicate adding persistent object: %d", (uintptr_t) p_pointer);
+        object_handle->slot->persistent = true;
+        // release the lock before `reference_object` which acquires it again
+        object_handle = nullptr;
+        ++persistent_objects_num_;
+        reference_object(p_pointer, true);
+
+        // persistent objects (singletons) are converted all the time, pin them in the identity cache
+        identity_cache_.put_permanent(p_pointer, object_db_.try_get_object_id(p_pointer));
     }
 
     void* Environment::get_verified_object(const v8::Local<v8::Object>& p_obj, NativeClassType::Type p_type) const
@@ -800,38 +1171,61 @@ namespace jsb
         const ObjectHandlePtr object_handle = object_db_.try_get_object(p_pointer);
         if (jsb_unlikely(!object_handle))
         {
-            JSB_LOG(Verbose, "UNEXPECTED bad pointer %d", (uintptr_t) p_pointer);
+            // it's possible in `reference_callback` if the object is already unbound
+            JSB_LOG(VeryVerbose, "unbound pointer %d", (uintptr_t) p_pointer);
             return false;
         }
 
         // must not be a valuetype object
-        // jsb_check(native_classes_.get_value(object_handle->class_id).type != NativeClassType::GodotPrimitive);
+        // jsb_check(native_classes_.get_value(*object_handle->class_id).type != NativeClassType::GodotPrimitive);
 
         // adding references
         if (p_is_inc)
         {
-            if (object_handle->ref_count_ == 0)
+            if (object_handle->slot->weak)
             {
                 // becomes a strong reference
-                jsb_check(!object_handle->ref_.IsEmpty());
-                object_handle->ref_.ClearWeak();
+                jsb_check(object_handle->slot->ref_count == 0);
+                jsb_check(!object_handle->ref->IsEmpty());
+                object_handle->ref->ClearWeak();
+                object_handle->slot->weak = false;
             }
-            ++object_handle->ref_count_;
+            ++object_handle->slot->ref_count;
             return true;
         }
 
         // removing references
-        jsb_checkf(!object_handle->ref_.IsEmpty(), "removing references on dead values");
-        jsb_check(object_handle->ref_count_ > 0);
+        jsb_checkf(!object_handle->ref->IsEmpty(), "removing references on dead values");
+        jsb_check(object_handle->slot->ref_count > 0);
 
-        --object_handle->ref_count_;
-        if (object_handle->ref_count_ == 0)
+        --object_handle->slot->ref_count;
+        if (object_handle->slot->ref_count == 0 && !object_handle->slot->pending_weak)
         {
-            object_handle->ref_.SetWeak(p_pointer, &object_gc_callback, v8::WeakCallbackType::kInternalFields);
+            // it's still strong until the end of frame, the next reference in this frame costs nothing
+            object_handle->slot->pending_weak = true;
+            pending_weak_objects_.push_back(p_pointer);
         }
         return true;
     }
 
+    void Environment::_weaken_pending_objects()
+    {
+        // an object may be freed (even the address reused by another object) since pushed,
+        // it's fine because only the unreferenced strong handles are weakened.
+        for (void* pointer : pending_weak_objects_)
+        {
+            const ObjectHandlePtr object_handle = object_db_.try_get_object(pointer);
+            if (!object_handle) continue;
+            object_handle->slot->pending_weak = false;
+            if (object_handle->slot->ref_count == 0 && !object_handle->slot->weak)
+            {
+                object_handle->ref->SetWeak(pointer, &object_gc_callback, v8::WeakCallbackType::kInternalFields);
+                object_handle->slot->weak = true;
+            }
+        }
+        pending_weak_objects_.clear();
+    }
+
     // jsb_force_inline static void clear_internal_field(v8::Isolate* isolate, const v8::Global<v8::Object>& p_obj)
     // {
     //     v8::HandleScope handle_scope(isolate);
@@ -856,11 +1250,13 @@ namespace jsb
         }
 
 #if JSB_DEBUG
-        jsb_check(object_handle->pointer == p_pointer);
+        jsb_check(*object_handle->pointer == p_pointer);
 #endif
-        const NativeClassID class_id = object_handle->class_id;
+        const NativeClassID class_id = *object_handle->class_id;
+        const bool watched = object_handle->slot->watched;
+        const bool is_persistent = object_handle->slot->persistent;
         // hold it in a local variable to avoid gc too early
-        v8::Global<v8::Object> obj_ref = std::move(object_handle->ref_);
+        v8::Global<v8::Object> obj_ref = std::move(*object_handle->ref);
 
         //TODO do not clear the internal field if calling from JS GC
         // if (p_finalize != FinalizationType::None)
@@ -872,28 +1268,226 @@ namespace jsb
         // }
 
         object_handle = nullptr;
+        if (jsb_unlikely(watched))
+        {
+            _release_weak_refs(object_db_.try_get_object_id(p_pointer));
+        }
         object_db_.remove_object(p_pointer);
         obj_ref.Reset();
+        if (jsb_unlikely(is_persistent))
+        {
+            jsb_check(persistent_objects_num_ > 0);
+            --persistent_objects_num_;
+        }
 
         if (p_finalize != FinalizationType::None)
         {
-            const NativeClassInfo& class_info = native_classes_.get_value(class_id);
-            const bool is_persistent = persistent_objects_.erase(p_pointer);
-
             JSB_LOG(VeryVerbose, "free_object class:%s(%d) addr:%d",
-                (String) class_info.name, class_id,
+                (String) native_classes_.get_value(class_id).name, class_id,
                 (uintptr_t) p_pointer);
 
-            //NOTE Godot will call Object::_predelete to post a notification NOTIFICATION_PREDELETE which finally call `ScriptInstance::callp`
-            class_info.finalizer(this, p_pointer, is_persistent ? FinalizationType::None : p_finalize);
+            // the native object is unreachable from JS now, the finalizer (may `memdelete`) is deferred to `update()`
+            pending_finalizations_.push_back({ class_id, is_persistent ? FinalizationType::None : p_finalize, p_pointer });
         }
         else
         {
-            jsb_check(!persistent_objects_.has(p_pointer));
+            jsb_check(!is_persistent);
             JSB_LOG(VeryVerbose, "(skip) free_object class_id:%d addr:%d", class_id, (uintptr_t) p_pointer);
         }
     }
 
+    namespace
+    {
+        // the lists of GodotWeakRef store the index in each element, an element is removed by swapping with the last one
+        void push_weak_ref(LocalVector<GodotWeakRef*>& p_list, GodotWeakRef* p_weak_ref, GodotWeakRef::WatchState p_state)
+        {
+            p_weak_ref->set_watch_state(p_state, p_list.size());
+            p_list.push_back(p_weak_ref);
+        }
+
+        void remove_weak_ref(LocalVector<GodotWeakRef*>& p_list, GodotWeakRef* p_weak_ref)
+        {
+            const uint32_t index = p_weak_ref->get_watch_index();
+            const uint32_t last_index = p_list.size() - 1;
+            jsb_check(index <= last_index && p_list[index] == p_weak_ref);
+            if (index != last_index)
+            {
+                GodotWeakRef* last = p_list[last_index];
+                last->set_watch_state(last->get_watch_state(), index);
+                p_list[index] = last;
+            }
+            p_list.resize(last_index);
+            p_weak_ref->set_watch_state(GodotWeakRef::WatchState::None, 0);
+        }
+    }
+
+    void Environment::watch_weak_ref(GodotWeakRef* p_weak_ref)
+    {
+        jsb_check(p_weak_ref->get_watch_state() == GodotWeakRef::WatchState::None);
+        const NativeObjectID object_id = p_weak_ref->get_native_object_id();
+        const bool valid = object_db_.set_watched(object_id, true);
+        jsb_check(valid);
+        jsb_unused(valid);
+        push_weak_ref(weak_ref_watchers_[*object_id], p_weak_ref, GodotWeakRef::WatchState::Watching);
+    }
+
+    void Environment::unwatch_weak_ref(GodotWeakRef* p_weak_ref)
+    {
+        switch (p_weak_ref->get_watch_state())
+        {
+        case GodotWeakRef::WatchState::None: return;
+        case GodotWeakRef::WatchState::Released: remove_weak_ref(released_weak_refs_, p_weak_ref); return;
+        case GodotWeakRef::WatchState::Parked: remove_weak_ref(parked_weak_refs_, p_weak_ref); return;
+        case GodotWeakRef::WatchState::Watching:
+            {
+                const NativeObjectID object_id = p_weak_ref->get_native_object_id();
+                LocalVector<GodotWeakRef*>* watchers = weak_ref_watchers_.getptr(*object_id);
+                jsb_check(watchers);
+                remove_weak_ref(*watchers, p_weak_ref);
+                if (watchers->is_empty())
+                {
+                    weak_ref_watchers_.erase(*object_id);
+                    object_db_.set_watched(object_id, false);
+                }
+                return;
+            }
+        }
+    }
+
+    void Environment::_release_weak_refs(const NativeObjectID& p_object_id)
+    {
+        if (LocalVector<GodotWeakRef*>* watchers = weak_ref_watchers_.getptr(*p_object_id))
+        {
+            for (GodotWeakRef* weak_ref : *watchers)
+            {
+                push_weak_ref(released_weak_refs_, weak_ref, GodotWeakRef::WatchState::Released);
+            }
+            weak_ref_watchers_.erase(*p_object_id);
+        }
+    }
+
+    void Environment::_update_released_weak_refs()
+    {
+        v8::Isolate::Scope isolate_scope(isolate_);
+        v8::HandleScope handle_scope(isolate_);
+        const v8::Local<v8::Context> context = context_.Get(isolate_);
+        v8::Context::Scope context_scope(context);
+
+        // callbacks may release more bindings (appended to the list)
+        while (!released_weak_refs_.is_empty())
+        {
+            GodotWeakRef* weak_ref = released_weak_refs_[released_weak_refs_.size() - 1];
+            remove_weak_ref(released_weak_refs_, weak_ref);
+            if (Object* obj = ::ObjectDB::get_instance(weak_ref->get_object_id()))
+            {
+                if (const NativeObjectID object_id = object_db_.try_get_object_id(obj))
+                {
+                    // bound again
+                    weak_ref->set_native_object_id(object_id);
+                    watch_weak_ref(weak_ref);
+                }
+                else
+                {
+                    // unbound but not deleted
+                    push_weak_ref(parked_weak_refs_, weak_ref, GodotWeakRef::WatchState::Parked);
+                }
+                continue;
+            }
+            weak_ref->invoke_callback(this, context);
+            microtasks_run_ = true;
+        }
+    }
+
+    void Environment::_update_parked_weak_refs()
+    {
+        const uint64_t now = OS::get_singleton()->get_ticks_usec();
+        if (now < parked_weak_refs_check_time_)
+        {
+            return;
+        }
+        parked_weak_refs_check_time_ = now + JSB_WEAK_REF_PARKED_CHECK_INTERVAL_USEC;
+
+        v8::Isolate::Scope isolate_scope(isolate_);
+        v8::HandleScope handle_scope(isolate_);
+        const v8::Local<v8::Context> context = context_.Get(isolate_);
+        v8::Context::Scope context_scope(context);
+
+        uint32_t index = 0;
+        while (index < parked_weak_refs_.size())
+        {
+            GodotWeakRef* weak_ref = parked_weak_refs_[index];
+            Object* obj = ::ObjectDB::get_instance(weak_ref->get_object_id());
+            const NativeObjectID object_id = obj ? object_db_.try_get_object_id(obj) : NativeObjectID();
+            if (obj && !object_id)
+            {
+                ++index;
+                continue;
+            }
+
+            // the last one is swapped to `index`
+            remove_weak_ref(parked_weak_refs_, weak_ref);
+            if (obj)
+            {
+                weak_ref->set_native_object_id(object_id);
+                watch_weak_ref(weak_ref);
+                continue;
+            }
+            weak_ref->invoke_callback(this, context);
+            microtasks_run_ = true;
+        }
+    }
+
+    bool Environment::_finalize_pending_objects(uint64_t p_deadline_usec)
+    {
+        const OS* os = OS::get_singleton();
+        while (true)
+        {
+            if (finalizing_cursor_ == finalizing_.size())
+            {
+                finalizing_.clear();
+                finalizing_cursor_ = 0;
+                if (pending_finalizations_.empty())
+                {
+                    return true;
+                }
+
+                // take the next batch, finalizers of the same class are called together
+                std::swap(finalizing_, pending_finalizations_);
+                std::sort(finalizing_.begin(), finalizing_.end());
+            }
+
+            // finalizers may release other objects (pushed into pending_finalizations_ for the next batch)
+            const uint32_t num = (uint32_t) finalizing_.size();
+            while (finalizing_cursor_ < num)
+            {
+                const PendingFinalization& pending = finalizing_[finalizing_cursor_++];
+                const NativeClassInfo& class_info = native_classes_.get_value(pending.class_id);
+
+                if (jsb_unlikely(object_db_.has_object(pending.pointer)))
+                {
+                    // bound again (e.g. converted to JS by `gd_obj_to_js`) after unbound, the new binding owns the native object now.
+                    // only the reference held by the stale binding is released (`unreference()` of a RefCounted, it never deletes the object here).
+                    JSB_LOG(VeryVerbose, "skip finalizing a rebound object class:%s addr:%d", (String) class_info.name, (uintptr_t) pending.pointer);
+                    if (class_info.type == NativeClassType::GodotObject)
+                    {
+                        class_info.finalizer(this, pending.pointer, FinalizationType::None);
+                    }
+                }
+                else
+                {
+                    //NOTE Godot will call Object::_predelete to post a notification NOTIFICATION_PREDELETE which finally call `ScriptInstance::callp`
+                    class_info.finalizer(this, pending.pointer, pending.finalize);
+                }
+
+                // check the clock once per 64 objects
+                if ((finalizing_cursor_ & 63) == 0 && os->get_ticks_usec() >= p_deadline_usec)
+                {
+                    return finalizing_cursor_ == num && pending_finalizations_.empty();
+                }
+            }
+        }
+    }
+
     void Environment::start_debugger(uint16_t p_port)
     {
 #if JSB_WITH_DEBUGGER
@@ -910,11 +1504,15 @@ namespace jsb
         impl::Helper::get_statistics(isolate_, r_stats.custom_fields);
 
         r_stats.objects = object_db_.size();
+        r_stats.objects_memory = object_db_.get_memory_usage();
         r_stats.native_classes = native_classes_.size();
         r_stats.script_classes = script_classes_.size();
         r_stats.cached_string_names = string_name_cache_.size();
-        r_stats.persistent_objects = persistent_objects_.size();
+        r_stats.persistent_objects = persistent_objects_num_;
         r_stats.allocated_variants = variant_allocator_.get_allocated_num();
+        r_stats.valuetypes_created = valuetype_pool_.get_last_frame_stats().created;
+        r_stats.valuetypes_recycled = valuetype_pool_.get_last_frame_stats().recycled;
+        r_stats.pooled_valuetypes = valuetype_pool_.get_free_num();
     }
 
     ObjectCacheID Environment::get_cached_function(const v8::Local<v8::Function>& p_func)
@@ -1338,6 +1936,99 @@ namespace jsb
         return JSValueMove(shared_from_this(), rval);
     }
 
+    namespace
+    {
+        // get the value of a data property in the prototype chain, accessors are never invoked
+        bool _get_data_property(Environment* p_env, const v8::Local<v8::Context>& p_context, v8::Local<v8::Object> p_object, const v8::Local<v8::String>& p_key, v8::Local<v8::Value>& r_value)
+        {
+            const v8::Local<v8::String> value_key = jsb_name(p_env, value);
+            while (true)
+            {
+                v8::Local<v8::Value> descriptor;
+                if (!p_object->GetOwnPropertyDescriptor(p_context, p_key).ToLocal(&descriptor)) return false;
+                if (descriptor->IsObject())
+                {
+                    const v8::Local<v8::Object> descriptor_obj = descriptor.As<v8::Object>();
+                    return descriptor_obj->HasOwnProperty(p_context, value_key).FromMaybe(false)
+                        && descriptor_obj->Get(p_context, value_key).ToLocal(&r_value);
+                }
+                const v8::Local<v8::Value> prototype = p_object->GetPrototype();
+                if (!prototype->IsObject()) return false;
+                p_object = prototype.As<v8::Object>();
+            }
+        }
+    }
+
+    Error Environment::enumerate_properties(const Vector<String>& p_path, const String& p_prefix, uint64_t p_budget_ms, Vector<String>& r_names)
+    {
+        v8::Isolate::Scope isolate_scope(isolate_);
+        v8::HandleScope handle_scope(isolate_);
+        const v8::Local<v8::Context> context = context_.Get(isolate_);
+        v8::Context::Scope context_scope(context);
+
+        // nothing but proxy traps could be executed in JS, the watchdog terminates them.
+        // the deadline is also checked here for objects with a huge number of properties.
+        const uint64_t deadline = OS::get_singleton()->get_ticks_msec() + p_budget_ms;
+        const impl::TryCatch try_catch(isolate_);
+        ExecutionBudgetScope budget(watchdog_, isolate_, p_budget_ms);
+
+        Error err = OK;
+        v8::Local<v8::Object> target = context->Global();
+        for (const String& name : p_path)
+        {
+            v8::Local<v8::Value> value;
+            if (!_get_data_property(this, context, target, impl::Helper::new_string(isolate_, name), value) || !value->IsObject())
+            {
+                err = ERR_DOES_NOT_EXIST;
+                break;
+            }
+            target = value.As<v8::Object>();
+        }
+
+        HashSet<String> collected;
+        while (err == OK)
+        {
+            v8::Local<v8::Array> names;
+            if (!target->GetOwnPropertyNames(context, v8::PropertyFilter::SKIP_SYMBOLS, v8::KeyConversionMode::kNoNumbers).ToLocal(&names))
+            {
+                err = FAILED;
+                break;
+            }
+            for (uint32_t index = 0, len = names->Length(); index < len; ++index)
+            {
+                v8::Local<v8::Value> key;
+                if (!names->Get(context, index).ToLocal(&key) || !key->IsString()) continue;
+                const String name = impl::Helper::to_string(isolate_, key);
+                if (!name.begins_with(p_prefix) || collected.has(name)) continue;
+                collected.insert(name);
+                r_names.push_back(name);
+            }
+            if (OS::get_singleton()->get_ticks_msec() >= deadline)
+            {
+                err = ERR_TIMEOUT;
+                break;
+            }
+            const v8::Local<v8::Value> prototype = target->GetPrototype();
+            if (!prototype->IsObject()) break;
+            target = prototype.As<v8::Object>();
+        }
+
+        if (budget.disarm())
+        {
+            err = ERR_TIMEOUT;
+        }
+        else if (err == OK && try_catch.has_caught())
+        {
+            err = FAILED;
+        }
+        if (err != OK)
+        {
+            JSB_LOG(Verbose, "failed to enumerate properties of %s: %s", String(".").join(p_path), error_names[err]);
+            r_names.clear();
+        }
+        return err;
+    }
+
     bool Environment::_get_main_module(v8::Local<v8::Object>* r_main_module) const
     {
         if (const JavaScriptModule* cmain_module = module_cache_.get_main())
@@ -1723,35 +2414,75 @@ namespace jsb
         return _call(isolate, context, js_func.object_.Get(isolate), v8::Undefined(isolate), p_args, p_argcount, r_error);
     }
 
-    void Environment::transfer_object(Environment* p_from, Environment* p_to, NativeObjectID p_worker_handle_id, const Variant& p_target)
+    namespace
     {
-        if (p_target.get_type() == Variant::OBJECT)
+        // collect objects owned by the target: the target itself, descendants of nodes, and objects in arrays
+        void _collect_transfer_subtree(const Variant& p_target, LocalVector<Object*>& r_objects)
         {
-            Object* obj = p_target;
-            jsb_check(obj && p_from->object_db_.has_object(obj) && ::ObjectDB::get_instance(p_target));
+            LocalVector<Variant> pending;
+            pending.push_back(p_target);
+            while (!pending.is_empty())
+            {
+                const Variant value = pending[pending.size() - 1];
+                pending.resize(pending.size() - 1);
+                if (value.get_type() == Variant::ARRAY)
+                {
+                    const Array array = value;
+                    for (int index = 0, num = array.size(); index < num; ++index)
+                    {
+                        pending.push_back(array[index]);
+                    }
+                    continue;
+                }
+                if (value.get_type() != Variant::OBJECT) continue;
 
-            String script_path;
-            List<Pair<StringName, Variant>> state;
+                Object* obj = value;
+                if (!obj) continue;
+                r_objects.push_back(obj);
+                if (const Node* node = Object::cast_to<Node>(obj))
+                {
+                    for (int index = 0, num = node->get_child_count(true); index < num; ++index)
+                    {
+                        pending.push_back(node->get_child(index, true));
+                    }
+                }
+            }
+        }
+    }
+
+    void Environment::transfer_object(Environment* p_from, Environment* p_to, NativeObjectID p_worker_handle_id, const Variant& p_target)
+    {
+        TransferObjectData* transfer_data = memnew(TransferObjectData(p_worker_handle_id, p_target));
+        LocalVector<Object*> objects;
+        _collect_transfer_subtree(p_target, objects);
+
+        // detach all objects in the subtree in one pass, nothing is posted to the target environment until all done
+        uint32_t num_bound = 0;
+        for (Object* obj : objects)
+        {
             if (ScriptInstance* script_instance = obj->get_script_instance())
             {
-                jsb_check(script_instance);
                 const Ref script = script_instance->get_script();
                 jsb_check(script.is_valid());
 
-                script_instance->get_property_state(state);
-                script_path = script->get_path();
+                transfer_data->objects.push_back(TransferObjectState());
+                TransferObjectState& object_state = transfer_data->objects[transfer_data->objects.size() - 1];
+                object_state.id = obj->get_instance_id();
+                object_state.script_path = script->get_path();
+                script_instance->get_property_state(object_state.state);
 
                 obj->set_script_instance(nullptr);
             }
 
             // break the link in the host environment
-            p_from->free_object(obj, FinalizationType::None);
-            p_to->add_async_call(AsyncCall::TYPE_TRANSFER_, memnew(TransferObjectData(p_worker_handle_id, p_target, script_path, state)));
-        }
-        else
-        {
-            p_to->add_async_call(AsyncCall::TYPE_TRANSFER_, memnew(TransferObjectData(p_worker_handle_id, p_target, {}, {})));
+            if (p_from->object_db_.has_object(obj))
+            {
+                p_from->free_object(obj, FinalizationType::None);
+                ++num_bound;
+            }
         }
+        JSB_LOG(Verbose, "transfer %d objects (%d bound, %d scripted)", objects.size(), num_bound, transfer_data->objects.size());
+        p_to->add_async_call(AsyncCall::TYPE_TRANSFER_, transfer_data);
     }
 
 #pragma region Static Fields
@@ -11,12 +11,23 @@
 #include "jsb_statistics.h"
 #include "jsb_timer_tags.h"
 #include "jsb_timer_action.h"
+#include "jsb_frame_callbacks.h"
+#include "jsb_measure_recorder.h"
 #include "jsb_object_handle.h"
 #include "jsb_module_loader.h"
 #include "jsb_module_resolver.h"
 #include "jsb_string_name_cache.h"
 #include "jsb_array_buffer_allocator.h"
+#include "jsb_execution_watchdog.h"
+#include "jsb_scene_builder.h"
+#include "jsb_command_buffer.h"
+#include "jsb_weak_ref.h"
+#include "jsb_valuetype_pool.h"
+#include "jsb_object_identity_cache.h"
 #include "../internal/jsb_internal.h"
+#include "../internal/jsb_file_manager.h"
+#include "../internal/jsb_json_parser.h"
+#include "../internal/jsb_resource_cache.h"
 
 // get v8 string value from string name cache with the given name
 #define jsb_name(env, name) (env)->get_string_value(jsb_string_name(name))
@@ -43,6 +54,7 @@ namespace jsb
             ClassRPCConfig,          // @rpc annotation for rpc functions
             Doc,
             MemberDocMap,
+            WeakRefCallback,         // the callback of GodotWeakRef
 
             CrossBind,               // a symbol can only be used from C++ to indicate calling from cross-bind
             CDO,                     // constructing class default object for a script
@@ -110,6 +122,19 @@ namespace jsb
 
         internal::DoubleBuffered<Message> inbox_;
 
+#if !JSB_WITH_WEB && !JSB_WITH_JAVASCRIPTCORE
+        struct PendingSceneBuild
+        {
+            // object id of the worker object (in this env) which committed the scene
+            NativeObjectID worker_id;
+            std::shared_ptr<SceneCommandBuffer> buffer;
+        };
+
+        // scenes committed by `SceneBuilder` in workers, they're replayed in `update()` in order within JSB_SCENE_BUILD_BUDGET_USEC
+        internal::DoubleBuffered<PendingSceneBuild> scene_build_inbox_;
+        std::vector<PendingSceneBuild> scene_builds_;
+#endif
+
 #if JSB_THREADING
         internal::DoubleBuffered<AsyncCall> async_calls_;
 #endif
@@ -128,7 +153,11 @@ namespace jsb
         StringNameCache string_name_cache_;
 
         ObjectDB object_db_;
-        HashSet<void*> persistent_objects_;
+        // num of bindings marked as persistent (the flag is stored in ObjectSlot)
+        uint32_t persistent_objects_num_ = 0;
+
+        // recently converted godot objects (see `TypeConvert::gd_obj_to_js`)
+        ObjectIdentityCache identity_cache_;
 
         static internal::VariantAllocator variant_allocator_;
 
@@ -139,6 +168,15 @@ namespace jsb
 #if JSB_WITH_ESSENTIALS
         JSTimerTags<uint64_t> timer_tags_;
         internal::TTimerManager<JavaScriptTimerAction> timer_manager_;
+
+        // `performance.*` support (in microseconds)
+        uint64_t time_origin_ = 0;
+
+        // unix time (in milliseconds) at `time_origin_`, it's `performance.timeOrigin`
+        double time_origin_unix_msec_ = 0;
+        JSTimerTags<uint64_t> performance_marks_;
+        JavaScriptMeasureRecorder measure_recorder_;
+        JavaScriptFrameCallbacks frame_callbacks_;
 #endif
         bool microtasks_run_ = false;
 
@@ -153,7 +191,54 @@ namespace jsb
         JavaScriptModuleCache module_cache_;
 
         internal::TypeGen<TWeakRef<v8::Function>, internal::Index32>::UnorderedMap function_refs_; // backlink
-        internal::SArray<TStrongRef<v8::Function>, internal::Index32> function_bank_;
+        internal::SArray<TStrongRef<v8::Function>, internal::Index32, internal::ChunkedAllocator<256>> function_bank_;
+
+        // async file loading (`jsb.fs.read`), JSON parsing (`jsb.json.parseAsync`) and resource loading (`jsb.load`).
+        // the callbacks of all of them are indexed by the token of requests.
+        internal::FileManager file_manager_;
+        internal::AsyncJSONParser json_parser_;
+        internal::ResourceCache resource_cache_;
+        internal::SArray<v8::Global<v8::Function>, internal::Index32> async_callbacks_;
+
+        // terminate the side-effect-free inspection (e.g. `enumerate_properties`) if it takes too long
+        ExecutionWatchdog watchdog_;
+
+        // engine calls recorded by `jsb.commands`, flushed at the end of `update()`
+        CommandBuffer command_buffer_;
+
+        // recycled wrappers of math valuetypes (quickjs.impl only), and the allocation rate of valuetypes
+        ValuetypePool valuetype_pool_;
+
+        struct PendingFinalization
+        {
+            NativeClassID class_id;
+            FinalizationType finalize;
+            void* pointer;
+
+            bool operator<(const PendingFinalization& p_other) const { return class_id < p_other.class_id; }
+        };
+
+        // native objects of garbage collected JS objects, they're already unbound (not in object_db_ anymore).
+        // they're finalized in batches (grouped by class) within JSB_GC_FINALIZE_BUDGET_USEC in `update()`.
+        std::vector<PendingFinalization> pending_finalizations_;
+        std::vector<PendingFinalization> finalizing_;
+        uint32_t finalizing_cursor_ = 0;
+
+        // objects whose ref_count_ dropped to zero in this frame, they're weakened in `update()` if still unreferenced.
+        // it avoids flipping the JS handle between weak and strong when a RefCounted is passed around repeatedly.
+        LocalVector<void*> pending_weak_objects_;
+
+        // GodotWeakRef (with a callback) waiting for the release of the binding, indexed by NativeObjectID
+        HashMap<uint64_t, LocalVector<GodotWeakRef*>> weak_ref_watchers_;
+
+        // GodotWeakRef whose binding is released, the callback is called in `update()` once the object is deleted.
+        // it's watched again if the object is bound again.
+        LocalVector<GodotWeakRef*> released_weak_refs_;
+
+        // GodotWeakRef whose object is alive but unbound (e.g. the wrapper of a RefCounted collected while still referenced in godot),
+        // nothing notifies the deletion or the rebinding of them, they're checked every `JSB_WEAK_REF_PARKED_CHECK_INTERVAL_USEC`.
+        LocalVector<GodotWeakRef*> parked_weak_refs_;
+        uint64_t parked_weak_refs_check_time_ = 0;
 
         struct DeferredClassRegister
         {
@@ -247,8 +332,9 @@ namespace jsb
         // [EXPERIMENTAL] transfer object between environments.
         // call this method of the source environment in the source environment thread.
         // if the transferred object is RefCounted, the reference count will be increased by 1 during the operation.
-        // NOTE: !!! IT MAY CRASH THE ENGINE TO TRANSFER A DEEPLY NESTED OBJECT (such as a godot Array of Objects) !!!
-        //       !!! Ensure all transferred objects are ONLY exist in the source environment !!!
+        // the whole ownership subtree is transferred in a single batch (all descendants of a Node, all objects in an Array),
+        // they're detached in the source environment at once, and rebound lazily in the target environment.
+        // NOTE: Ensure all transferred objects are NOT referenced from JS in the source environment anymore.
         // [pseudo] transfer_object(worker, master, worker_handle, scene->instantiate());
         static void transfer_object(Environment* p_from, Environment* p_to, NativeObjectID p_worker_handle_id, const Variant& p_target);
 
@@ -268,6 +354,14 @@ namespace jsb
         //     eval from source
         JSValueMove eval_source(const char* p_source, int p_length, const String& p_filename, Error& r_err);
 
+        /**
+         * \brief collect names of properties (starting with `p_prefix`) of the object at `p_path` without evaluating any code.
+         * \param p_path names of nested properties from `globalThis`, the path is only resolved through data properties (getters are never invoked)
+         * \param p_budget_ms the execution is terminated if it takes longer (only proxy traps could run into it)
+         * \return ERR_TIMEOUT if terminated, ERR_DOES_NOT_EXIST if the path can not be resolved
+         */
+        Error enumerate_properties(const Vector<String>& p_path, const String& p_prefix, uint64_t p_budget_ms, Vector<String>& r_names);
+
         /**
          * \brief load a module script
          * \param p_name module_id
@@ -332,6 +426,15 @@ namespace jsb
 #if JSB_WITH_ESSENTIALS
         jsb_force_inline internal::TTimerManager<JavaScriptTimerAction>& get_timer_manager() { return timer_manager_; }
         jsb_force_inline JSTimerTags<uint64_t>& get_timer_tags() { return timer_tags_; }
+        jsb_force_inline JSTimerTags<uint64_t>& get_performance_marks() { return performance_marks_; }
+        jsb_force_inline JavaScriptFrameCallbacks& get_frame_callbacks() { return frame_callbacks_; }
+        jsb_force_inline JavaScriptMeasureRecorder& get_measure_recorder() { return measure_recorder_; }
+        jsb_force_inline ObjectIdentityCache& get_identity_cache() { return identity_cache_; }
+
+        // monotonic time (in microseconds) since this environment created, the time origin of `performance.now()`
+        jsb_force_inline uint64_t get_time_usec() const { return OS::get_singleton()->get_ticks_usec() - time_origin_; }
+        jsb_force_inline uint64_t get_time_origin_usec() const { return time_origin_; }
+        jsb_force_inline double get_time_origin_unix_msec() const { return time_origin_unix_msec_; }
 #endif
 
         jsb_force_inline StringNameCache& get_string_name_cache() { return string_name_cache_; }
@@ -354,6 +457,7 @@ namespace jsb
         {
             p_object->SetAlignedPointerInInternalField(IF_Pointer, p_pointer);
             impl::Helper::SetDeleter(p_pointer, p_object, _valuetype_deleter, this);
+            valuetype_pool_.on_created();
         }
 
         jsb_force_inline NativeObjectID try_get_object_id(void* p_pointer) const { return object_db_.try_get_object_id(p_pointer); }
@@ -365,25 +469,48 @@ namespace jsb
         {
             if (const ObjectHandleConstPtr ptr = object_db_.try_get_object(p_key))
             {
-                r_unwrap = ptr->ref_.Get(isolate_);
+                r_unwrap = ptr->ref->Get(isolate_);
                 return true;
             }
             return false;
         }
 
+        // same as `try_get_object(p_pointer)`, but looks up in the identity cache at first
+        jsb_force_inline bool try_get_object_cached(Object* p_pointer, v8::Local<v8::Object>& r_unwrap)
+        {
+            ObjectIdentityCache::Entry& entry = identity_cache_.get_entry(p_pointer);
+            if (entry.pointer == p_pointer && try_get_object(entry.object_id, r_unwrap))
+            {
+                return true;
+            }
+            const NativeObjectID object_id = object_db_.try_get_object_id(p_pointer);
+            if (!object_id || !try_get_object(object_id, r_unwrap))
+            {
+                return false;
+            }
+            ObjectIdentityCache::put(entry, p_pointer, object_id);
+            return true;
+        }
+
+        // remember a newly bound object in the identity cache
+        jsb_force_inline void cache_object_identity(Object* p_pointer, NativeObjectID p_object_id)
+        {
+            ObjectIdentityCache::put(identity_cache_.get_entry(p_pointer), p_pointer, p_object_id);
+        }
+
         // Get JS object, will crash if object_id is invalid
         jsb_force_inline v8::Local<v8::Object> get_object(const NativeObjectID& p_object_id) const
         {
             const ObjectHandleConstPtr ptr = object_db_.get_object(p_object_id);
-            jsb_check(native_classes_.get_value(ptr->class_id).type != NativeClassType::GodotPrimitive);
-            return ptr->ref_.Get(isolate_);
+            jsb_check(native_classes_.get_value(*ptr->class_id).type != NativeClassType::GodotPrimitive);
+            return ptr->ref->Get(isolate_);
         }
 
         jsb_force_inline const NativeClassInfo* find_object_class(void* p_pointer) const
         {
             if (const ObjectHandleConstPtr ptr = object_db_.try_get_object(p_pointer))
             {
-                return &native_classes_.get_value(ptr->class_id);
+                return &native_classes_.get_value(*ptr->class_id);
             }
             return nullptr;
         }
@@ -396,6 +523,10 @@ namespace jsb
 
         void* get_verified_object(const v8::Local<v8::Object>& p_obj, NativeClassType::Type p_type) const;
 
+        // call the callback of `p_weak_ref` after the object is deleted, the binding (`get_native_object_id()`) must be valid
+        void watch_weak_ref(GodotWeakRef* p_weak_ref);
+        void unwatch_weak_ref(GodotWeakRef* p_weak_ref);
+
         // return true if operation is successful
         bool reference_object(void* p_pointer, bool p_is_inc);
         void mark_as_persistent_object(void* p_pointer);
@@ -406,6 +537,9 @@ namespace jsb
 
         void update(uint64_t p_delta_msecs);
 
+        jsb_force_inline CommandBuffer& get_command_buffer() { return command_buffer_; }
+        jsb_force_inline ValuetypePool& get_valuetype_pool() { return valuetype_pool_; }
+
         // [thread safe] it's OK to call this method before the evn inited.
         void post_message(Message&& p_message)
         {
@@ -413,6 +547,28 @@ namespace jsb
             inbox_.add(std::move(p_message));
         }
 
+#if !JSB_WITH_WEB && !JSB_WITH_JAVASCRIPTCORE
+        // [thread safe] hand over a scene built in a worker, `onbuild` of the worker object is called after it's replayed.
+        void post_scene_build(NativeObjectID p_worker_id, std::shared_ptr<SceneCommandBuffer>&& p_buffer)
+        {
+            scene_build_inbox_.add(PendingSceneBuild { p_worker_id, std::move(p_buffer) });
+        }
+#endif
+
+        // load a file in background threads, `p_callback(error: string | undefined, data: ArrayBuffer | undefined)` will be called in `update()` after loaded
+        void load_file_async(const String& p_path, const v8::Local<v8::Function>& p_callback);
+
+        // parse JSON text in background threads, `p_callback(error: string | undefined, data: any)` will be called in `update()` after parsed
+        void parse_json_async(const Vector<uint8_t>& p_utf8, const v8::Local<v8::Function>& p_callback);
+        void parse_json_async(const String& p_text, const v8::Local<v8::Function>& p_callback);
+
+        // load a resource with `ResourceLoader` threaded loading, `p_callback(error: string | undefined, resource: Resource | undefined)` will be called in `update()` after loaded.
+        // return the token of the request for cancellation.
+        uint32_t load_resource_async(const String& p_path, const String& p_type_hint, bool p_use_sub_threads, const v8::Local<v8::Function>& p_callback);
+
+        // the callback will never be called if successfully cancelled
+        bool cancel_load_resource(uint32_t p_token);
+
         class IModuleLoader* find_module_loader(const StringName& p_module_id) const
         {
             const HashMap<StringName, class IModuleLoader*>::ConstIterator it = module_loaders_.find(p_module_id);
@@ -512,7 +668,18 @@ namespace jsb
 
     private:
         void exec_async_calls();
+        void _weaken_pending_objects();
+        void _release_weak_refs(const NativeObjectID& p_object_id);
+        void _update_released_weak_refs();
+        void _update_parked_weak_refs();
+
+        // return true if all pending finalizations are done
+        bool _finalize_pending_objects(uint64_t p_deadline_usec);
         void exec_async_call(AsyncCall::Type p_type, void* p_binding);
+        void _on_file_loaded(const v8::Local<v8::Context>& p_context, internal::FileManager::LoadResult& p_result);
+        void _on_json_parsed(const v8::Local<v8::Context>& p_context, const internal::AsyncJSONParser::ParseResult& p_result);
+        void _on_resource_loaded(const v8::Local<v8::Context>& p_context, const internal::ResourceCache::LoadResult& p_result);
+        bool _take_async_callback(uint32_t p_token, v8::Local<v8::Function>& r_callback);
 
         /**
          * @note execution order is not guaranteed
@@ -521,6 +688,9 @@ namespace jsb
 
         void _on_worker_transfer(const v8::Local<v8::Context>& p_context, const struct TransferObjectData* p_data);
         void _on_worker_message(const v8::Local<v8::Context>& p_context, const Message& p_message);
+#if !JSB_WITH_WEB && !JSB_WITH_JAVASCRIPTCORE
+        void _replay_scene_builds(const v8::Local<v8::Context>& p_context);
+#endif
 
         void _rebind(v8::Isolate* isolate, const v8::Local<v8::Context> context, Object* p_this, ScriptClassID p_class_id);
 
@@ -550,6 +720,13 @@ namespace jsb
         {
             Variant* variant = (Variant*) data;
 
+            // a short-lived valuetype dies in the nursery, it's released as a whole at the end of frame
+            if (((Environment*) deleter_data)->valuetype_pool_.owns_variant(variant))
+            {
+                variant->~Variant();
+                return;
+            }
+
             // valuetype deleter is run in a background thread in v8.impl and jsc.impl
 #if JSB_WITH_V8 || JSB_WITH_JAVASCRIPTCORE
             // `Callable/Array/Dictionary` may contain reference-based objects.
@@ -1,4 +1,5 @@
 #include "jsb_essentials.h"
+#include "jsb_text_codec.h"
 #include "jsb_timer_action.h"
 #include "jsb_bridge_helper.h"
 #include "jsb_environment.h"
@@ -226,6 +227,112 @@ namespace jsb
         }
     }
 
+    // high resolution timestamp (in milliseconds, with microseconds precision) since the environment created
+    void _performance_now(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const Environment* env = Environment::wrap(isolate);
+        info.GetReturnValue().Set(v8::Number::New(isolate, (double) env->get_time_usec() / 1000.0));
+    }
+
+    void _performance_mark(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        if (!info[0]->IsString())
+        {
+            jsb_throw(isolate, "bad argument");
+            return;
+        }
+        Environment* env = Environment::wrap(isolate);
+        const uint64_t now = env->get_time_usec();
+        // overwrite the previous mark with the same name
+        env->get_performance_marks().tags.insert_or_assign(TStrongRef(isolate, info[0].As<v8::String>()), now);
+        info.GetReturnValue().Set(v8::Number::New(isolate, (double) now / 1000.0));
+    }
+
+    // performance.measure(name: string, start_mark?: string, end_mark?: string): number
+    // the start time is the time origin if `start_mark` is omitted, the end time is now if `end_mark` is omitted.
+    void _performance_measure(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        if (!info[0]->IsString()
+            || (!info[1]->IsUndefined() && !info[1]->IsString())
+            || (!info[2]->IsUndefined() && !info[2]->IsString()))
+        {
+            jsb_throw(isolate, "bad argument");
+            return;
+        }
+        Environment* env = Environment::wrap(isolate);
+        const JSTimerTags<uint64_t>& marks = env->get_performance_marks();
+        uint64_t start = 0;
+        uint64_t end = env->get_time_usec();
+        for (int index = 1; index <= 2; ++index)
+        {
+            if (info[index]->IsUndefined()) continue;
+            const auto it = marks.tags.find(TStrongRef(isolate, info[index].As<v8::String>()));
+            if (it == marks.tags.end())
+            {
+                jsb_throw(isolate, "mark not found");
+                return;
+            }
+            (index == 1 ? start : end) = it->second;
+        }
+
+        const int64_t duration_usec = (int64_t) end - (int64_t) start;
+        const double duration = (double) duration_usec / 1000.0;
+        const String name = impl::Helper::to_string(isolate, info[0]);
+        JSB_LOG(Verbose, "%s: %fms - measure", name, duration);
+        if (JavaScriptMeasureRecorder& recorder = env->get_measure_recorder(); recorder.is_enabled())
+        {
+            // shown as a function in the script profiler
+            recorder.add(StringName("performance.measure::0::" + name), (uint64_t) MAX(duration_usec, 0));
+        }
+        info.GetReturnValue().Set(v8::Number::New(isolate, duration));
+    }
+
+    // remove all marks if no name given
+    void _performance_clear_marks(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        Environment* env = Environment::wrap(isolate);
+        JSTimerTags<uint64_t>& marks = env->get_performance_marks();
+        if (info[0]->IsUndefined())
+        {
+            marks.tags.clear();
+            return;
+        }
+        if (!info[0]->IsString())
+        {
+            jsb_throw(isolate, "bad argument");
+            return;
+        }
+        marks.tags.erase(TStrongRef(isolate, info[0].As<v8::String>()));
+    }
+
+    void _request_animation_frame(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        if (!info[0]->IsFunction())
+        {
+            jsb_throw(isolate, "bad argument");
+            return;
+        }
+        const JavaScriptFrameCallbacks::Handle handle = Environment::wrap(isolate)->get_frame_callbacks()
+            .add(v8::Global<v8::Function>(isolate, info[0].As<v8::Function>()));
+        info.GetReturnValue().Set((int32_t) handle);
+    }
+
+    void _cancel_animation_frame(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        if (!info[0]->IsInt32())
+        {
+            return;
+        }
+        const int32_t handle = info[0].As<v8::Int32>()->Value();
+        Environment::wrap(isolate)->get_frame_callbacks().remove((JavaScriptFrameCallbacks::Handle) handle);
+    }
+
     void Essentials::register_(const v8::Local<v8::Context>& context, const v8::Local<v8::Object>& self)
     {
         v8::Isolate* isolate = context->GetIsolate();
@@ -259,6 +366,28 @@ namespace jsb
             self->Set(context, impl::Helper::new_string_ascii(isolate, "clearTimeout"), JSB_NEW_FUNCTION(context, _clear_timer, {})).Check();
             self->Set(context, impl::Helper::new_string_ascii(isolate, "clearImmediate"), JSB_NEW_FUNCTION(context, _clear_timer, {})).Check();
         }
+
+        // TextEncoder/TextDecoder (UTF-8)
+        TextCodec::register_(context, self);
+
+        // frame-synchronised callbacks (invoked by `Environment::update` on each frame)
+        {
+            self->Set(context, impl::Helper::new_string_ascii(isolate, "requestAnimationFrame"), JSB_NEW_FUNCTION(context, _request_animation_frame, {})).Check();
+            self->Set(context, impl::Helper::new_string_ascii(isolate, "cancelAnimationFrame"), JSB_NEW_FUNCTION(context, _cancel_animation_frame, {})).Check();
+        }
+
+        // minimal performance (User Timing) support
+        {
+            const Environment* env = Environment::wrap(isolate);
+            v8::Local<v8::Object> performance_obj = v8::Object::New(isolate);
+
+            self->Set(context, impl::Helper::new_string_ascii(isolate, "performance"), performance_obj).Check();
+            performance_obj->Set(context, impl::Helper::new_string_ascii(isolate, "timeOrigin"), v8::Number::New(isolate, env->get_time_origin_unix_msec())).Check();
+            performance_obj->Set(context, impl::Helper::new_string_ascii(isolate, "now"), JSB_NEW_FUNCTION(context, _performance_now, {})).Check();
+            performance_obj->Set(context, impl::Helper::new_string_ascii(isolate, "mark"), JSB_NEW_FUNCTION(context, _performance_mark, {})).Check();
+            performance_obj->Set(context, impl::Helper::new_string_ascii(isolate, "measure"), JSB_NEW_FUNCTION(context, _performance_measure, {})).Check();
+            performance_obj->Set(context, impl::Helper::new_string_ascii(isolate, "clearMarks"), JSB_NEW_FUNCTION(context, _performance_clear_marks, {})).Check();
+        }
     }
 #endif
 
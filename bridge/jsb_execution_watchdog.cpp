@@ -0,0 +1,87 @@
+#include "jsb_execution_watchdog.h"
+#include "../internal/jsb_thread_util.h"
+
+#define JSB_WATCHDOG_ENABLED (JSB_THREADING && !JSB_WITH_WEB && !JSB_WITH_JAVASCRIPTCORE)
+
+namespace jsb
+{
+    ExecutionWatchdog::~ExecutionWatchdog()
+    {
+        if (thread_.is_started())
+        {
+            exiting_.set();
+            semaphore_.post();
+            thread_.wait_to_finish();
+        }
+    }
+
+    void ExecutionWatchdog::arm(v8::Isolate* p_isolate, uint64_t p_budget_ms)
+    {
+#if JSB_WATCHDOG_ENABLED
+        jsb_check(!armed_isolate_);
+        if (!thread_.is_started())
+        {
+            Thread::Settings settings;
+            settings.priority = Thread::PRIORITY_HIGH;
+            thread_.start(_run, this, settings);
+        }
+
+        // quickjs only polls the termination request if the interrupt handler is installed
+        impl::Helper::set_as_interruptible(p_isolate);
+        {
+            MutexLock lock(mutex_);
+            isolate_ = p_isolate;
+            armed_isolate_ = p_isolate;
+            deadline_ = OS::get_singleton()->get_ticks_msec() + p_budget_ms;
+            terminated_ = false;
+        }
+        semaphore_.post();
+#endif
+    }
+
+    bool ExecutionWatchdog::disarm()
+    {
+#if JSB_WATCHDOG_ENABLED
+        MutexLock lock(mutex_);
+        const bool terminated = terminated_;
+        if (terminated)
+        {
+            // the termination may be requested right after the execution returned, it must not leak into the next one
+            armed_isolate_->CancelTerminateExecution();
+        }
+        isolate_ = nullptr;
+        armed_isolate_ = nullptr;
+        terminated_ = false;
+        return terminated;
+#else
+        return false;
+#endif
+    }
+
+    void ExecutionWatchdog::_run(void* p_userdata)
+    {
+        ExecutionWatchdog* watchdog = (ExecutionWatchdog*) p_userdata;
+        internal::ThreadUtil::set_name("JSWatchdog");
+        while (!watchdog->exiting_.is_set())
+        {
+            watchdog->semaphore_.wait();
+
+            // poll the deadline until disarmed, it's short-lived since the budget is expected to be tiny
+            while (!watchdog->exiting_.is_set())
+            {
+                {
+                    MutexLock lock(watchdog->mutex_);
+                    if (!watchdog->isolate_) break;
+                    if (OS::get_singleton()->get_ticks_msec() >= watchdog->deadline_)
+                    {
+                        watchdog->isolate_->TerminateExecution();
+                        watchdog->isolate_ = nullptr;
+                        watchdog->terminated_ = true;
+                        break;
+                    }
+                }
+                OS::get_singleton()->delay_usec(1000);
+            }
+        }
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef GODOTJS_EXECUTION_WATCHDOG_H
+#define GODOTJS_EXECUTION_WATCHDOG_H
+#include "jsb_bridge_pch.h"
+
+#include "core/os/thread.h"
+#include "core/os/semaphore.h"
+
+namespace jsb
+{
+    // terminate the execution in an isolate if it runs out of the time budget.
+    // the watchdog thread is started on the first use, and it's blocked while not armed.
+    //NOTE it's a no-op if the engine does not support terminating from another thread (jsc and web)
+    class ExecutionWatchdog
+    {
+    public:
+        ~ExecutionWatchdog();
+
+        // start counting down, `TerminateExecution` is called in the watchdog thread after `p_budget_ms`
+        void arm(v8::Isolate* p_isolate, uint64_t p_budget_ms);
+
+        // stop counting down (in the thread which armed it), the pending termination is cancelled if it's already requested.
+        // return true if the execution has been terminated by the watchdog.
+        bool disarm();
+
+    private:
+        static void _run(void* p_userdata);
+
+        Thread thread_;
+        ::Semaphore semaphore_;
+        Mutex mutex_;
+        SafeFlag exiting_;
+
+        // the isolate to terminate (it's reset when the watchdog fires)
+        v8::Isolate* isolate_ = nullptr;
+        v8::Isolate* armed_isolate_ = nullptr;
+        uint64_t deadline_ = 0;
+        bool terminated_ = false;
+    };
+
+    struct ExecutionBudgetScope
+    {
+        jsb_force_inline ExecutionBudgetScope(ExecutionWatchdog& p_watchdog, v8::Isolate* p_isolate, uint64_t p_budget_ms)
+            : watchdog_(p_watchdog)
+        {
+            watchdog_.arm(p_isolate, p_budget_ms);
+        }
+
+        jsb_force_inline ~ExecutionBudgetScope() { if (!disarmed_) watchdog_.disarm(); }
+
+        // return true if the execution has been terminated
+        jsb_force_inline bool disarm()
+        {
+            disarmed_ = true;
+            return watchdog_.disarm();
+        }
+
+    private:
+        ExecutionWatchdog& watchdog_;
+        bool disarmed_ = false;
+    };
+}
+
+#endif
@@ -0,0 +1,37 @@
+#include "jsb_frame_callbacks.h"
+#include "jsb_bridge_helper.h"
+#include "jsb_environment.h"
+
+namespace jsb
+{
+    bool JavaScriptFrameCallbacks::invoke(v8::Isolate* p_isolate, double p_timestamp)
+    {
+        if (pending_.empty()) return false;
+        jsb_check(running_.empty());
+        running_.swap(pending_);
+
+        const v8::Local<v8::Value> timestamp = v8::Number::New(p_isolate, p_timestamp);
+        for (size_t index = 0; index < running_.size(); ++index)
+        {
+            // cancelled by `cancelAnimationFrame`
+            if (running_[index].function.IsEmpty()) continue;
+
+            const v8::Local<v8::Function> func = running_[index].function.Get(p_isolate);
+            running_[index].function.Reset();
+
+            const v8::Local<v8::Context> context = func->GetCreationContextChecked();
+            jsb_checkf(Environment::wrap(context), "animation frame triggered after Environment disposed");
+            v8::Context::Scope context_scope(context);
+            const impl::TryCatch try_catch(p_isolate);
+            v8::Local<v8::Value> argv[] = { timestamp };
+            const v8::MaybeLocal<v8::Value> result = func->Call(context, v8::Undefined(p_isolate), std::size(argv), argv);
+            jsb_unused(result);
+            if (try_catch.has_caught())
+            {
+                JSB_LOG(Error, "animation frame error %s", BridgeHelper::get_exception(try_catch));
+            }
+        }
+        running_.clear();
+        return true;
+    }
+}
@@ -0,0 +1,82 @@
+#ifndef GODOTJS_FRAME_CALLBACKS_H
+#define GODOTJS_FRAME_CALLBACKS_H
+
+#include "jsb_bridge_pch.h"
+
+namespace jsb
+{
+    // callbacks registered by `requestAnimationFrame`.
+    // unlike timers, they're not scheduled in the timer wheel, all pending callbacks are invoked exactly once on the next `Environment::update`.
+    struct JavaScriptFrameCallbacks
+    {
+        typedef int32_t Handle;
+
+        JavaScriptFrameCallbacks() = default;
+        ~JavaScriptFrameCallbacks() = default;
+
+        JavaScriptFrameCallbacks(const JavaScriptFrameCallbacks&) = delete;
+        JavaScriptFrameCallbacks& operator=(const JavaScriptFrameCallbacks&) = delete;
+
+        jsb_force_inline bool is_empty() const { return pending_.empty(); }
+        jsb_force_inline int size() const { return (int) pending_.size(); }
+
+        Handle add(v8::Global<v8::Function>&& p_func)
+        {
+            // zero is never used as a valid handle
+            if (++last_handle_ <= 0) last_handle_ = 1;
+            pending_.push_back({ last_handle_, std::move(p_func) });
+            return last_handle_;
+        }
+
+        // it's OK to cancel a callback which is being invoked in this frame (it'll be skipped if not invoked yet)
+        bool remove(Handle p_handle)
+        {
+            for (auto it = pending_.begin(); it != pending_.end(); ++it)
+            {
+                if (it->handle == p_handle)
+                {
+                    // keep the order of the rest callbacks
+                    pending_.erase(it);
+                    return true;
+                }
+            }
+
+            // the entries being invoked can't be erased (the list is being iterated), they're dropped at the end of `invoke()`
+            for (Entry& entry : running_)
+            {
+                if (entry.handle == p_handle && !entry.function.IsEmpty())
+                {
+                    entry.function.Reset();
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void clear()
+        {
+            pending_.clear();
+            running_.clear();
+        }
+
+        // invoke all callbacks requested before this frame with the given timestamp (`performance.now()`)
+        // callbacks requested during the invocation are deferred to the next frame.
+        // return true if any callback invoked.
+        bool invoke(v8::Isolate* p_isolate, double p_timestamp);
+
+    private:
+        struct Entry
+        {
+            Handle handle;
+            v8::Global<v8::Function> function;
+        };
+
+        Handle last_handle_ = 0;
+
+        // use std::vector because we need the move semantics
+        std::vector<Entry> pending_;
+        std::vector<Entry> running_;
+    };
+}
+
+#endif
@@ -133,6 +133,14 @@ namespace jsb
             return;
         }
 
+        // (7) native helper classes which are not registered in ClassDB
+        if (type_name == jsb_string_name(GodotWeakRef))
+        {
+            const NativeClassID class_id = GodotWeakRef::register_(env);
+            info.GetReturnValue().Set(env->get_native_class(class_id)->clazz.Get(isolate));
+            return;
+        }
+
         impl::Helper::throw_error(isolate, jsb_format("godot class not found '%s'", type_name));
     }
 
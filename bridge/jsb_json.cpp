@@ -0,0 +1,417 @@
+#include "jsb_json.h"
+#include "jsb_environment.h"
+
+namespace jsb
+{
+    namespace
+    {
+        // the same limit of nesting depth as godot JSON parser
+        constexpr int kMaxDepth = 512;
+
+        // the max length of gap (the same as JSON.stringify)
+        constexpr int kMaxGap = 10;
+
+        constexpr char kHexDigits[] = "0123456789abcdef";
+
+        class JSONWriter
+        {
+        public:
+            enum Status : uint8_t
+            {
+                Written,
+                // not serializable (undefined, function, symbol)
+                Skipped,
+                // exception thrown
+                Failed,
+            };
+
+            JSONWriter(v8::Isolate* p_isolate, const v8::Local<v8::Context>& p_context, const v8::Local<v8::Value>& p_space, Vector<uint8_t>& p_buffer)
+                : isolate_(p_isolate), context_(p_context), env_(Environment::wrap(p_isolate)), buffer_(p_buffer)
+            {
+                if (p_space->IsNumber())
+                {
+                    const int n = CLAMP(p_space->Int32Value(p_context).FromMaybe(0), 0, kMaxGap);
+                    gap_ = String(" ").repeat(n).utf8();
+                }
+                else if (p_space->IsString())
+                {
+                    gap_ = impl::Helper::to_string(p_isolate, p_space).substr(0, kMaxGap).utf8();
+                }
+            }
+
+            bool write(const v8::Local<v8::Value>& p_value)
+            {
+                v8::Local<v8::Value> object_ctor, keys;
+                if (!context_->Global()->Get(context_, jsb_name(env_, Object)).ToLocal(&object_ctor) || !object_ctor->IsObject()
+                    || !object_ctor.As<v8::Object>()->Get(context_, jsb_name(env_, keys)).ToLocal(&keys) || !keys->IsFunction())
+                {
+                    jsb_throw(isolate_, "Object.keys is not available");
+                    return false;
+                }
+                object_keys_ = keys.As<v8::Function>();
+                if (!init_boxed_type("String", boxed_types_[0])
+                    || !init_boxed_type("Number", boxed_types_[1])
+                    || !init_boxed_type("Boolean", boxed_types_[2]))
+                {
+                    return false;
+                }
+
+                const Status status = write_value(p_value, [this] { return impl::Helper::new_string(isolate_, ""); });
+                if (status != Written) return false;
+                flush();
+                return true;
+            }
+
+        private:
+            // String, Number and Boolean objects are serialized as their primitive values
+            struct BoxedType
+            {
+                v8::Local<v8::Object> prototype;
+                v8::Local<v8::Function> value_of;
+            };
+
+            bool init_boxed_type(const char* p_name, BoxedType& r_type)
+            {
+                v8::Local<v8::Value> ctor, prototype, value_of;
+                if (!context_->Global()->Get(context_, impl::Helper::new_string_ascii(isolate_, p_name)).ToLocal(&ctor) || !ctor->IsObject()
+                    || !ctor.As<v8::Object>()->Get(context_, jsb_name(env_, prototype)).ToLocal(&prototype) || !prototype->IsObject()
+                    || !prototype.As<v8::Object>()->Get(context_, impl::Helper::new_string_ascii(isolate_, "valueOf")).ToLocal(&value_of) || !value_of->IsFunction())
+                {
+                    impl::Helper::throw_error(isolate_, jsb_format("%s.prototype.valueOf is not available", p_name));
+                    return false;
+                }
+                r_type.prototype = prototype.As<v8::Object>();
+                r_type.value_of = value_of.As<v8::Function>();
+                return true;
+            }
+
+            // replace the value with the result of `toJSON` if it has one, and unwrap it if it's a boxed primitive (the same as JSON.stringify).
+            // `p_key` is a functor to get the key, since it's rarely used (it's expensive to convert every array index into string).
+            template<typename TKey>
+            bool resolve(v8::Local<v8::Value>& p_value, TKey&& p_key)
+            {
+                if (!p_value->IsObject()) return true;
+                v8::Local<v8::Value> to_json;
+                if (!p_value.As<v8::Object>()->Get(context_, jsb_name(env_, toJSON)).ToLocal(&to_json)) return false;
+                if (to_json->IsFunction())
+                {
+                    v8::Local<v8::Value> argv[] = { p_key() };
+                    if (!to_json.As<v8::Function>()->Call(context_, p_value, std::size(argv), argv).ToLocal(&p_value)) return false;
+                    if (!p_value->IsObject()) return true;
+                }
+
+                const v8::Local<v8::Value> prototype = p_value.As<v8::Object>()->GetPrototype();
+                if (!prototype->IsObject()) return true;
+                for (const BoxedType& it : boxed_types_)
+                {
+                    if (it.prototype == prototype.As<v8::Object>())
+                    {
+                        return it.value_of->Call(context_, p_value, 0, nullptr).ToLocal(&p_value);
+                    }
+                }
+                return true;
+            }
+
+            static bool is_serializable(const v8::Local<v8::Value>& p_value)
+            {
+                return !p_value->IsUndefined() && !p_value->IsFunction() && !p_value->IsSymbol();
+            }
+
+            template<typename TKey>
+            Status write_value(v8::Local<v8::Value> p_value, TKey&& p_key)
+            {
+                if (!resolve(p_value, std::forward<TKey>(p_key))) return Failed;
+                if (!is_serializable(p_value)) return Skipped;
+                return write_resolved(p_value);
+            }
+
+            Status write_resolved(const v8::Local<v8::Value>& p_value)
+            {
+                if (p_value->IsNullOrUndefined())
+                {
+                    append("null", 4);
+                    return Written;
+                }
+                if (p_value->IsBoolean())
+                {
+                    if (p_value->BooleanValue(isolate_)) append("true", 4);
+                    else append("false", 5);
+                    return Written;
+                }
+                if (p_value->IsNumber())
+                {
+                    write_number(p_value);
+                    return Written;
+                }
+                if (p_value->IsString())
+                {
+                    write_string(impl::Helper::to_string(isolate_, p_value));
+                    return Written;
+                }
+                if (p_value->IsBigInt())
+                {
+                    jsb_throw(isolate_, "BigInt value can't be serialized in JSON");
+                    return Failed;
+                }
+                jsb_check(p_value->IsObject());
+                const v8::Local<v8::Object> object = p_value.As<v8::Object>();
+                for (const v8::Local<v8::Object>& it : stack_)
+                {
+                    if (it == object)
+                    {
+                        jsb_throw(isolate_, "cyclic object value");
+                        return Failed;
+                    }
+                }
+                if (stack_.size() >= kMaxDepth)
+                {
+                    jsb_throw(isolate_, "too deep to stringify");
+                    return Failed;
+                }
+
+                stack_.push_back(object);
+                const Status status = object->IsArray() ? write_array(object.As<v8::Array>()) : write_object(object);
+                stack_.pop_back();
+                return status;
+            }
+
+            Status write_array(const v8::Local<v8::Array>& p_array)
+            {
+                const uint32_t len = p_array->Length();
+                if (len == 0)
+                {
+                    append("[]", 2);
+                    return Written;
+                }
+                append('[');
+                for (uint32_t index = 0; index < len; ++index)
+                {
+                    if (index != 0) append(',');
+                    write_indent();
+
+                    v8::HandleScope handle_scope(isolate_);
+                    v8::Local<v8::Value> element;
+                    if (!p_array->Get(context_, index).ToLocal(&element)) return Failed;
+                    const Status status = write_value(element, [this, index] { return v8::Int32::New(isolate_, (int32_t) index)->ToString(context_).ToLocalChecked(); });
+                    if (status == Failed) return Failed;
+                    if (status == Skipped) append("null", 4);
+                }
+                write_closing(']');
+                return Written;
+            }
+
+            Status write_object(const v8::Local<v8::Object>& p_object)
+            {
+                v8::Local<v8::Value> argv[] = { p_object };
+                v8::Local<v8::Value> keys_value;
+                if (!object_keys_->Call(context_, v8::Undefined(isolate_), std::size(argv), argv).ToLocal(&keys_value) || !keys_value->IsArray()) return Failed;
+
+                const v8::Local<v8::Array> keys = keys_value.As<v8::Array>();
+                bool empty = true;
+                for (uint32_t index = 0, len = keys->Length(); index < len; ++index)
+                {
+                    v8::HandleScope handle_scope(isolate_);
+                    v8::Local<v8::Value> key, value;
+                    if (!keys->Get(context_, index).ToLocal(&key) || !p_object->Get(context_, key).ToLocal(&value)) return Failed;
+
+                    // the property is omitted if the value is not serializable
+                    if (!resolve(value, [&key] { return key; })) return Failed;
+                    if (!is_serializable(value)) continue;
+
+                    append(empty ? '{' : ',');
+                    write_indent();
+                    write_string(impl::Helper::to_string(isolate_, key));
+                    append(':');
+                    if (gap_.length() != 0) append(' ');
+                    if (write_resolved(value) == Failed) return Failed;
+                    empty = false;
+                }
+                if (empty)
+                {
+                    append("{}", 2);
+                    return Written;
+                }
+                write_closing('}');
+                return Written;
+            }
+
+            void write_number(const v8::Local<v8::Value>& p_value)
+            {
+                const double number = p_value.As<v8::Number>()->Value();
+                if (!Math::is_finite(number))
+                {
+                    append("null", 4);
+                    return;
+                }
+                // integers are the most common case, the others are formatted by the JS engine to get the exactly same output
+                if (Math::abs(number) < 1e15 && number == (double)(int64_t) number)
+                {
+                    char str[24];
+                    const int len = snprintf(str, sizeof(str), "%lld", (long long)(int64_t) number);
+                    append(str, len);
+                    return;
+                }
+                const CharString str = impl::Helper::to_string(isolate_, p_value->ToString(context_).ToLocalChecked()).utf8();
+                append(str.get_data(), str.length());
+            }
+
+            void write_string(const String& p_str)
+            {
+                append('"');
+                const char32_t* chars = p_str.ptr();
+                for (int index = 0, len = p_str.length(); index < len; ++index)
+                {
+                    const char32_t c = chars[index];
+                    if (c >= 0x20 && c < 0x80)
+                    {
+                        if (c == '"' || c == '\\') append('\\');
+                        append((char) c);
+                        continue;
+                    }
+                    switch (c)
+                    {
+                        case '\b': append("\\b", 2); break;
+                        case '\f': append("\\f", 2); break;
+                        case '\n': append("\\n", 2); break;
+                        case '\r': append("\\r", 2); break;
+                        case '\t': append("\\t", 2); break;
+                        default:
+                            // control characters and lone surrogates are escaped
+                            if (c < 0x20 || (c >= 0xD800 && c <= 0xDFFF))
+                            {
+                                const char escaped[] = { '\\', 'u', kHexDigits[(c >> 12) & 0xF], kHexDigits[(c >> 8) & 0xF], kHexDigits[(c >> 4) & 0xF], kHexDigits[c & 0xF] };
+                                append(escaped, std::size(escaped));
+                            }
+                            else if (c < 0x800)
+                            {
+                                const char encoded[] = { (char)(0xC0 | (c >> 6)), (char)(0x80 | (c & 0x3F)) };
+                                append(encoded, std::size(encoded));
+                            }
+                            else if (c < 0x10000)
+                            {
+                                const char encoded[] = { (char)(0xE0 | (c >> 12)), (char)(0x80 | ((c >> 6) & 0x3F)), (char)(0x80 | (c & 0x3F)) };
+                                append(encoded, std::size(encoded));
+                            }
+                            else
+                            {
+                                const char encoded[] = { (char)(0xF0 | (c >> 18)), (char)(0x80 | ((c >> 12) & 0x3F)), (char)(0x80 | ((c >> 6) & 0x3F)), (char)(0x80 | (c & 0x3F)) };
+                                append(encoded, std::size(encoded));
+                            }
+                            break;
+                    }
+                }
+                append('"');
+            }
+
+            void write_indent()
+            {
+                if (gap_.length() == 0) return;
+                append('\n');
+                for (size_t depth = 0; depth < stack_.size(); ++depth)
+                {
+                    append(gap_.get_data(), gap_.length());
+                }
+            }
+
+            void write_closing(char p_char)
+            {
+                if (gap_.length() != 0)
+                {
+                    append('\n');
+                    for (size_t depth = 1; depth < stack_.size(); ++depth)
+                    {
+                        append(gap_.get_data(), gap_.length());
+                    }
+                }
+                append(p_char);
+            }
+
+            jsb_force_inline void append(char p_char)
+            {
+                if (len_ == capacity_) grow(1);
+                ptr_[len_++] = (uint8_t) p_char;
+            }
+
+            jsb_force_inline void append(const char* p_str, int64_t p_len)
+            {
+                if (len_ + p_len > capacity_) grow(p_len);
+                memcpy(ptr_ + len_, p_str, p_len);
+                len_ += p_len;
+            }
+
+            void grow(int64_t p_len)
+            {
+                capacity_ = MAX(MAX(capacity_ * 2, len_ + p_len), (int64_t) 4096);
+                const Error err = buffer_.resize(capacity_);
+                jsb_unused(err);
+                jsb_check(err == OK);
+                ptr_ = buffer_.ptrw();
+            }
+
+            void flush()
+            {
+                // shrink to the actual size
+                const Error err = buffer_.resize(len_);
+                jsb_unused(err);
+                jsb_check(err == OK);
+                capacity_ = len_;
+                ptr_ = buffer_.ptrw();
+            }
+
+            v8::Isolate* isolate_;
+            v8::Local<v8::Context> context_;
+            Environment* env_;
+            v8::Local<v8::Function> object_keys_;
+            BoxedType boxed_types_[3];
+
+            CharString gap_;
+            std::vector<v8::Local<v8::Object>> stack_;
+
+            Vector<uint8_t>& buffer_;
+            uint8_t* ptr_ = nullptr;
+            int64_t len_ = 0;
+            int64_t capacity_ = 0;
+        };
+    }
+
+    v8::Local<v8::Value> JSONHelper::to_js(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const Variant& p_data)
+    {
+        switch (p_data.get_type())
+        {
+            case Variant::BOOL: return v8::Boolean::New(isolate, (bool) p_data);
+            case Variant::INT: return impl::Helper::new_integer(isolate, (int64_t) p_data);
+            case Variant::FLOAT: return v8::Number::New(isolate, (double) p_data);
+            case Variant::STRING: return impl::Helper::new_string(isolate, (String) p_data);
+            case Variant::ARRAY:
+                {
+                    const Array array = p_data;
+                    const int len = array.size();
+                    const v8::Local<v8::Array> rval = v8::Array::New(isolate, len);
+                    for (int index = 0; index < len; ++index)
+                    {
+                        rval->Set(context, index, to_js(isolate, context, array[index])).Check();
+                    }
+                    return rval;
+                }
+            case Variant::DICTIONARY:
+                {
+                    const Dictionary dict = p_data;
+                    const Array keys = dict.keys();
+                    const Array values = dict.values();
+                    const v8::Local<v8::Object> rval = v8::Object::New(isolate);
+                    for (int index = 0, len = keys.size(); index < len; ++index)
+                    {
+                        rval->Set(context, impl::Helper::new_string(isolate, (String) keys[index]), to_js(isolate, context, values[index])).Check();
+                    }
+                    return rval;
+                }
+            default: return v8::Null(isolate);
+        }
+    }
+
+    bool JSONHelper::stringify(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Value>& p_value, const v8::Local<v8::Value>& p_space, Vector<uint8_t>& r_buffer)
+    {
+        JSONWriter writer(isolate, context, p_space, r_buffer);
+        return writer.write(p_value);
+    }
+}
@@ -0,0 +1,20 @@
+#ifndef GODOTJS_JSON_H
+#define GODOTJS_JSON_H
+#include "jsb_bridge_pch.h"
+
+namespace jsb
+{
+    // helpers of `jsb.json.*` for large payloads
+    struct JSONHelper
+    {
+        // materialize a parsed JSON tree (Variant of Dictionary/Array/String/float/bool/null) into plain JS values in one pass.
+        // Dictionary and Array are converted into plain JS Object and Array instead of the bound godot types.
+        static v8::Local<v8::Value> to_js(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const Variant& p_data);
+
+        // the same as `JSON.stringify(value, undefined, space)`, but the UTF-8 output is written into `r_buffer` directly without intermediate JS strings.
+        // return false if an exception is thrown, or `p_value` is not serializable (undefined, function, symbol).
+        static bool stringify(v8::Isolate* isolate, const v8::Local<v8::Context>& context, const v8::Local<v8::Value>& p_value, const v8::Local<v8::Value>& p_space, Vector<uint8_t>& r_buffer);
+    };
+}
+
+#endif
@@ -0,0 +1,63 @@
+#include "jsb_measure_recorder.h"
+
+namespace jsb
+{
+    void JavaScriptMeasureRecorder::set_enabled(bool p_enabled)
+    {
+        if (p_enabled && !enabled_)
+        {
+            records_.clear();
+        }
+        enabled_ = p_enabled;
+    }
+
+    void JavaScriptMeasureRecorder::add(const StringName& p_name, uint64_t p_usec)
+    {
+        if (!enabled_) return;
+        Record& record = records_[p_name];
+        ++record.call_count;
+        record.total_usec += p_usec;
+        ++record.frame_call_count;
+        record.frame_total_usec += p_usec;
+    }
+
+    void JavaScriptMeasureRecorder::reset_frame()
+    {
+        for (KeyValue<StringName, Record>& kv : records_)
+        {
+            kv.value.frame_call_count = 0;
+            kv.value.frame_total_usec = 0;
+        }
+    }
+
+    int JavaScriptMeasureRecorder::get_accumulated_data(ScriptLanguage::ProfilingInfo* p_info_arr, int p_info_max) const
+    {
+        int index = 0;
+        for (const KeyValue<StringName, Record>& kv : records_)
+        {
+            if (index >= p_info_max) break;
+            ScriptLanguage::ProfilingInfo& info = p_info_arr[index++];
+            info.signature = kv.key;
+            info.call_count = kv.value.call_count;
+            info.total_time = kv.value.total_usec;
+            info.self_time = kv.value.total_usec;
+        }
+        return index;
+    }
+
+    int JavaScriptMeasureRecorder::get_frame_data(ScriptLanguage::ProfilingInfo* p_info_arr, int p_info_max) const
+    {
+        int index = 0;
+        for (const KeyValue<StringName, Record>& kv : records_)
+        {
+            if (index >= p_info_max) break;
+            if (kv.value.frame_call_count == 0) continue;
+            ScriptLanguage::ProfilingInfo& info = p_info_arr[index++];
+            info.signature = kv.key;
+            info.call_count = kv.value.frame_call_count;
+            info.total_time = kv.value.frame_total_usec;
+            info.self_time = kv.value.frame_total_usec;
+        }
+        return index;
+    }
+}
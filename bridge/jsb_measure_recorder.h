@@ -0,0 +1,43 @@
+#ifndef GODOTJS_MEASURE_RECORDER_H
+#define GODOTJS_MEASURE_RECORDER_H
+
+#include "jsb_bridge_pch.h"
+#include "core/object/script_language.h"
+
+namespace jsb
+{
+    // durations reported by `performance.measure`, they're the trace sink of the script profiler in the editor
+    // (see `GodotJSScriptLanguage::profiling_get_accumulated_data/profiling_get_frame_data`).
+    // nothing is recorded unless profiling started.
+    class JavaScriptMeasureRecorder
+    {
+    public:
+        jsb_force_inline bool is_enabled() const { return enabled_; }
+
+        // all records are discarded on start
+        void set_enabled(bool p_enabled);
+
+        void add(const StringName& p_name, uint64_t p_usec);
+
+        // called at the beginning of each frame
+        void reset_frame();
+
+        int get_accumulated_data(ScriptLanguage::ProfilingInfo* p_info_arr, int p_info_max) const;
+        int get_frame_data(ScriptLanguage::ProfilingInfo* p_info_arr, int p_info_max) const;
+
+    private:
+        struct Record
+        {
+            uint64_t call_count = 0;
+            uint64_t total_usec = 0;
+
+            uint64_t frame_call_count = 0;
+            uint64_t frame_total_usec = 0;
+        };
+
+        bool enabled_ = false;
+        HashMap<StringName, Record> records_;
+    };
+}
+
+#endif
@@ -4,233 +4,371 @@
 #include "jsb_bridge_pch.h"
 #include "core/os/rw_lock.h"
 #include "jsb_object_handle.h"
+#include "../internal/jsb_chunked_allocator.h"
 
 namespace jsb
 {
 #if JSB_THREADING
-#   define JSB_OBJECT_DB_HANDLE(Type, Ptr) Type(&lock_, Ptr)
 #   define JSB_OBJECT_DB_STATEMENT(Statement) Statement
+    typedef RWLock ObjectDBLock;
+#else
+#   define JSB_OBJECT_DB_STATEMENT(Statement) (void) 0
+    struct ObjectDBLock
+    {
+        void read_lock() const {}
+        void read_unlock() const {}
+        void write_lock() {}
+        void write_unlock() {}
+    };
+#endif
 
-    struct ObjectHandlePtr
+    // a scoped handle which holds the lock of ObjectDB (write lock if mutable, read lock if const)
+    template<bool TMutable>
+    struct TObjectHandlePtr
     {
     private:
-        RWLock* lock_;
-        internal::SArray<ObjectHandle, NativeObjectID>::Pointer ptr_;
+        using LockType = std::conditional_t<TMutable, ObjectDBLock, const ObjectDBLock>;
 
-    public:
-        ObjectHandlePtr(const ObjectHandlePtr& ) = delete;
+        LockType* lock_;
+        ObjectHandle handle_;
 
-        ObjectHandlePtr(): lock_(nullptr) {}
-        ObjectHandlePtr(RWLock* p_lock, internal::SArray<ObjectHandle, NativeObjectID>::Pointer&& p_ptr)
-            : lock_(p_lock), ptr_(std::move(p_ptr))
+        void unlock()
         {
+            if (lock_)
+            {
+                if constexpr (TMutable) lock_->write_unlock();
+                else lock_->read_unlock();
+                lock_ = nullptr;
+            }
         }
 
-        ~ObjectHandlePtr()
-        {
-            if (lock_) lock_->write_unlock();
-        }
+    public:
+        TObjectHandlePtr(const TObjectHandlePtr& ) = delete;
+
+        TObjectHandlePtr(): lock_(nullptr), handle_() {}
+        TObjectHandlePtr(LockType* p_lock, const ObjectHandle& p_handle) : lock_(p_lock), handle_(p_handle) {}
+
+        ~TObjectHandlePtr() { unlock(); }
 
-        ObjectHandle* operator->() const { return ptr_.operator->(); }
-        explicit operator bool() const { return (bool) ptr_; }
+        const ObjectHandle* operator->() const { return &handle_; }
+        explicit operator bool() const { return handle_.slot; }
 
-        ObjectHandlePtr& operator=(std::nullptr_t)
+        TObjectHandlePtr& operator=(std::nullptr_t)
         {
-            if (lock_) lock_->write_unlock();
-            lock_ = nullptr;
-            ptr_ = nullptr;
+            unlock();
+            handle_ = {};
             return *this;
         }
 
-        ObjectHandlePtr(ObjectHandlePtr&& p_other) noexcept
-            : lock_(p_other.lock_), ptr_(std::move(p_other.ptr_))
+        TObjectHandlePtr(TObjectHandlePtr&& p_other) noexcept
+            : lock_(p_other.lock_), handle_(p_other.handle_)
         {
             p_other.lock_ = nullptr;
+            p_other.handle_ = {};
         }
 
-        ObjectHandlePtr& operator=(ObjectHandlePtr&& p_other) noexcept
+        TObjectHandlePtr& operator=(TObjectHandlePtr&& p_other) noexcept
         {
             if (this != &p_other)
             {
+                unlock();
                 lock_ = p_other.lock_;
-                ptr_ = std::move(p_other.ptr_);
+                handle_ = p_other.handle_;
                 p_other.lock_ = nullptr;
+                p_other.handle_ = {};
             }
             return *this;
         }
     };
 
-    struct ObjectHandleConstPtr
+    typedef TObjectHandlePtr<true> ObjectHandlePtr;
+    typedef TObjectHandlePtr<false> ObjectHandleConstPtr;
+
+    // bindings are stored as struct-of-arrays indexed by the slot index of NativeObjectID.
+    // the hot fields (revision, ref_count) are packed in ObjectSlot, and the JS references are stored separately.
+    // all arrays grow page by page, existing slots are never moved (or copied) on growing.
+    class ObjectDB
     {
     private:
-        const RWLock* lock_;
-        internal::SArray<ObjectHandle, NativeObjectID>::ConstPointer ptr_;
+        typedef internal::ChunkedAllocator<1024> SlotAllocator;
+        typedef v8::Global<v8::Object> RefType;
 
-    public:
-        ObjectHandleConstPtr(const ObjectHandleConstPtr& ) = delete;
+        template<typename T>
+        using SlotArray = SlotAllocator::ForType<T>;
+
+        SlotArray<ObjectSlot> slots_;
+        SlotArray<NativeClassID> class_ids_;
+        SlotArray<RefType> refs_;
+#if JSB_DEBUG
+        SlotArray<void*> pointers_;
+#endif
+
+        // number of slots ever used (free or not)
+        uint32_t num_slots_ = 0;
 
-        ObjectHandleConstPtr(): lock_(nullptr) {}
-        ObjectHandleConstPtr(const RWLock* p_lock, internal::SArray<ObjectHandle, NativeObjectID>::ConstPointer&& p_ptr)
-            : lock_(p_lock), ptr_(std::move(p_ptr))
+        // indices of free slots (reused in LIFO order)
+        LocalVector<uint32_t> free_slots_;
+        int size_ = 0;
+
+        // mapping object pointer to object_id, sharded by the pointer hash with a lock for each shard.
+        // Godot may free objects in any thread (it only queries the pointer index before posting to the owner thread),
+        // which should not contend with the lookups in the owner thread.
+        //NOTE lock order: lock_ => shard lock (a shard lock is never held while acquiring lock_)
+        struct alignas(64) IndexShard
         {
-        }
+            mutable ObjectDBLock lock;
+            HashMap<void*, NativeObjectID> map;
+        };
+
+        enum { kIndexShardBits = 4, kIndexShards = 1 << kIndexShardBits };
+
+        IndexShard index_shards_[kIndexShards];
+
+        // guards the slot arrays
+        mutable ObjectDBLock lock_;
 
-        ~ObjectHandleConstPtr()
+        jsb_force_inline IndexShard& get_shard(void* p_pointer) const
         {
-            if (lock_) lock_->read_unlock();
+            // fibonacci hashing, the low bits of pointers are always zero due to the alignment
+            const uint32_t hash = (uint32_t) (((uintptr_t) p_pointer >> 4) * 0x9E3779B1u);
+            return const_cast<IndexShard&>(index_shards_[hash >> (32 - kIndexShardBits)]);
         }
 
-        const ObjectHandle* operator->() const { return ptr_.operator->(); }
-        explicit operator bool() const { return (bool) ptr_; }
-        ObjectHandleConstPtr& operator=(std::nullptr_t)
+        jsb_force_inline NativeObjectID find_in_index(void* p_pointer) const
         {
-            if (lock_) lock_->read_unlock();
-            lock_ = nullptr;
-            ptr_ = nullptr;
-            return *this;
+            const IndexShard& shard = get_shard(p_pointer);
+            shard.lock.read_lock();
+            const NativeObjectID* entry = shard.map.getptr(p_pointer);
+            const NativeObjectID object_id = entry ? *entry : NativeObjectID();
+            shard.lock.read_unlock();
+            return object_id;
         }
 
-        ObjectHandleConstPtr(ObjectHandleConstPtr&& p_other) noexcept
-            : lock_(p_other.lock_), ptr_(std::move(p_other.ptr_))
+        jsb_force_inline bool is_valid_id(const NativeObjectID& p_object_id) const
         {
-            p_other.lock_ = nullptr;
+            const uint32_t index = (uint32_t) p_object_id.get_index();
+            if (index >= num_slots_) return false;
+            const ObjectSlot& slot = slots_.at(index);
+            return slot.alive && slot.revision == p_object_id.get_revision();
         }
 
-        ObjectHandleConstPtr& operator=(ObjectHandleConstPtr&& p_other) noexcept
+        jsb_force_inline ObjectHandle get_handle(uint32_t p_index) const
         {
-            if (this != &p_other)
-            {
-                lock_ = p_other.lock_;
-                ptr_ = std::move(p_other.ptr_);
-                p_other.lock_ = nullptr;
-            }
-            return *this;
-        }
-    };
+            jsb_check(p_index < num_slots_ && slots_.at(p_index).alive);
+#if JSB_DEBUG
+            return { &slots_.at(p_index), &class_ids_.at(p_index), &pointers_.at(p_index), &refs_.at(p_index) };
 #else
-#   define JSB_OBJECT_DB_HANDLE(Type, Ptr) (sizeof(Type), Ptr)
-#   define JSB_OBJECT_DB_STATEMENT(Statement) (void) 0
-
-    typedef internal::SArray<ObjectHandle, NativeObjectID>::Pointer ObjectHandlePtr;
-    typedef internal::SArray<ObjectHandle, NativeObjectID>::ConstPointer ObjectHandleConstPtr;
+            return { &slots_.at(p_index), &class_ids_.at(p_index), &refs_.at(p_index) };
 #endif
+        }
 
-    class ObjectDB
-    {
-    private:
-        // cpp objects should be added here since the gc callback is not guaranteed by v8
-        // we need to delete them on finally releasing Environment
-        internal::SArray<ObjectHandle, NativeObjectID> objects_;
-
-        // (unsafe) mapping object pointer to object_id
-        HashMap<void*, NativeObjectID> objects_index_;
-
-#if JSB_THREADING
-        RWLock lock_;
+        // only new pages are allocated (zero-filled), the slots are constructed on first use
+        void reserve(uint32_t p_capacity)
+        {
+            const size_t capacity = slots_.capacity();
+            slots_.resize(capacity, p_capacity);
+            class_ids_.resize(capacity, p_capacity);
+            refs_.resize(capacity, p_capacity);
+#if JSB_DEBUG
+            pointers_.resize(capacity, p_capacity);
 #endif
+        }
 
     public:
         ObjectDB(int p_capacity)
         {
-            objects_.reserve(p_capacity);
+            reserve((uint32_t) p_capacity);
         }
 
         ~ObjectDB()
         {
-            jsb_check(objects_.size() == 0);
-            jsb_check(objects_index_.size() == 0);
+            jsb_check(size_ == 0);
+#if JSB_WITH_CHECK
+            for (const IndexShard& shard : index_shards_) jsb_check(shard.map.size() == 0);
+#endif
+            for (uint32_t index = 0; index < num_slots_; ++index)
+            {
+                refs_.at(index).~RefType();
+            }
         }
 
-        jsb_force_inline int size() const { return objects_.size(); }
+        jsb_force_inline int size() const { return size_; }
+
+        // approximate memory usage of each binding (including the pointer index)
+        static constexpr size_t get_bytes_per_object()
+        {
+            return sizeof(ObjectSlot) + sizeof(NativeClassID) + sizeof(v8::Global<v8::Object>)
+#if JSB_DEBUG
+                + sizeof(void*)
+#endif
+                + sizeof(HashMapElement<void*, NativeObjectID>) + sizeof(HashMapElement<void*, NativeObjectID>*) + sizeof(uint32_t);
+        }
+
+        // memory used by all slots (including free ones) and the pointer index
+        size_t get_memory_usage() const
+        {
+            size_t num_indexed = 0;
+            for (const IndexShard& shard : index_shards_)
+            {
+                shard.lock.read_lock();
+                num_indexed += shard.map.size();
+                shard.lock.read_unlock();
+            }
+
+            lock_.read_lock();
+            const size_t slot_bytes = sizeof(ObjectSlot) + sizeof(NativeClassID) + sizeof(v8::Global<v8::Object>)
+#if JSB_DEBUG
+                + sizeof(void*)
+#endif
+                + sizeof(uint32_t);
+            const size_t bytes = slots_.capacity() * slot_bytes
+                + num_indexed * (sizeof(HashMapElement<void*, NativeObjectID>) + sizeof(HashMapElement<void*, NativeObjectID>*) + sizeof(uint32_t));
+            lock_.read_unlock();
+            return bytes;
+        }
 
+        // only the shard of `p_pointer` is locked
         jsb_force_inline bool has_object(void* p_pointer) const
         {
-            JSB_OBJECT_DB_STATEMENT(RWLockRead lock(lock_));
-            return objects_index_.has(p_pointer);
+            const IndexShard& shard = get_shard(p_pointer);
+            JSB_OBJECT_DB_STATEMENT(RWLockRead lock(shard.lock));
+            return shard.map.has(p_pointer);
         }
 
         jsb_force_inline bool has_object(const NativeObjectID& p_object_id) const
         {
             JSB_OBJECT_DB_STATEMENT(RWLockRead lock(lock_));
-            return objects_.is_valid_index(p_object_id);
+            return is_valid_id(p_object_id);
         }
 
-        jsb_force_inline void* try_get_first_pointer() const
+        void* try_get_first_pointer() const
         {
-            JSB_OBJECT_DB_STATEMENT(RWLockRead lock(lock_));
-            return objects_index_.size() ? objects_index_.begin()->key : nullptr;
+            for (const IndexShard& shard : index_shards_)
+            {
+                JSB_OBJECT_DB_STATEMENT(RWLockRead lock(shard.lock));
+                if (shard.map.size()) return shard.map.begin()->key;
+            }
+            return nullptr;
         }
 
         jsb_force_inline NativeObjectID try_get_object_id(void* p_pointer) const
         {
-            JSB_OBJECT_DB_STATEMENT(RWLockRead lock(lock_));
-            const NativeObjectID* it = objects_index_.getptr(p_pointer);
-            return it ? *it : NativeObjectID();
+            return find_in_index(p_pointer);
         }
 
         // whether the `p_pointer` registered in the object binding map
         // return true, and the corresponding JS value if `p_pointer` is valid
         jsb_force_inline ObjectHandleConstPtr try_get_object(void* p_pointer) const
         {
-            JSB_OBJECT_DB_STATEMENT(lock_.read_lock());
+            const NativeObjectID object_id = find_in_index(p_pointer);
+            if (!object_id) return ObjectHandleConstPtr();
 
-            const NativeObjectID* entry = objects_index_.getptr(p_pointer);
-            if (entry) return JSB_OBJECT_DB_HANDLE(ObjectHandleConstPtr, objects_.get_value_scoped(*entry));
+            // the revision check rejects the slot if it's removed after the shard lock is released
+            lock_.read_lock();
+            if (is_valid_id(object_id)) return ObjectHandleConstPtr(&lock_, get_handle(object_id.get_index()));
 
-            JSB_OBJECT_DB_STATEMENT(lock_.read_unlock());
+            lock_.read_unlock();
             return ObjectHandleConstPtr();
         }
 
         // [MUTABLE]
         jsb_force_inline ObjectHandlePtr try_get_object(void* p_pointer)
         {
-            JSB_OBJECT_DB_STATEMENT(lock_.write_lock());
+            const NativeObjectID object_id = find_in_index(p_pointer);
+            if (!object_id) return ObjectHandlePtr();
 
-            const NativeObjectID* entry = objects_index_.getptr(p_pointer);
-            if (entry) return JSB_OBJECT_DB_HANDLE(ObjectHandlePtr, objects_.get_value_scoped(*entry));
+            lock_.write_lock();
+            if (is_valid_id(object_id)) return ObjectHandlePtr(&lock_, get_handle(object_id.get_index()));
 
-            JSB_OBJECT_DB_STATEMENT(lock_.write_unlock());
+            lock_.write_unlock();
             return ObjectHandlePtr();
         }
 
         jsb_force_inline ObjectHandleConstPtr try_get_object(const NativeObjectID& p_object_id) const
         {
-            JSB_OBJECT_DB_STATEMENT(lock_.read_lock());
-            return JSB_OBJECT_DB_HANDLE(ObjectHandleConstPtr, objects_.try_get_value_scoped(p_object_id));
+            lock_.read_lock();
+            if (is_valid_id(p_object_id)) return ObjectHandleConstPtr(&lock_, get_handle(p_object_id.get_index()));
+
+            lock_.read_unlock();
+            return ObjectHandleConstPtr();
+        }
+
+        // [MUTABLE] mark the binding as watched by GodotWeakRef (or not).
+        // return false if `p_object_id` is not valid.
+        bool set_watched(const NativeObjectID& p_object_id, bool p_watched)
+        {
+            JSB_OBJECT_DB_STATEMENT(RWLockWrite lock(lock_));
+            if (!is_valid_id(p_object_id)) return false;
+            slots_.at(p_object_id.get_index()).watched = p_watched;
+            return true;
         }
 
         // will crash if the object is not registered in the object binding map
         jsb_force_inline ObjectHandleConstPtr get_object(const NativeObjectID& p_object_id) const
         {
-            JSB_OBJECT_DB_STATEMENT(lock_.read_lock());
-            return JSB_OBJECT_DB_HANDLE(ObjectHandleConstPtr, objects_.get_value_scoped(p_object_id));
+            lock_.read_lock();
+            jsb_check(is_valid_id(p_object_id));
+            return ObjectHandleConstPtr(&lock_, get_handle(p_object_id.get_index()));
         }
 
         // [MUTABLE]
         NativeObjectID add_object(void* p_pointer, ObjectHandlePtr* o_handle)
         {
-            JSB_OBJECT_DB_STATEMENT(lock_.write_lock());
-            jsb_checkf(!objects_index_.has(p_pointer), "duplicated bindings");
-            const NativeObjectID object_id = objects_.add({});
-            objects_index_.insert(p_pointer, object_id);
+            IndexShard& shard = get_shard(p_pointer);
+            lock_.write_lock();
+            uint32_t index;
+            if (!free_slots_.is_empty())
+            {
+                index = free_slots_[free_slots_.size() - 1];
+                free_slots_.resize(free_slots_.size() - 1);
+            }
+            else
+            {
+                index = num_slots_++;
+                if (index >= slots_.capacity()) reserve(index + 1);
+                memnew_placement(&refs_.at(index), RefType);
+            }
 
-            if (o_handle) *o_handle = JSB_OBJECT_DB_HANDLE(ObjectHandlePtr, objects_.get_value_scoped(object_id));
-            else JSB_OBJECT_DB_STATEMENT(lock_.write_unlock());
+            ObjectSlot& slot = slots_.at(index);
+            uint32_t revision = slot.revision;
+            NativeObjectID::increase_revision(revision);
+            slot = { revision, 0, 0, 1 };
+            class_ids_.at(index) = {};
+            ++size_;
+
+            const NativeObjectID object_id((int32_t) index, revision);
+            shard.lock.write_lock();
+            jsb_checkf(!shard.map.has(p_pointer), "duplicated bindings");
+            shard.map.insert(p_pointer, object_id);
+            shard.lock.write_unlock();
+
+            if (o_handle) *o_handle = ObjectHandlePtr(&lock_, get_handle(index));
+            else lock_.write_unlock();
             return object_id;
         }
 
         // [MUTABLE]
         void remove_object(void* p_pointer)
         {
-            JSB_OBJECT_DB_STATEMENT(lock_.write_lock());
-            const NativeObjectID* entry = objects_index_.getptr(p_pointer);
-            jsb_check(entry);
-            objects_.remove_at_checked(*entry);
-            objects_index_.erase(p_pointer);
-            JSB_OBJECT_DB_STATEMENT(lock_.write_unlock());
+            IndexShard& shard = get_shard(p_pointer);
+            lock_.write_lock();
+            shard.lock.write_lock();
+            const NativeObjectID* entry = shard.map.getptr(p_pointer);
+            jsb_check(entry && is_valid_id(*entry));
+            const uint32_t index = (uint32_t) entry->get_index();
+            shard.map.erase(p_pointer);
+            shard.lock.write_unlock();
+
+            slots_.at(index).alive = 0;
+            refs_.at(index).Reset();
+#if JSB_DEBUG
+            pointers_.at(index) = nullptr;
+#endif
+            free_slots_.push_back(index);
+            --size_;
+            lock_.write_unlock();
         }
     };
 }
 
 #endif
-
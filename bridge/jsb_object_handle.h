@@ -14,24 +14,50 @@ namespace jsb
         IF_ObjectFieldCount = 2,
     };
 
+    // hot fields of a binding in ObjectDB, packed in 8 bytes
+    struct ObjectSlot
+    {
+        // revision of the NativeObjectID which currently occupies this slot
+        uint32_t revision;
+
+        uint32_t ref_count : 27;
+
+        // whether the JS reference is weak currently.
+        // it's not weakened immediately when `ref_count` drops to zero (see `Environment::reference_object`).
+        uint32_t weak : 1;
+
+        uint32_t alive : 1;
+
+        // whether any GodotWeakRef waits for the release of this binding (see `Environment::watch_weak_ref`)
+        uint32_t watched : 1;
+
+        // the native object is not finalized on the release of this binding (see `Environment::mark_as_persistent_object`)
+        uint32_t persistent : 1;
+
+        // whether it's in the pending list of `Environment::_weaken_pending_objects`, it's pushed only once until weakened
+        uint32_t pending_weak : 1;
+    };
+
     // godot Object classes or c++ native wrapped classes are registered in an object registry in Environment.
     // godot Variant (valuetype) DO NOT have it's ObjectHandle.
+    // ObjectDB stores bindings as struct-of-arrays, a handle is a view of the fields of one binding,
+    // it's only valid while the ObjectHandlePtr/ObjectHandleConstPtr is held.
     struct ObjectHandle
     {
-        NativeClassID class_id;
+        ObjectSlot* slot;
 
-        uint32_t ref_count_;
+        NativeClassID* class_id;
 
 #if JSB_DEBUG
         // The raw pointer to the native object.
         // It must be a unique pointer which implies that different objects have different addresses.
         //NOTE it's useless at runtime now. we hold it here to validate the object binding for debugging only.
-        void* pointer;
+        void** pointer;
 #endif
 
         // this reference is initially weak and hooked on v8 gc callback.
-        // it becomes a strong reference after the `ref_count_` explicitly increased.
-        v8::Global<v8::Object> ref_;
+        // it becomes a strong reference after the `ref_count` explicitly increased.
+        v8::Global<v8::Object>* ref;
     };
 
 }
@@ -0,0 +1,65 @@
+#ifndef GODOTJS_OBJECT_IDENTITY_CACHE_H
+#define GODOTJS_OBJECT_IDENTITY_CACHE_H
+#include "jsb_bridge_pch.h"
+
+namespace jsb
+{
+    // a direct-mapped cache of `Object* => NativeObjectID` for the objects frequently converted to JS (singletons, `get_tree()`, `get_parent()`...),
+    // a hit skips the lookup in the (sharded) pointer index of ObjectDB.
+    // entries are never invalidated explicitly, the revision of NativeObjectID rejects a stale entry (the binding released) on lookup.
+    // NOTE JS handles are not cached, a `Local` can't outlive the HandleScope it's created in.
+    class ObjectIdentityCache
+    {
+    public:
+        static constexpr uint32_t kBits = JSB_OBJECT_IDENTITY_CACHE_BITS;
+        static_assert(kBits > 0 && kBits < 32);
+
+        struct Entry
+        {
+            void* pointer = nullptr;
+            NativeObjectID object_id;
+
+            // permanent entries (persistent objects, e.g. singletons) are not evicted by other objects
+            bool permanent = false;
+        };
+
+        jsb_force_inline Entry& get_entry(void* p_pointer)
+        {
+            // fibonacci hashing, the low bits of pointers are always zero due to the alignment
+            const uint32_t hash = (uint32_t) (((uintptr_t) p_pointer >> 4) * 0x9E3779B1u);
+            return entries_[hash >> (32 - kBits)];
+        }
+
+        jsb_force_inline static void put(Entry& p_entry, void* p_pointer, NativeObjectID p_object_id)
+        {
+            if (p_entry.pointer != p_pointer)
+            {
+                if (p_entry.permanent) return;
+                p_entry.pointer = p_pointer;
+            }
+            p_entry.object_id = p_object_id;
+        }
+
+        // a slot already pinned by another object is kept (return false), the later object is looked up in ObjectDB as usual
+        jsb_force_inline bool put_permanent(void* p_pointer, NativeObjectID p_object_id)
+        {
+            Entry& entry = get_entry(p_pointer);
+            if (entry.permanent && entry.pointer != p_pointer) return false;
+            entry.pointer = p_pointer;
+            entry.object_id = p_object_id;
+            entry.permanent = true;
+            return true;
+        }
+
+        // called on dispose, the pointers are dangling after all objects are freed
+        void clear()
+        {
+            for (Entry& entry : entries_) entry = {};
+        }
+
+    private:
+        Entry entries_[1u << kBits];
+    };
+}
+
+#endif
@@ -0,0 +1,227 @@
+#include "jsb_scene_builder.h"
+#include "jsb_worker.h"
+#include "jsb_environment.h"
+#include "jsb_type_convert.h"
+
+#if !JSB_WITH_WEB && !JSB_WITH_JAVASCRIPTCORE
+namespace jsb
+{
+    SceneCommandBuffer::~SceneCommandBuffer()
+    {
+        // all created nodes are owned by the root (orphans are freed on creation)
+        if (!nodes_.is_empty() && nodes_[0])
+        {
+            memdelete(nodes_[0]);
+        }
+    }
+
+    uint32_t SceneCommandBuffer::create(const StringName& p_class_name, uint32_t p_parent)
+    {
+        const uint32_t node = num_nodes_++;
+        commands_.push_back({ SceneCommand::TYPE_CREATE, node, node == 0 ? kNoParent : p_parent, p_class_name, Variant() });
+        return node;
+    }
+
+    void SceneCommandBuffer::set(uint32_t p_node, const StringName& p_name, const Variant& p_value)
+    {
+        commands_.push_back({ SceneCommand::TYPE_SET, p_node, kNoParent, p_name, p_value });
+    }
+
+    bool SceneCommandBuffer::replay(uint64_t p_deadline_usec)
+    {
+        if (cursor_ == 0)
+        {
+            nodes_.resize(num_nodes_);
+            for (uint32_t index = 0; index < num_nodes_; ++index) nodes_[index] = nullptr;
+        }
+
+        const OS* os = OS::get_singleton();
+        const uint32_t num = commands_.size();
+        while (cursor_ < num)
+        {
+            const SceneCommand& command = commands_[cursor_++];
+            switch (command.type)
+            {
+            case SceneCommand::TYPE_CREATE:
+                {
+                    Object* obj = ClassDB::instantiate(command.name);
+                    Node* node = Object::cast_to<Node>(obj);
+                    if (!node)
+                    {
+                        JSB_LOG(Error, "SceneBuilder: %s is not a node class", command.name);
+                        if (obj) memdelete(obj);
+                        break;
+                    }
+                    if (command.node != 0)
+                    {
+                        Node* parent = nodes_[command.parent];
+                        if (!parent)
+                        {
+                            // the parent failed to create
+                            memdelete(node);
+                            break;
+                        }
+                        parent->add_child(node);
+                    }
+                    nodes_[command.node] = node;
+                } break;
+            case SceneCommand::TYPE_SET:
+                if (Node* node = nodes_[command.node])
+                {
+                    bool valid;
+                    node->set(command.name, command.value, &valid);
+                    if (!valid)
+                    {
+                        JSB_LOG(Warning, "SceneBuilder: failed to set %s.%s", node->get_class_name(), command.name);
+                    }
+                } break;
+            default: jsb_checkf(false, "unknown SceneCommand: %d", command.type); break;
+            }
+
+            if (os->get_ticks_usec() >= p_deadline_usec) break;
+        }
+        if (cursor_ < num) return false;
+
+        // release values (Resources etc.) as soon as possible
+        commands_.clear();
+        return true;
+    }
+
+    Node* SceneCommandBuffer::take_root()
+    {
+        Node* root = nodes_.is_empty() ? nullptr : nodes_[0];
+        nodes_.clear();
+        return root;
+    }
+
+    void SceneBuilder::register_(Environment* p_env, const v8::Local<v8::Context>& p_context, const v8::Local<v8::Object>& p_exports)
+    {
+        v8::Isolate* isolate = p_env->get_isolate();
+        const StringName class_name = jsb_string_name(SceneBuilder);
+        const NativeClassID class_id = p_env->add_native_class(NativeClassType::SceneBuilder, class_name);
+        impl::ClassBuilder class_builder = impl::ClassBuilder::New<IF_ObjectFieldCount>(isolate, class_name, &constructor, *class_id);
+
+        class_builder.Instance().Method("create", &create);
+        class_builder.Instance().Method("set", &set);
+        class_builder.Instance().Method("commit", &commit);
+
+        const NativeClassInfoPtr class_info = p_env->get_native_class(class_id);
+        class_info->finalizer = &finalizer;
+        class_info->clazz = class_builder.Build();
+        jsb_check(!class_info->clazz.IsEmpty());
+        p_exports->Set(p_context, jsb_name(p_env, SceneBuilder), class_info->clazz.Get(isolate)).Check();
+    }
+
+    void SceneBuilder::constructor(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const internal::Index32 class_id(info.Data().As<v8::Uint32>()->Value());
+        SceneBuilder* ptr = memnew(SceneBuilder);
+        ptr->buffer_ = std::make_shared<SceneCommandBuffer>();
+        const NativeObjectID handle = Environment::wrap(isolate)->bind_pointer(class_id, NativeClassType::SceneBuilder, ptr, info.This(), 0);
+        jsb_check(handle);
+        jsb_unused(handle);
+    }
+
+    void SceneBuilder::finalizer(Environment*, void* pointer, FinalizationType /* p_finalize */)
+    {
+        memdelete((SceneBuilder*) pointer);
+    }
+
+    // [js] create(class_name: string, parent?: number): number
+    void SceneBuilder::create(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const v8::Local<v8::Object> self = info.This();
+        if (!TypeConvert::is_object(self, NativeClassType::SceneBuilder))
+        {
+            jsb_throw(isolate, "bad this");
+            return;
+        }
+        SceneCommandBuffer* buffer = ((SceneBuilder*) self->GetAlignedPointerFromInternalField(IF_Pointer))->buffer_.get();
+
+        // ClassDB is safe to read in any thread
+        const StringName class_name = impl::Helper::to_string(isolate, info[0]);
+        if (!ClassDB::can_instantiate(class_name) || !ClassDB::is_parent_class(class_name, jsb_string_name(Node)))
+        {
+            jsb_throw(isolate, "not an instantiable node class");
+            return;
+        }
+        uint32_t parent = 0;
+        if (!info[1]->IsUndefined())
+        {
+            if (!info[1]->IsUint32() || !buffer->is_valid_node(info[1].As<v8::Uint32>()->Value()))
+            {
+                jsb_throw(isolate, "bad parent");
+                return;
+            }
+            parent = info[1].As<v8::Uint32>()->Value();
+        }
+        info.GetReturnValue().Set(v8::Uint32::NewFromUnsigned(isolate, buffer->create(class_name, parent)));
+    }
+
+    // [js] set(node: number, property: string, value: any): void
+    void SceneBuilder::set(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        const v8::Local<v8::Object> self = info.This();
+        if (!TypeConvert::is_object(self, NativeClassType::SceneBuilder))
+        {
+            jsb_throw(isolate, "bad this");
+            return;
+        }
+        SceneCommandBuffer* buffer = ((SceneBuilder*) self->GetAlignedPointerFromInternalField(IF_Pointer))->buffer_.get();
+        if (!info[0]->IsUint32() || !buffer->is_valid_node(info[0].As<v8::Uint32>()->Value()) || !info[1]->IsString())
+        {
+            jsb_throw(isolate, "bad argument");
+            return;
+        }
+
+        // the value is converted here, only the Variant is passed to the main thread
+        Variant value;
+        if (!TypeConvert::js_to_gd_var(isolate, context, info[2], value))
+        {
+            jsb_throw(isolate, "bad value");
+            return;
+        }
+        buffer->set(info[0].As<v8::Uint32>()->Value(), impl::Helper::to_string(isolate, info[1]), value);
+    }
+
+    // [js] commit(): void
+    void SceneBuilder::commit(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const v8::Local<v8::Object> self = info.This();
+        if (!TypeConvert::is_object(self, NativeClassType::SceneBuilder))
+        {
+            jsb_throw(isolate, "bad this");
+            return;
+        }
+        SceneBuilder* builder = (SceneBuilder*) self->GetAlignedPointerFromInternalField(IF_Pointer);
+        if (builder->buffer_->is_empty())
+        {
+            jsb_throw(isolate, "nothing to commit");
+            return;
+        }
+
+        NativeObjectID handle;
+        void* token_ptr = nullptr;
+        if (!Worker::try_get_current_worker(handle, token_ptr))
+        {
+            jsb_throw(isolate, "SceneBuilder can only commit in worker");
+            return;
+        }
+        const std::shared_ptr<Environment> master = Environment::_access(token_ptr);
+        if (!master)
+        {
+            jsb_throw(isolate, "invalid environment");
+            return;
+        }
+
+        // the builder is reusable for the next scene
+        master->post_scene_build(handle, std::move(builder->buffer_));
+        builder->buffer_ = std::make_shared<SceneCommandBuffer>();
+    }
+}
+#endif
@@ -0,0 +1,89 @@
+#ifndef GODOTJS_SCENE_BUILDER_H
+#define GODOTJS_SCENE_BUILDER_H
+#include "jsb_bridge_pch.h"
+
+#if !JSB_WITH_WEB && !JSB_WITH_JAVASCRIPTCORE
+namespace jsb
+{
+    enum class FinalizationType : uint8_t;
+    class Environment;
+
+    struct SceneCommand
+    {
+        enum Type : uint8_t
+        {
+            TYPE_CREATE,
+            TYPE_SET,
+        };
+
+        Type type;
+
+        // handle of the node (index in the created nodes)
+        uint32_t node;
+
+        // handle of the parent node (TYPE_CREATE only)
+        uint32_t parent;
+
+        // class name (TYPE_CREATE) or property name (TYPE_SET)
+        StringName name;
+
+        // property value (TYPE_SET only)
+        Variant value;
+    };
+
+    // commands to construct a detached scene, they're recorded in a worker (without touching any engine object),
+    // and replayed in the master environment (main thread) slice by slice.
+    class SceneCommandBuffer
+    {
+    public:
+        static constexpr uint32_t kNoParent = UINT32_MAX;
+
+        // free all created nodes if the root is not taken
+        ~SceneCommandBuffer();
+
+        jsb_force_inline bool is_empty() const { return commands_.is_empty(); }
+        jsb_force_inline bool is_valid_node(uint32_t p_node) const { return p_node < num_nodes_; }
+
+        // [worker] the first node is the root, a node without parent is added to the root.
+        // return the handle of the new node.
+        uint32_t create(const StringName& p_class_name, uint32_t p_parent);
+
+        // [worker]
+        void set(uint32_t p_node, const StringName& p_name, const Variant& p_value);
+
+        // [main thread] replay commands until all done or the deadline is reached (at least one command is replayed).
+        // return true if finished.
+        bool replay(uint64_t p_deadline_usec);
+
+        // [main thread] take the ownership of the root node (after replay finished)
+        Node* take_root();
+
+    private:
+        LocalVector<SceneCommand> commands_;
+        uint32_t num_nodes_ = 0;
+
+        // replay state
+        uint32_t cursor_ = 0;
+        LocalVector<Node*> nodes_;
+    };
+
+    // [js] `SceneBuilder` in "godot.worker", record a scene in a worker and commit it to the master.
+    // `JSWorker.onbuild(root)` is called in the master when all commands are replayed.
+    class SceneBuilder
+    {
+    public:
+        static void register_(Environment* p_env, const v8::Local<v8::Context>& p_context, const v8::Local<v8::Object>& p_exports);
+
+    private:
+        static void constructor(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void finalizer(Environment*, void* pointer, FinalizationType /* p_finalize */);
+        static void create(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void set(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void commit(const v8::FunctionCallbackInfo<v8::Value>& info);
+
+        std::shared_ptr<SceneCommandBuffer> buffer_;
+    };
+}
+#endif
+
+#endif
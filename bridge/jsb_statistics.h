@@ -11,6 +11,9 @@ namespace jsb
         // num of traced objects
         int objects;
 
+        // memory used by the object bindings (in bytes)
+        uint64_t objects_memory;
+
         // num of registered native classes
         int native_classes;
 
@@ -23,6 +26,13 @@ namespace jsb
         // allocated num of Variants in pool (only valid in debug mode)
         uint32_t allocated_variants;
 
+        // num of valuetype wrappers allocated/reused in the last frame
+        uint32_t valuetypes_created;
+        uint32_t valuetypes_recycled;
+
+        // num of free valuetype wrappers in pool (only available in quickjs.impl)
+        uint32_t pooled_valuetypes;
+
         // impl-specific fields
         Vector<impl::CustomField> custom_fields;
 
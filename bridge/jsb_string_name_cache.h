@@ -22,7 +22,7 @@ namespace jsb
         internal::TypeGen<TWeakRef<v8::String>, StringNameID>::UnorderedMap value_index_; // backlink
 
         // List< StringName+JSValue >
-        internal::SArray<Slot, StringNameID> values_;
+        internal::SArray<Slot, StringNameID, internal::ChunkedAllocator<256>> values_;
 
     public:
         void clear()
@@ -0,0 +1,318 @@
+#include "jsb_text_codec.h"
+#include "jsb_environment.h"
+#include "jsb_type_convert.h"
+
+#if JSB_WITH_ESSENTIALS
+namespace jsb
+{
+    namespace
+    {
+        // placeholder of the native object bound to a TextEncoder (it's stateless)
+        struct EncoderState {};
+
+        constexpr uint8_t kReplacementCharacter[] = { 0xEF, 0xBF, 0xBD };
+        constexpr uint8_t kBOM[] = { 0xEF, 0xBB, 0xBF };
+
+        // get the memory of an ArrayBuffer or ArrayBufferView (TypedArray/DataView)
+        bool get_bytes(Environment* p_env, const v8::Local<v8::Context>& p_context, const v8::Local<v8::Value>& p_val, uint8_t*& r_data, size_t& r_len)
+        {
+            if (p_val->IsArrayBuffer())
+            {
+                const v8::Local<v8::ArrayBuffer> buffer = p_val.As<v8::ArrayBuffer>();
+                r_data = (uint8_t*) buffer->Data();
+                r_len = buffer->ByteLength();
+                return true;
+            }
+            if (!p_val->IsObject()) return false;
+
+            const v8::Local<v8::Object> view = p_val.As<v8::Object>();
+            v8::Local<v8::Value> buffer, offset, length;
+            if (!view->Get(p_context, jsb_name(p_env, buffer)).ToLocal(&buffer) || !buffer->IsArrayBuffer()
+                || !view->Get(p_context, jsb_name(p_env, byteOffset)).ToLocal(&offset) || !offset->IsNumber()
+                || !view->Get(p_context, jsb_name(p_env, byteLength)).ToLocal(&length) || !length->IsNumber())
+            {
+                return false;
+            }
+            const v8::Local<v8::ArrayBuffer> array_buffer = buffer.As<v8::ArrayBuffer>();
+            const size_t byte_offset = (size_t) offset.As<v8::Number>()->Value();
+            const size_t byte_length = (size_t) length.As<v8::Number>()->Value();
+            if (byte_offset + byte_length > array_buffer->ByteLength()) return false;
+            r_data = (uint8_t*) array_buffer->Data() + byte_offset;
+            r_len = byte_length;
+            return true;
+        }
+
+        bool get_option(Environment* p_env, const v8::Local<v8::Context>& p_context, const v8::Local<v8::Value>& p_options, const v8::Local<v8::String>& p_name)
+        {
+            if (!p_options->IsObject()) return false;
+            v8::Local<v8::Value> value;
+            return p_options.As<v8::Object>()->Get(p_context, p_name).ToLocal(&value) && value->BooleanValue(p_context->GetIsolate());
+        }
+
+        v8::MaybeLocal<v8::Value> new_uint8_array(Environment* p_env, const v8::Local<v8::Context>& p_context, const v8::Local<v8::ArrayBuffer>& p_buffer)
+        {
+            v8::Local<v8::Value> constructor;
+            if (!p_context->Global()->Get(p_context, jsb_name(p_env, Uint8Array)).ToLocal(&constructor) || !constructor->IsObject())
+            {
+                return {};
+            }
+            v8::Local<v8::Value> argv[] = { p_buffer };
+            return constructor.As<v8::Object>()->CallAsConstructor(p_context, std::size(argv), argv);
+        }
+
+        bool is_utf8_label(const String& p_label)
+        {
+            const String label = p_label.strip_edges().to_lower();
+            return label == "utf-8" || label == "utf8" || label == "unicode-1-1-utf-8";
+        }
+    }
+
+    void TextCodec::register_(const v8::Local<v8::Context>& p_context, const v8::Local<v8::Object>& p_self)
+    {
+        v8::Isolate* isolate = p_context->GetIsolate();
+        Environment* env = Environment::wrap(p_context);
+
+        {
+            const StringName class_name = jsb_string_name(TextEncoder);
+            const NativeClassID class_id = env->add_native_class(NativeClassType::TextEncoder, class_name);
+            impl::ClassBuilder class_builder = impl::ClassBuilder::New<IF_ObjectFieldCount>(isolate, class_name, &encoder_constructor, *class_id);
+
+            class_builder.Instance().Method("encode", &encode);
+            class_builder.Instance().Method("encodeInto", &encode_into);
+            class_builder.Instance().Property("encoding", &_encoding, (int32_t) 0);
+
+            const NativeClassInfoPtr class_info = env->get_native_class(class_id);
+            class_info->finalizer = &encoder_finalizer;
+            class_info->clazz = class_builder.Build();
+            jsb_check(!class_info->clazz.IsEmpty());
+            p_self->Set(p_context, jsb_name(env, TextEncoder), class_info->clazz.Get(isolate)).Check();
+        }
+
+        {
+            const StringName class_name = jsb_string_name(TextDecoder);
+            const NativeClassID class_id = env->add_native_class(NativeClassType::TextDecoder, class_name);
+            impl::ClassBuilder class_builder = impl::ClassBuilder::New<IF_ObjectFieldCount>(isolate, class_name, &decoder_constructor, *class_id);
+
+            class_builder.Instance().Method("decode", &decode);
+            class_builder.Instance().Property("encoding", &_encoding, (int32_t) 0);
+            class_builder.Instance().Property("fatal", &decoder_fatal, (int32_t) 0);
+            class_builder.Instance().Property("ignoreBOM", &decoder_ignore_bom, (int32_t) 0);
+
+            const NativeClassInfoPtr class_info = env->get_native_class(class_id);
+            class_info->finalizer = &decoder_finalizer;
+            class_info->clazz = class_builder.Build();
+            jsb_check(!class_info->clazz.IsEmpty());
+            p_self->Set(p_context, jsb_name(env, TextDecoder), class_info->clazz.Get(isolate)).Check();
+        }
+    }
+
+    void TextCodec::_encoding(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        info.GetReturnValue().Set(impl::Helper::new_string_ascii(info.GetIsolate(), "utf-8"));
+    }
+
+    void TextCodec::encoder_constructor(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const internal::Index32 class_id(info.Data().As<v8::Uint32>()->Value());
+        EncoderState* ptr = memnew(EncoderState);
+        const NativeObjectID handle = Environment::wrap(isolate)->bind_pointer(class_id, NativeClassType::TextEncoder, ptr, info.This(), 0);
+        jsb_check(handle);
+        jsb_unused(handle);
+    }
+
+    void TextCodec::encoder_finalizer(Environment*, void* pointer, FinalizationType /* p_finalize */)
+    {
+        memdelete((EncoderState*) pointer);
+    }
+
+    // [js] encode(input?: string): Uint8Array
+    void TextCodec::encode(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        Environment* env = Environment::wrap(isolate);
+
+        v8::Local<v8::String> input;
+        if (info[0]->IsString()) input = info[0].As<v8::String>();
+        else if (info[0]->IsUndefined()) input = v8::String::Empty(isolate);
+        else if (!info[0]->ToString(context).ToLocal(&input)) return;
+
+        const v8::Local<v8::ArrayBuffer> buffer = impl::Helper::to_utf8_array_buffer(isolate, input);
+        v8::Local<v8::Value> rval;
+        if (new_uint8_array(env, context, buffer).ToLocal(&rval))
+        {
+            info.GetReturnValue().Set(rval);
+        }
+    }
+
+    // [js] encodeInto(source: string, destination: Uint8Array): { read: number, written: number }
+    void TextCodec::encode_into(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        Environment* env = Environment::wrap(isolate);
+
+        uint8_t* data;
+        size_t len;
+        if (!info[0]->IsString() || !get_bytes(env, context, info[1], data, len))
+        {
+            jsb_throw(isolate, "bad argument");
+            return;
+        }
+
+        size_t read = 0;
+        const size_t written = len != 0 ? impl::Helper::write_utf8(isolate, info[0].As<v8::String>(), data, len, read) : 0;
+        const v8::Local<v8::Object> result = v8::Object::New(isolate);
+        result->Set(context, jsb_name(env, read), v8::Number::New(isolate, (double) read)).Check();
+        result->Set(context, jsb_name(env, written), v8::Number::New(isolate, (double) written)).Check();
+        info.GetReturnValue().Set(result);
+    }
+
+    // [js] constructor(label?: string, options?: { fatal?: boolean, ignoreBOM?: boolean })
+    void TextCodec::decoder_constructor(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        Environment* env = Environment::wrap(isolate);
+        const internal::Index32 class_id(info.Data().As<v8::Uint32>()->Value());
+
+        if (!info[0]->IsUndefined() && !is_utf8_label(impl::Helper::to_string(isolate, info[0])))
+        {
+            jsb_throw(isolate, "unsupported encoding");
+            return;
+        }
+
+        DecoderState* ptr = memnew(DecoderState);
+        ptr->fatal = get_option(env, context, info[1], jsb_name(env, fatal));
+        ptr->ignore_bom = get_option(env, context, info[1], jsb_name(env, ignoreBOM));
+        const NativeObjectID handle = env->bind_pointer(class_id, NativeClassType::TextDecoder, ptr, info.This(), 0);
+        jsb_check(handle);
+        jsb_unused(handle);
+    }
+
+    void TextCodec::decoder_finalizer(Environment*, void* pointer, FinalizationType /* p_finalize */)
+    {
+        memdelete((DecoderState*) pointer);
+    }
+
+    void TextCodec::decoder_fatal(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        const v8::Local<v8::Object> self = info.This();
+        if (!TypeConvert::is_object(self, NativeClassType::TextDecoder)) return;
+        const DecoderState* state = (DecoderState*) self->GetAlignedPointerFromInternalField(IF_Pointer);
+        info.GetReturnValue().Set(v8::Boolean::New(info.GetIsolate(), state->fatal));
+    }
+
+    void TextCodec::decoder_ignore_bom(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        const v8::Local<v8::Object> self = info.This();
+        if (!TypeConvert::is_object(self, NativeClassType::TextDecoder)) return;
+        const DecoderState* state = (DecoderState*) self->GetAlignedPointerFromInternalField(IF_Pointer);
+        info.GetReturnValue().Set(v8::Boolean::New(info.GetIsolate(), state->ignore_bom));
+    }
+
+    // [js] decode(input?: ArrayBuffer | ArrayBufferView, options?: { stream?: boolean }): string
+    void TextCodec::decode(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        Environment* env = Environment::wrap(isolate);
+        const v8::Local<v8::Object> self = info.This();
+        if (!TypeConvert::is_object(self, NativeClassType::TextDecoder))
+        {
+            jsb_throw(isolate, "bad this");
+            return;
+        }
+        DecoderState* state = (DecoderState*) self->GetAlignedPointerFromInternalField(IF_Pointer);
+
+        uint8_t* input = nullptr;
+        size_t input_len = 0;
+        if (!info[0]->IsUndefined() && !get_bytes(env, context, info[0], input, input_len))
+        {
+            jsb_throw(isolate, "bad argument");
+            return;
+        }
+        const bool stream = get_option(env, context, info[1], jsb_name(env, stream));
+
+        // prepend the pending bytes of the previous call (rarely happens, so just concatenate them)
+        LocalVector<uint8_t> joined;
+        const uint8_t* data = input;
+        size_t len = input_len;
+        if (state->pending_len != 0)
+        {
+            joined.resize(state->pending_len + input_len);
+            memcpy(joined.ptr(), state->pending, state->pending_len);
+            if (input_len != 0) memcpy(joined.ptr() + state->pending_len, input, input_len);
+            data = joined.ptr();
+            len = joined.size();
+            state->pending_len = 0;
+        }
+
+        // the BOM is only checked at the beginning of a stream (or a standalone call)
+        const size_t total_len = len;
+        const auto update_bom_state = [&]() { state->bom_seen = stream && (state->bom_seen || total_len > state->pending_len); };
+        if (!state->ignore_bom && !state->bom_seen && len >= std::size(kBOM) && memcmp(data, kBOM, std::size(kBOM)) == 0)
+        {
+            data += std::size(kBOM);
+            len -= std::size(kBOM);
+        }
+
+        // fast path: the whole input is well-formed (or ends with an incomplete sequence in streaming mode)
+        size_t pos = internal::UTF8::valid_prefix(data, len);
+        int seq_len;
+        const bool complete = pos == len;
+        if (complete || (stream && internal::UTF8::next(data + pos, len - pos, seq_len) == internal::UTF8::Incomplete && pos + seq_len == len))
+        {
+            if (!complete)
+            {
+                state->pending_len = (uint8_t) (len - pos);
+                memcpy(state->pending, data + pos, len - pos);
+            }
+            update_bom_state();
+            info.GetReturnValue().Set(pos == 0
+                ? v8::String::Empty(isolate)
+                : impl::Helper::new_string_utf8(isolate, (const char*) data, pos));
+            return;
+        }
+
+        if (state->fatal)
+        {
+            state->bom_seen = false;
+            jsb_throw(isolate, "the encoded data was not valid utf-8");
+            return;
+        }
+
+        // slow path: replace the maximal subpart of each ill-formed sequence with U+FFFD
+        LocalVector<uint8_t> output;
+        output.resize(len + std::size(kReplacementCharacter));
+        size_t output_len = 0;
+        const auto append = [&](const uint8_t* p_bytes, size_t p_len)
+        {
+            if (output_len + p_len > output.size()) output.resize(MAX(output.size() * 2, output_len + p_len));
+            memcpy(output.ptr() + output_len, p_bytes, p_len);
+            output_len += p_len;
+        };
+        append(data, pos);
+        while (pos < len)
+        {
+            const size_t valid_len = internal::UTF8::valid_prefix(data + pos, len - pos);
+            append(data + pos, valid_len);
+            pos += valid_len;
+            if (pos == len) break;
+
+            const internal::UTF8::Sequence sequence = internal::UTF8::next(data + pos, len - pos, seq_len);
+            if (sequence == internal::UTF8::Incomplete && stream)
+            {
+                state->pending_len = (uint8_t) (len - pos);
+                memcpy(state->pending, data + pos, len - pos);
+                break;
+            }
+            append(kReplacementCharacter, std::size(kReplacementCharacter));
+            pos += seq_len;
+        }
+        update_bom_state();
+        info.GetReturnValue().Set(impl::Helper::new_string_utf8(isolate, (const char*) output.ptr(), output_len));
+    }
+}
+#endif
@@ -0,0 +1,47 @@
+#ifndef GODOTJS_TEXT_CODEC_H
+#define GODOTJS_TEXT_CODEC_H
+#include "jsb_bridge_pch.h"
+
+#if JSB_WITH_ESSENTIALS
+namespace jsb
+{
+    enum class FinalizationType : uint8_t;
+    class Environment;
+
+    // native implementation of `TextEncoder` and `TextDecoder` (UTF-8 only).
+    // both of them read/write the backing store of ArrayBuffer directly without intermediate copies.
+    class TextCodec
+    {
+    public:
+        static void register_(const v8::Local<v8::Context>& p_context, const v8::Local<v8::Object>& p_self);
+
+    private:
+        struct DecoderState
+        {
+            bool fatal = false;
+            bool ignore_bom = false;
+            // the BOM is only checked at the beginning of a stream
+            bool bom_seen = false;
+
+            // trailing bytes of an incomplete sequence left by the previous `decode(..., { stream: true })`
+            uint8_t pending_len = 0;
+            uint8_t pending[4] = {};
+        };
+
+        static void encoder_constructor(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void encoder_finalizer(Environment*, void* pointer, FinalizationType /* p_finalize */);
+        static void encode(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void encode_into(const v8::FunctionCallbackInfo<v8::Value>& info);
+
+        static void decoder_constructor(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void decoder_finalizer(Environment*, void* pointer, FinalizationType /* p_finalize */);
+        static void decode(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void decoder_fatal(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void decoder_ignore_bom(const v8::FunctionCallbackInfo<v8::Value>& info);
+
+        static void _encoding(const v8::FunctionCallbackInfo<v8::Value>& info);
+    };
+}
+#endif
+
+#endif
@@ -305,10 +305,26 @@ namespace jsb
                 if (const NativeClassInfoPtr class_info = env->expose_godot_primitive_class(p_type, &class_id))
                 {
                     jsb_check(class_id && class_info->type == NativeClassType::GodotPrimitive);
-                    r_jval = class_info->clazz.NewInstance(context);
-                    jsb_check(TypeConvert::is_variant(r_jval.As<v8::Object>()));
+                    const bool recyclable = ValuetypePool::is_recyclable_type(p_type);
+                    if (v8::Local<v8::Object> obj; recyclable && env->get_valuetype_pool().try_take(isolate, p_type, p_cvar, obj))
+                    {
+                        r_jval = obj;
+                        return true;
+                    }
+                    const v8::Local<v8::Object> obj = class_info->clazz.NewInstance(context);
+                    jsb_check(TypeConvert::is_variant(obj));
 
-                    env->bind_valuetype(Environment::alloc_variant(p_cvar), r_jval.As<v8::Object>());
+                    if (ValuetypePool& pool = env->get_valuetype_pool(); recyclable && pool.can_track())
+                    {
+                        // allocated in the nursery, promoted at the end of frame if it survives
+                        env->bind_valuetype(pool.alloc_variant(p_cvar), obj);
+                        pool.track(isolate, p_type, obj);
+                    }
+                    else
+                    {
+                        env->bind_valuetype(Environment::alloc_variant(p_cvar), obj);
+                    }
+                    r_jval = obj;
                     return true;
                 }
                 return false;
@@ -332,7 +348,7 @@ namespace jsb
     {
         jsb_check(p_godot_obj);
         Environment* environment = Environment::wrap(isolate);
-        if (environment->try_get_object(p_godot_obj, r_jval))
+        if (environment->try_get_object_cached(p_godot_obj, r_jval))
         {
             return true;
         }
@@ -348,7 +364,10 @@ namespace jsb
             jsb_check(TypeConvert::is_object(r_jval));
 
             // the lifecycle will be managed by javascript runtime, DO NOT DELETE it externally
-            environment->bind_godot_object(class_id, p_godot_obj, r_jval.As<v8::Object>());
+            if (const NativeObjectID object_id = environment->bind_godot_object(class_id, p_godot_obj, r_jval.As<v8::Object>()))
+            {
+                environment->cache_object_identity(p_godot_obj, object_id);
+            }
             return true;
         }
         JSB_LOG(Error, "failed to expose godot class '%s'", class_name);
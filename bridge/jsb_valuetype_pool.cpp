@@ -0,0 +1,149 @@
+#include "jsb_valuetype_pool.h"
+#include "jsb_object_handle.h"
+#include "jsb_environment.h"
+
+namespace jsb
+{
+#if JSB_VALUETYPE_RECYCLING
+    namespace
+    {
+        void* get_prototype_ptr(JSContext* ctx, JSValueConst p_value)
+        {
+            const JSValue proto = JS_GetPrototype(ctx, p_value);
+            void* ptr = JS_VALUE_GET_TAG(proto) == JS_TAG_OBJECT ? JS_VALUE_GET_PTR(proto) : nullptr;
+            JS_FreeValue(ctx, proto);
+            return ptr;
+        }
+
+        // an unreferenced wrapper is reusable only if scripts left no trace on it
+        bool is_reusable(JSContext* ctx, JSValueConst p_value, void* p_prototype)
+        {
+            // still observable by scripts as a WeakMap/WeakSet key (the weak references are not counted in ref_count)
+            if (JS_IsWeakRefTarget(p_value)) return false;
+            if (JS_IsExtensible(ctx, p_value) != 1) return false;
+            if (get_prototype_ptr(ctx, p_value) != p_prototype) return false;
+
+            JSPropertyEnum* tab;
+            uint32_t len;
+            if (JS_GetOwnPropertyNames(ctx, &tab, &len, p_value, JS_GPN_STRING_MASK | JS_GPN_SYMBOL_MASK | JS_GPN_PRIVATE_MASK) < 0)
+            {
+                impl::QuickJS::MarkExceptionAsTrivial(ctx);
+                return false;
+            }
+            for (uint32_t i = 0; i < len; ++i)
+            {
+                JS_FreeAtom(ctx, tab[i].atom);
+            }
+            js_free(ctx, tab);
+            return len == 0;
+        }
+    }
+
+    uint32_t ValuetypePool::get_free_num() const
+    {
+        return free_num_;
+    }
+
+    bool ValuetypePool::try_take(v8::Isolate* p_isolate, Variant::Type p_type, const Variant& p_value, v8::Local<v8::Object>& r_obj)
+    {
+        jsb_check(is_recyclable_type(p_type));
+        LocalVector<JSValue>& free_list = free_[p_type];
+        if (free_list.is_empty() || !can_track()) return false;
+
+        const JSValue value = free_list[free_list.size() - 1];
+        free_list.remove_at(free_list.size() - 1);
+        --free_num_;
+
+        r_obj = v8::Local<v8::Object>(v8::Data(p_isolate, p_isolate->push_copy(value)));
+        *(Variant*) r_obj->GetAlignedPointerFromInternalField(IF_Pointer) = p_value;
+
+        // the reference held by the free-list is moved to the tracked list
+        tracked_.push_back({ value, p_type, get_prototype_ptr(p_isolate->ctx(), value) });
+        ++frame_.recycled;
+        return true;
+    }
+
+    void ValuetypePool::track(v8::Isolate* p_isolate, Variant::Type p_type, const v8::Local<v8::Object>& p_obj)
+    {
+        jsb_check(is_recyclable_type(p_type) && can_track());
+        JSContext* ctx = p_isolate->ctx();
+        const JSValue value = JS_DupValue(ctx, (JSValue) p_obj);
+        tracked_.push_back({ value, p_type, get_prototype_ptr(ctx, value) });
+    }
+
+    void ValuetypePool::promote(v8::Isolate* p_isolate, JSValueConst p_value)
+    {
+        const v8::Local<v8::Object> obj(v8::Data(p_isolate, p_isolate->push_copy(p_value)));
+        Variant* variant = (Variant*) obj->GetAlignedPointerFromInternalField(IF_Pointer);
+        if (!nursery_.owns(variant)) return;
+
+        obj->SetAlignedPointerInInternalField(IF_Pointer, Environment::alloc_variant(*variant));
+        variant->~Variant();
+    }
+
+    void ValuetypePool::release_tracked(v8::Isolate* p_isolate, bool p_recycle)
+    {
+        JSContext* ctx = p_isolate->ctx();
+        {
+            v8::HandleScope handle_scope(p_isolate);
+            for (const TrackedValue& it : tracked_)
+            {
+                if (((JSRefCountHeader*) JS_VALUE_GET_PTR(it.value))->ref_count != 1)
+                {
+                    // still referenced by scripts
+                    promote(p_isolate, it.value);
+                }
+                else if (LocalVector<JSValue>& free_list = free_[it.type];
+                    p_recycle && free_list.size() < JSB_VALUETYPE_POOL_SIZE && is_reusable(ctx, it.value, it.prototype))
+                {
+                    promote(p_isolate, it.value);
+                    free_list.push_back(it.value);
+                    ++free_num_;
+                    continue;
+                }
+                // the wrapper is finalized here if it's not referenced anymore (the Variant dies in the nursery)
+                JS_FreeValue(ctx, it.value);
+            }
+            tracked_.clear();
+        }
+        // all Variants in the nursery are either promoted or destructed
+        nursery_.reset();
+    }
+
+    void ValuetypePool::collect(v8::Isolate* p_isolate)
+    {
+        if (!tracked_.is_empty())
+        {
+            release_tracked(p_isolate, true);
+        }
+        last_frame_ = frame_;
+        frame_ = {};
+    }
+
+    void ValuetypePool::clear(v8::Isolate* p_isolate)
+    {
+        release_tracked(p_isolate, false);
+        JSContext* ctx = p_isolate->ctx();
+        for (LocalVector<JSValue>& free_list : free_)
+        {
+            for (const JSValue& value : free_list)
+            {
+                JS_FreeValue(ctx, value);
+            }
+            free_list.clear();
+        }
+        free_num_ = 0;
+    }
+#else
+    uint32_t ValuetypePool::get_free_num() const
+    {
+        return 0;
+    }
+
+    void ValuetypePool::collect(v8::Isolate* p_isolate)
+    {
+        last_frame_ = frame_;
+        frame_ = {};
+    }
+#endif
+}
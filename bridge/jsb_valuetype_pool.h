@@ -0,0 +1,105 @@
+#ifndef GODOTJS_VALUETYPE_POOL_H
+#define GODOTJS_VALUETYPE_POOL_H
+#include "jsb_bridge_pch.h"
+
+// wrappers are refcounted in quickjs, an unreferenced wrapper can be told apart and reused safely at the end of frame.
+// v8 and jsc collect wrappers by tracing GC, a collected wrapper can't be resurrected, only the statistics are available.
+#define JSB_VALUETYPE_RECYCLING (JSB_WITH_VALUETYPE_RECYCLING && JSB_WITH_QUICKJS && !JSB_PREFER_QUICKJS_NG)
+
+namespace jsb
+{
+    // recycle the JS wrappers of math valuetypes (Vector2 ... Color) returned to scripts.
+    // a wrapper returned by `TypeConvert::gd_var_to_js` is tracked until the end of frame (`Environment::update`),
+    // if it's no longer referenced by scripts (and left untouched), it's put into a free-list of its type instead of being released.
+    // the next conversion of the same type takes a wrapper from the free-list and overwrites the underlying Variant.
+    // the Variants of tracked wrappers are allocated in a nursery page, only the survivors (still referenced or pooled)
+    // are promoted into `VariantAllocator` at the end of frame, the others die in the nursery without being freed one by one.
+    class ValuetypePool
+    {
+    public:
+        struct FrameStats
+        {
+            // num of valuetype wrappers allocated (`Environment::bind_valuetype`)
+            uint32_t created = 0;
+
+            // num of valuetype wrappers reused from the pool
+            uint32_t recycled = 0;
+        };
+
+        static constexpr bool is_recyclable_type(Variant::Type p_type) { return p_type >= Variant::VECTOR2 && p_type <= Variant::COLOR; }
+
+        jsb_force_inline void on_created() { ++frame_.created; }
+
+        // stats of the last completed frame
+        jsb_force_inline const FrameStats& get_last_frame_stats() const { return last_frame_; }
+
+        // num of free wrappers in the pool
+        uint32_t get_free_num() const;
+
+#if JSB_VALUETYPE_RECYCLING
+        ValuetypePool() : nursery_(JSB_VALUETYPE_POOL_TRACK_LIMIT) {}
+        ~ValuetypePool() { jsb_check(tracked_.is_empty() && free_num_ == 0); }
+
+        // return false if no more wrappers could be tracked in this frame
+        jsb_force_inline bool can_track() const { return tracked_.size() < JSB_VALUETYPE_POOL_TRACK_LIMIT; }
+
+        // allocate the Variant of a new wrapper in the nursery, `track()` must be called with the wrapper right after binding.
+        jsb_force_inline Variant* alloc_variant(const Variant& p_value) { jsb_check(can_track()); return nursery_.alloc(p_value); }
+
+        // called by the valuetype deleter, a Variant in the nursery is only destructed (not freed)
+        jsb_force_inline bool owns_variant(const Variant* p_var) const { return nursery_.owns(p_var); }
+
+        // take a free wrapper of `p_type` (if any) and assign `p_value` to it
+        bool try_take(v8::Isolate* p_isolate, Variant::Type p_type, const Variant& p_value, v8::Local<v8::Object>& r_obj);
+
+        // track a new wrapper of `p_type` for recycling at the end of frame (only if `can_track()`)
+        void track(v8::Isolate* p_isolate, Variant::Type p_type, const v8::Local<v8::Object>& p_obj);
+
+        // called at the end of frame, all tracked wrappers are either recycled or released
+        void collect(v8::Isolate* p_isolate);
+
+        // release all wrappers (tracked and free), it must be called before the context disposed
+        void clear(v8::Isolate* p_isolate);
+
+    private:
+        // move the Variant of a wrapper out of the nursery (if it's in)
+        void promote(v8::Isolate* p_isolate, JSValueConst p_value);
+
+        // release all tracked wrappers, the reusable ones are put into the free-lists if `p_recycle`
+        void release_tracked(v8::Isolate* p_isolate, bool p_recycle);
+
+        struct TrackedValue
+        {
+            JSValue value;
+            Variant::Type type;
+
+            // the prototype when tracked, a wrapper with the prototype changed is not reusable
+            void* prototype;
+        };
+
+        // wrappers returned to scripts in this frame (with a reference held)
+        LocalVector<TrackedValue> tracked_;
+
+        // free wrappers indexed by Variant::Type (with a reference held)
+        LocalVector<JSValue> free_[Variant::VARIANT_MAX];
+        uint32_t free_num_ = 0;
+
+        internal::VariantNursery nursery_;
+#else
+        static constexpr bool can_track() { return false; }
+        jsb_force_inline Variant* alloc_variant(const Variant& p_value) { return nullptr; }
+        static constexpr bool owns_variant(const Variant* p_var) { return false; }
+
+        jsb_force_inline bool try_take(v8::Isolate* p_isolate, Variant::Type p_type, const Variant& p_value, v8::Local<v8::Object>& r_obj) { return false; }
+        jsb_force_inline void track(v8::Isolate* p_isolate, Variant::Type p_type, const v8::Local<v8::Object>& p_obj) {}
+        void collect(v8::Isolate* p_isolate);
+        jsb_force_inline void clear(v8::Isolate* p_isolate) {}
+#endif
+
+    private:
+        FrameStats frame_;
+        FrameStats last_frame_;
+    };
+}
+
+#endif
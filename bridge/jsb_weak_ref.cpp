@@ -0,0 +1,143 @@
+#include "jsb_weak_ref.h"
+#include "jsb_environment.h"
+#include "jsb_type_convert.h"
+#include "jsb_bridge_helper.h"
+
+namespace jsb
+{
+    NativeClassID GodotWeakRef::register_(Environment* p_env)
+    {
+        v8::Isolate* isolate = p_env->get_isolate();
+        const StringName class_name = jsb_string_name(GodotWeakRef);
+        const NativeClassID class_id = p_env->add_native_class(NativeClassType::GodotWeakRef, class_name);
+        impl::ClassBuilder class_builder = impl::ClassBuilder::New<IF_ObjectFieldCount>(isolate, class_name, &constructor, *class_id);
+
+        class_builder.Instance().Method("deref", &deref);
+
+        const NativeClassInfoPtr class_info = p_env->get_native_class(class_id);
+        class_info->finalizer = &finalizer;
+        class_info->clazz = class_builder.Build();
+        jsb_check(!class_info->clazz.IsEmpty());
+        return class_id;
+    }
+
+    // [js] constructor(target: Object, callback?: () => void)
+    void GodotWeakRef::constructor(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        const internal::Index32 class_id(info.Data().As<v8::Uint32>()->Value());
+        Environment* env = Environment::wrap(isolate);
+
+        Object* target = nullptr;
+        if (!info[0]->IsObject() || !TypeConvert::js_to_gd_obj(isolate, context, info[0], target) || !target)
+        {
+            jsb_throw(isolate, "bad target");
+            return;
+        }
+        if (!info[1]->IsUndefined() && !info[1]->IsFunction())
+        {
+            jsb_throw(isolate, "bad callback");
+            return;
+        }
+
+        GodotWeakRef* ptr = memnew(GodotWeakRef);
+        ptr->object_id_ = target->get_instance_id();
+        // the target is bound since it's passed from JS
+        ptr->native_object_id_ = env->try_get_object_id(target);
+        jsb_check(ptr->native_object_id_);
+        ptr->self_id_ = env->bind_pointer(class_id, NativeClassType::GodotWeakRef, ptr, info.This(), 0);
+        jsb_check(ptr->self_id_);
+        if (info[1]->IsFunction())
+        {
+            // traced by GC through the weak ref object, unlike a Global which is a root
+            info.This()->Set(context, jsb_symbol(env, WeakRefCallback), info[1]).Check();
+            ptr->has_callback_ = true;
+            env->watch_weak_ref(ptr);
+        }
+    }
+
+    void GodotWeakRef::finalizer(Environment* p_env, void* pointer, FinalizationType /* p_finalize */)
+    {
+        GodotWeakRef* weak_ref = (GodotWeakRef*) pointer;
+        p_env->unwatch_weak_ref(weak_ref);
+        memdelete(weak_ref);
+    }
+
+    void GodotWeakRef::invoke_callback(Environment* p_env, const v8::Local<v8::Context>& p_context)
+    {
+        jsb_check(has_callback_ && watch_state_ == WatchState::None);
+        v8::Isolate* isolate = p_env->get_isolate();
+        has_callback_ = false;
+
+        // the weak ref object is alive while watched (it's unwatched in the finalizer)
+        v8::Local<v8::Object> self;
+        if (!p_env->try_get_object(self_id_, self))
+        {
+            return;
+        }
+        const v8::Local<v8::Symbol> symbol = jsb_symbol(p_env, WeakRefCallback);
+        v8::Local<v8::Value> callback;
+        if (!self->Get(p_context, symbol).ToLocal(&callback) || !callback->IsFunction())
+        {
+            return;
+        }
+        // called only once, release the closure
+        self->Set(p_context, symbol, v8::Undefined(isolate)).Check();
+
+        const impl::TryCatch try_catch(isolate);
+        const v8::MaybeLocal<v8::Value> rval = callback.As<v8::Function>()->Call(p_context, v8::Undefined(isolate), 0, nullptr);
+        jsb_unused(rval);
+        if (try_catch.has_caught())
+        {
+            JSB_LOG(Error, "GodotWeakRef callback error %s", BridgeHelper::get_exception(try_catch));
+        }
+    }
+
+    // [js] deref(): Object | undefined
+    void GodotWeakRef::deref(const v8::FunctionCallbackInfo<v8::Value>& info)
+    {
+        v8::Isolate* isolate = info.GetIsolate();
+        const v8::Local<v8::Object> self = info.This();
+        if (!TypeConvert::is_object(self, NativeClassType::GodotWeakRef))
+        {
+            jsb_throw(isolate, "bad this");
+            return;
+        }
+        GodotWeakRef* weak_ref = (GodotWeakRef*) self->GetAlignedPointerFromInternalField(IF_Pointer);
+        Environment* env = Environment::wrap(isolate);
+
+        // fast path: the binding is still alive
+        if (v8::Local<v8::Object> rval; env->try_get_object(weak_ref->native_object_id_, rval))
+        {
+            info.GetReturnValue().Set(rval);
+            return;
+        }
+
+        Object* target = ::ObjectDB::get_instance(weak_ref->object_id_);
+        if (!target)
+        {
+            return;
+        }
+
+        // the wrapper has been collected (or the object is transferred back), bind it again
+        const v8::Local<v8::Context> context = isolate->GetCurrentContext();
+        v8::Local<v8::Object> rval;
+        if (!TypeConvert::gd_obj_to_js(isolate, context, target, rval))
+        {
+            jsb_throw(isolate, "failed to bind the object");
+            return;
+        }
+        if (weak_ref->has_callback())
+        {
+            env->unwatch_weak_ref(weak_ref);
+            weak_ref->native_object_id_ = env->try_get_object_id(target);
+            env->watch_weak_ref(weak_ref);
+        }
+        else
+        {
+            weak_ref->native_object_id_ = env->try_get_object_id(target);
+        }
+        info.GetReturnValue().Set(rval);
+    }
+}
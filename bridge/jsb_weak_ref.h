@@ -0,0 +1,60 @@
+#ifndef GODOTJS_WEAK_REF_H
+#define GODOTJS_WEAK_REF_H
+#include "jsb_bridge_pch.h"
+
+namespace jsb
+{
+    enum class FinalizationType : uint8_t;
+    class Environment;
+
+    // [js] `GodotWeakRef` in "godot", a reference to a godot object which keeps neither the JS wrapper nor the object (RefCounted) alive.
+    // `deref()` resolves the cached binding by NativeObjectID (no lookup by pointer), the object is rebound if the wrapper has been collected.
+    // the optional callback is called in `Environment::update` after the object is deleted (like `FinalizationRegistry`).
+    // the callback is stored on the JS object of the weak ref (not in a Global), a callback capturing the weak ref itself doesn't leak.
+    class GodotWeakRef
+    {
+    public:
+        // which list of Environment the weak ref is in (if watched), for O(1) removal with the index stored in it
+        enum class WatchState : uint8_t
+        {
+            None,
+            Watching,   // in the watchers of the binding
+            Released,   // the binding is released, waiting for the deletion of the object
+            Parked,     // the object is alive but unbound, checked at a lower rate
+        };
+
+        static NativeClassID register_(Environment* p_env);
+
+        jsb_force_inline ObjectID get_object_id() const { return object_id_; }
+
+        // the binding which is watched for the release (it's stale after the binding released)
+        jsb_force_inline NativeObjectID get_native_object_id() const { return native_object_id_; }
+        jsb_force_inline void set_native_object_id(NativeObjectID p_native_object_id) { native_object_id_ = p_native_object_id; }
+
+        jsb_force_inline bool has_callback() const { return has_callback_; }
+
+        jsb_force_inline WatchState get_watch_state() const { return watch_state_; }
+        jsb_force_inline uint32_t get_watch_index() const { return watch_index_; }
+        jsb_force_inline void set_watch_state(WatchState p_state, uint32_t p_index) { watch_state_ = p_state; watch_index_ = p_index; }
+
+        // call it once the object is deleted, the callback is removed after called
+        void invoke_callback(Environment* p_env, const v8::Local<v8::Context>& p_context);
+
+    private:
+        static void constructor(const v8::FunctionCallbackInfo<v8::Value>& info);
+        static void finalizer(Environment* p_env, void* pointer, FinalizationType /* p_finalize */);
+        static void deref(const v8::FunctionCallbackInfo<v8::Value>& info);
+
+        ObjectID object_id_;
+        NativeObjectID native_object_id_;
+
+        // the binding of the weak ref itself (where the callback is stored)
+        NativeObjectID self_id_;
+        bool has_callback_ = false;
+
+        WatchState watch_state_ = WatchState::None;
+        uint32_t watch_index_ = 0;
+    };
+}
+
+#endif
@@ -2,6 +2,7 @@
 #include "jsb_buffer.h"
 #include "jsb_environment.h"
 #include "jsb_type_convert.h"
+#include "jsb_scene_builder.h"
 #include "../internal/jsb_sarray.h"
 #include "../internal/jsb_thread_util.h"
 #include "../internal/jsb_double_buffered.h"
@@ -379,6 +380,7 @@ namespace jsb
             class_builder.Instance().Method("onerror", &Worker::_placeholder);
             class_builder.Instance().Method("onmessage", &Worker::_placeholder);
             class_builder.Instance().Method("ontransfer", &Worker::_placeholder);
+            class_builder.Instance().Method("onbuild", &Worker::_placeholder);
             class_builder.Instance().Method("terminate", &Worker::terminate);
 
             const NativeClassInfoPtr class_info = p_env->get_native_class(class_id);
@@ -388,6 +390,9 @@ namespace jsb
             jsb_check(class_info->name == class_name);
             jsb_check(!class_info->clazz.IsEmpty());
             exports->Set(context, jsb_name(p_env, JSWorker), class_info->clazz.Get(isolate));
+
+            // only usable in workers
+            SceneBuilder::register_(p_env, context, exports);
             return true;
         }
 
@@ -433,6 +438,21 @@ namespace jsb
         return (bool) o_handle;
     }
 
+    bool Worker::try_get_current_worker(NativeObjectID& o_handle, void*& o_token_ptr)
+    {
+        lock_.lock();
+        const WorkerID* worker_id = workers_.getptr(Thread::get_caller_id());
+        const WorkerID id = worker_id ? *worker_id : WorkerID();
+        lock_.unlock();
+        if (!id)
+        {
+            o_handle = {};
+            o_token_ptr = nullptr;
+            return false;
+        }
+        return try_get_worker(id, o_handle, o_token_ptr);
+    }
+
     void Worker::on_receive(WorkerID p_id, Buffer&& p_buffer)
     {
         lock_.lock();
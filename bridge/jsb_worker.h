@@ -36,6 +36,9 @@ namespace jsb
         static void on_thread_enter();
         static void on_thread_exit();
 
+        // get the worker object (in master) of the worker running in the current thread
+        static bool try_get_current_worker(NativeObjectID& o_handle, void*& o_token_ptr);
+
     private:
         static void finalizer(Environment*, void* pointer, FinalizationType /* p_finalize */);
         static void constructor(const v8::FunctionCallbackInfo<v8::Value>& info);
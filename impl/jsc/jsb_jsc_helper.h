@@ -39,6 +39,53 @@ namespace jsb::impl
             return buffer;
         }
 
+        // create an ArrayBuffer which takes over the memory of `r_packed` (it's cleared).
+        // the memory is shared without copying only if `r_packed` is the only owner of it,
+        // otherwise it's copied here (copy-on-write), other PackedByteArray values are never written through the buffer.
+        // the buffer keeps a reference to the underlying data until it's garbage collected.
+        static v8::Local<v8::ArrayBuffer> to_shared_array_buffer(v8::Isolate* isolate, Vector<uint8_t>& r_packed)
+        {
+            if (r_packed.is_empty()) return v8::ArrayBuffer::New(isolate, 0);
+            Vector<uint8_t>* holder = memnew(Vector<uint8_t>(r_packed));
+            r_packed = Vector<uint8_t>();
+            JSValueRef error = nullptr;
+            const JSObjectRef obj = JSObjectMakeArrayBufferWithBytesNoCopy(isolate->ctx(),
+                (void*) holder->ptrw(), holder->size(),
+                [](void*, void* p_holder) { memdelete((Vector<uint8_t>*) p_holder); }, holder,
+                &error);
+            if (error)
+            {
+                JavaScriptCore::MarkExceptionAsTrivial(isolate->ctx(), error);
+                return to_array_buffer(isolate, *holder);
+            }
+            return v8::Local<v8::ArrayBuffer>(v8::Data(isolate, isolate->push_copy(obj)));
+        }
+
+        // encode the string into a new ArrayBuffer as UTF-8
+        static v8::Local<v8::ArrayBuffer> to_utf8_array_buffer(v8::Isolate* isolate, const v8::Local<v8::String>& p_str)
+        {
+            const CharString str8 = to_string(isolate, p_str).utf8();
+            const v8::Local<v8::ArrayBuffer> buffer = v8::ArrayBuffer::New(isolate, str8.length());
+            memcpy(buffer->Data(), str8.get_data(), str8.length());
+            return buffer;
+        }
+
+        // encode the string as UTF-8 into `p_buffer` without splitting any character.
+        // return the number of bytes written, `r_read` is the number of UTF-16 code units consumed.
+        static size_t write_utf8(v8::Isolate* isolate, const v8::Local<v8::String>& p_str, uint8_t* p_buffer, size_t p_capacity, size_t& r_read)
+        {
+            const CharString str8 = to_string(isolate, p_str).utf8();
+            const size_t written = internal::UTF8::truncate((const uint8_t*) str8.get_data(), str8.length(), p_capacity, r_read);
+            memcpy(p_buffer, str8.get_data(), written);
+            return written;
+        }
+
+        // `p_str` must be well-formed UTF-8
+        static v8::Local<v8::String> new_string_utf8(v8::Isolate* isolate, const char* p_str, size_t p_len)
+        {
+            return new_string(isolate, String::utf8(p_str, (int) p_len));
+        }
+
         static v8::Local<v8::Function> NewFunction(v8::Local<v8::Context> context, const char* name, v8::FunctionCallback callback, v8::Local<v8::Value> data)
         {
             v8::Isolate* isolate = context->isolate_;
@@ -149,6 +149,7 @@ namespace v8
 
         bool IsExecutionTerminating() const { return interrupted_.is_set(); }
         void TerminateExecution() { interrupted_.set(); }
+        void CancelTerminateExecution() { interrupted_.clear(); }
 
         jsb_force_inline JSContextGroupRef rt() const { return rt_; }
         jsb_force_inline JSContextRef ctx() const { return ctx_; }
@@ -38,6 +38,62 @@ namespace jsb::impl
             return buffer;
         }
 
+        // create an ArrayBuffer which takes over the memory of `r_packed` (it's cleared).
+        // the memory is shared without copying only if `r_packed` is the only owner of it,
+        // otherwise it's copied here (copy-on-write), other PackedByteArray values are never written through the buffer.
+        // the buffer keeps a reference to the underlying data until it's garbage collected.
+        static v8::Local<v8::ArrayBuffer> to_shared_array_buffer(v8::Isolate* isolate, Vector<uint8_t>& r_packed)
+        {
+            if (r_packed.is_empty()) return v8::ArrayBuffer::New(isolate, 0);
+            Vector<uint8_t>* holder = memnew(Vector<uint8_t>(r_packed));
+            r_packed = Vector<uint8_t>();
+            const JSValue buffer = JS_NewArrayBuffer(isolate->ctx(), holder->ptrw(), holder->size(),
+                [](JSRuntime*, void* p_holder, void*) { memdelete((Vector<uint8_t>*) p_holder); }, holder, false);
+            return v8::Local<v8::ArrayBuffer>(v8::Data(isolate, isolate->push_steal(buffer)));
+        }
+
+        // encode the string into a new ArrayBuffer as UTF-8 (lone surrogates are replaced with U+FFFD)
+        static v8::Local<v8::ArrayBuffer> to_utf8_array_buffer(v8::Isolate* isolate, const v8::Local<v8::String>& p_str)
+        {
+            size_t len;
+            const char* str = JS_ToCStringLen(isolate->ctx(), &len, (JSValue) p_str);
+            if (!str)
+            {
+                QuickJS::MarkExceptionAsTrivial(isolate->ctx());
+                return v8::ArrayBuffer::New(isolate, 0);
+            }
+            const v8::Local<v8::ArrayBuffer> buffer = v8::ArrayBuffer::New(isolate, len);
+            memcpy(buffer->Data(), str, len);
+            internal::UTF8::replace_surrogates((uint8_t*) buffer->Data(), len);
+            JS_FreeCString(isolate->ctx(), str);
+            return buffer;
+        }
+
+        // encode the string as UTF-8 into `p_buffer` without splitting any character (lone surrogates are replaced with U+FFFD).
+        // return the number of bytes written, `r_read` is the number of UTF-16 code units consumed.
+        static size_t write_utf8(v8::Isolate* isolate, const v8::Local<v8::String>& p_str, uint8_t* p_buffer, size_t p_capacity, size_t& r_read)
+        {
+            size_t len;
+            const char* str = JS_ToCStringLen(isolate->ctx(), &len, (JSValue) p_str);
+            if (!str)
+            {
+                QuickJS::MarkExceptionAsTrivial(isolate->ctx());
+                r_read = 0;
+                return 0;
+            }
+            const size_t written = internal::UTF8::truncate((const uint8_t*) str, len, p_capacity, r_read);
+            memcpy(p_buffer, str, written);
+            internal::UTF8::replace_surrogates(p_buffer, written);
+            JS_FreeCString(isolate->ctx(), str);
+            return written;
+        }
+
+        // `p_str` must be well-formed UTF-8
+        static v8::Local<v8::String> new_string_utf8(v8::Isolate* isolate, const char* p_str, size_t p_len)
+        {
+            return v8::Local<v8::String>(v8::Data(isolate, isolate->push_steal(JS_NewStringLen(isolate->ctx(), p_str, p_len))));
+        }
+
         static v8::Local<v8::Function> NewFunction(v8::Local<v8::Context> context, const char* name, v8::FunctionCallback callback, v8::Local<v8::Value> data)
         {
             // const v8::Local<v8::Function> func = v8::Function::New(context, callback, data).ToLocalChecked();
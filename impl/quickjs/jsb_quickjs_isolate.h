@@ -34,8 +34,11 @@ namespace jsb::impl
     #error "quickjs.impl does not support on the current arch"
 #endif
 
-    typedef internal::SArray<InternalData, InternalDataID>::Pointer InternalDataPtr;
-    typedef internal::SArray<InternalData, InternalDataID>::ConstPointer InternalDataConstPtr;
+    // pointers returned by get_internal_data() stay valid even if new data is added in the scope (no address lock needed)
+    typedef internal::ChunkedAllocator<1024> InternalDataAllocator;
+
+    typedef internal::SArray<InternalData, InternalDataID, InternalDataAllocator>::Pointer InternalDataPtr;
+    typedef internal::SArray<InternalData, InternalDataID, InternalDataAllocator>::ConstPointer InternalDataConstPtr;
 
     struct ConstructorData
     {
@@ -149,6 +152,7 @@ namespace v8
         void set_as_interruptible() { JS_SetInterruptHandler(rt_, _interrupt_callback, this); }
         bool IsExecutionTerminating() const { return interrupted_.is_set(); }
         void TerminateExecution() { interrupted_.set(); }
+        void CancelTerminateExecution() { interrupted_.clear(); }
 
         jsb_force_inline JSRuntime* rt() const { return rt_; }
         jsb_force_inline JSContext* ctx() const { return ctx_; }
@@ -394,7 +398,7 @@ namespace v8
 
         PromiseRejectCallback promise_reject_;
 
-        jsb::internal::SArray<jsb::impl::InternalData, jsb::impl::InternalDataID> internal_data_;
+        jsb::internal::SArray<jsb::impl::InternalData, jsb::impl::InternalDataID, jsb::impl::InternalDataAllocator> internal_data_;
         Vector<jsb::impl::ConstructorData> constructor_data_;
         HashMap<void*, jsb::impl::Phantom> phantom_;
 
@@ -40,6 +40,48 @@ namespace jsb::impl
             return buffer;
         }
 
+        // create an ArrayBuffer which takes over the memory of `r_packed` (it's cleared).
+        // the memory is shared without copying only if `r_packed` is the only owner of it,
+        // otherwise it's copied here (copy-on-write), other PackedByteArray values are never written through the buffer.
+        // the buffer keeps a reference to the underlying data until it's garbage collected.
+        static v8::Local<v8::ArrayBuffer> to_shared_array_buffer(v8::Isolate* isolate, Vector<uint8_t>& r_packed)
+        {
+            if (r_packed.is_empty()) return v8::ArrayBuffer::New(isolate, 0);
+            Vector<uint8_t>* holder = memnew(Vector<uint8_t>(r_packed));
+            r_packed = Vector<uint8_t>();
+            return v8::ArrayBuffer::New(isolate, v8::ArrayBuffer::NewBackingStore((void*) holder->ptrw(), holder->size(),
+                // the reference count of Vector is thread-safe, it's OK to be released by the deleter in any thread
+                [](void*, size_t, void* p_holder) { memdelete((Vector<uint8_t>*) p_holder); }, holder));
+        }
+
+        // encode the string into a new ArrayBuffer as UTF-8 (lone surrogates are replaced with U+FFFD)
+        static v8::Local<v8::ArrayBuffer> to_utf8_array_buffer(v8::Isolate* isolate, const v8::Local<v8::String>& p_str)
+        {
+            const int len = p_str->Utf8Length(isolate);
+            const v8::Local<v8::ArrayBuffer> buffer = v8::ArrayBuffer::New(isolate, len);
+            if (len != 0)
+            {
+                p_str->WriteUtf8(isolate, (char*) buffer->Data(), len, nullptr, v8::String::NO_NULL_TERMINATION | v8::String::REPLACE_INVALID_UTF8);
+            }
+            return buffer;
+        }
+
+        // encode the string as UTF-8 into `p_buffer` without splitting any character.
+        // return the number of bytes written, `r_read` is the number of UTF-16 code units consumed.
+        static size_t write_utf8(v8::Isolate* isolate, const v8::Local<v8::String>& p_str, uint8_t* p_buffer, size_t p_capacity, size_t& r_read)
+        {
+            int read = 0;
+            const int written = p_str->WriteUtf8(isolate, (char*) p_buffer, (int) p_capacity, &read, v8::String::NO_NULL_TERMINATION | v8::String::REPLACE_INVALID_UTF8);
+            r_read = (size_t) read;
+            return (size_t) written;
+        }
+
+        // `p_str` must be well-formed UTF-8
+        static v8::Local<v8::String> new_string_utf8(v8::Isolate* isolate, const char* p_str, size_t p_len)
+        {
+            return v8::String::NewFromUtf8(isolate, p_str, v8::NewStringType::kNormal, (int) p_len).ToLocalChecked();
+        }
+
         static v8::Local<v8::Function> NewFunction(v8::Local<v8::Context> context, const char* name, v8::FunctionCallback callback, v8::Local<v8::Value> data)
         {
             return v8::Function::New(context, callback, data).ToLocalChecked();
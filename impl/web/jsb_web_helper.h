@@ -38,6 +38,14 @@ namespace jsb::impl
             return v8::Local<v8::ArrayBuffer>(v8::Data(isolate, jsbi_NewArrayBuffer(isolate->rt(), packed.ptr(), packed.size())));
         }
 
+        // the memory can not be shared with the host browser, always copy
+        static v8::Local<v8::ArrayBuffer> to_shared_array_buffer(v8::Isolate* isolate, Vector<uint8_t>& r_packed)
+        {
+            const v8::Local<v8::ArrayBuffer> buffer = to_array_buffer(isolate, r_packed);
+            r_packed = Vector<uint8_t>();
+            return buffer;
+        }
+
         static v8::Local<v8::Function> NewFunction(v8::Local<v8::Context> context, const char* name, v8::FunctionCallback callback, v8::Local<v8::Value> data)
         {
             static_assert(sizeof(callback) == sizeof(void*));
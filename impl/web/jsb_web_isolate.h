@@ -34,8 +34,11 @@ namespace jsb::impl
     #error "web.impl does not support on the current arch"
 #endif
 
-    typedef internal::SArray<InternalData, InternalDataID>::Pointer InternalDataPtr;
-    typedef internal::SArray<InternalData, InternalDataID>::ConstPointer InternalDataConstPtr;
+    // pointers returned by get_internal_data() stay valid even if new data is added in the scope (no address lock needed)
+    typedef internal::ChunkedAllocator<1024> InternalDataAllocator;
+
+    typedef internal::SArray<InternalData, InternalDataID, InternalDataAllocator>::Pointer InternalDataPtr;
+    typedef internal::SArray<InternalData, InternalDataID, InternalDataAllocator>::ConstPointer InternalDataConstPtr;
 
     class Helper;
     class Broker;
@@ -139,7 +142,7 @@ namespace v8
             jsbi_ThrowError(rt_, str8.get_data());
         }
 
-        jsb::internal::SArray<jsb::impl::InternalData, jsb::impl::InternalDataID> internal_data_;
+        jsb::internal::SArray<jsb::impl::InternalData, jsb::impl::InternalDataID, jsb::impl::InternalDataAllocator> internal_data_;
 
     private:
         Isolate();
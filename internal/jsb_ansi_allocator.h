@@ -10,6 +10,9 @@ namespace jsb::internal
     {
         enum { kInitialElementNum = 8 };
 
+        // the whole block is reallocated on growing
+        static constexpr bool kStableAddress = false;
+
         struct AnyType
         {
         };
@@ -77,6 +80,11 @@ namespace jsb::internal
             {
                 return (T*) AnyTypeAllocator<sizeof(T)>::get_data();
             }
+
+            jsb_force_inline T& at(size_t p_index) const
+            {
+                return get_data()[p_index];
+            }
         };
     };
 }
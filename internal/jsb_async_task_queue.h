@@ -0,0 +1,82 @@
+#ifndef GODOTJS_ASYNC_TASK_QUEUE_H
+#define GODOTJS_ASYNC_TASK_QUEUE_H
+#include "jsb_internal_pch.h"
+#include "jsb_double_buffered.h"
+#include "core/object/worker_thread_pool.h"
+
+namespace jsb::internal
+{
+    // bookkeeping of tasks running in the background threads (WorkerThreadPool), the results are collected by the owner thread with `poll()`.
+    // each task is identified by a token, which must be given back in the `token` field of its result.
+    //NOTE all methods must be called from the owner thread (except `add_result` which is called by tasks in worker threads)
+    template<typename TResult>
+    class AsyncTaskQueue
+    {
+    public:
+        AsyncTaskQueue() = default;
+        ~AsyncTaskQueue() { cancel_all(); }
+
+        AsyncTaskQueue(const AsyncTaskQueue&) = delete;
+        AsyncTaskQueue& operator=(const AsyncTaskQueue&) = delete;
+
+        // run `p_func` with `p_userdata` in a worker thread, it must call `add_result` once with `p_token` before it returns.
+        // the task runs immediately if threading is not enabled.
+        void submit(uint32_t p_token, void (*p_func)(void*), void* p_userdata, const String& p_description)
+        {
+            jsb_check(!pending_.has(p_token));
+#if JSB_THREADING
+            pending_.insert(p_token, WorkerThreadPool::get_singleton()->add_native_task(p_func, p_userdata, false, p_description));
+#else
+            pending_.insert(p_token, WorkerThreadPool::INVALID_TASK_ID);
+            p_func(p_userdata);
+#endif
+        }
+
+        void add_result(TResult&& p_result)
+        {
+            done_.add(std::move(p_result));
+        }
+
+        // return all finished results since the last call (the caller should clear it after handled).
+        std::vector<TResult>& poll()
+        {
+            std::vector<TResult>& results = done_.swap();
+            for (const TResult& result : results)
+            {
+                const WorkerThreadPool::TaskID* task_id = pending_.getptr(result.token);
+                jsb_check(task_id);
+#if JSB_THREADING
+                // the task is already finished (or finishing), it's only for releasing the task in WorkerThreadPool
+                WorkerThreadPool::get_singleton()->wait_for_task_completion(*task_id);
+#endif
+                pending_.erase(result.token);
+            }
+            return results;
+        }
+
+        // wait for all pending tasks and discard the results
+        void cancel_all()
+        {
+#if JSB_THREADING
+            for (const KeyValue<uint32_t, WorkerThreadPool::TaskID>& pair : pending_)
+            {
+                WorkerThreadPool::get_singleton()->wait_for_task_completion(pair.value);
+            }
+#endif
+            pending_.clear();
+            done_.swap().clear();
+            done_.swap().clear();
+        }
+
+        jsb_force_inline bool is_empty() const { return pending_.is_empty(); }
+
+    private:
+        // token => task id (of WorkerThreadPool)
+        HashMap<uint32_t, WorkerThreadPool::TaskID> pending_;
+
+        DoubleBuffered<TResult> done_;
+    };
+
+}
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef GODOTJS_CHUNKED_ALLOCATOR_H
+#define GODOTJS_CHUNKED_ALLOCATOR_H
+
+#include "core/os/memory.h"
+#include "jsb_macros.h"
+
+namespace jsb::internal
+{
+    namespace chunked_allocator_detail
+    {
+        constexpr size_t log2(size_t p_value) { return p_value <= 1 ? 0 : 1 + log2(p_value >> 1); }
+    }
+
+    // elements are allocated in fixed-size pages indexed by a page table,
+    // growing only allocates new pages, the allocated elements never move.
+    //NOTE `PageElementNum` must be a power of 2
+    template <size_t PageElementNum = 1024>
+    struct ChunkedAllocator
+    {
+        static_assert(PageElementNum != 0 && (PageElementNum & (PageElementNum - 1)) == 0, "PageElementNum must be a power of 2");
+
+        enum { kInitialElementNum = PageElementNum };
+
+        static constexpr bool kStableAddress = true;
+
+        template <typename TElementType>
+        struct ForType
+        {
+            static constexpr size_t kPageMask = PageElementNum - 1;
+            static constexpr size_t kPageShift = chunked_allocator_detail::log2(PageElementNum);
+
+            ForType() = default;
+
+            ~ForType()
+            {
+                for (size_t index = 0; index < num_pages; ++index)
+                {
+                    memfree(pages[index]);
+                }
+                if (pages)
+                {
+                    memfree(pages);
+                }
+            }
+
+            ForType(ForType&& other) noexcept
+                : pages(other.pages), num_pages(other.num_pages)
+            {
+                other.pages = nullptr;
+                other.num_pages = 0;
+            }
+
+            ForType& operator=(ForType&& other) noexcept
+            {
+                std::swap(pages, other.pages);
+                std::swap(num_pages, other.num_pages);
+                return *this;
+            }
+
+            ForType(const ForType& other) = delete;
+            ForType& operator=(const ForType& other) = delete;
+
+            // the capacity is rounded up to the page size
+            void resize(size_t p_last_num, size_t p_num)
+            {
+                jsb_unused(p_last_num);
+                const size_t new_num_pages = (p_num + kPageMask) >> kPageShift;
+                if (new_num_pages <= num_pages)
+                {
+                    return;
+                }
+
+                // only the page table is reallocated (it's tiny)
+                pages = (TElementType**) memrealloc(pages, sizeof(TElementType*) * new_num_pages);
+                jsb_check(pages);
+                for (size_t index = num_pages; index < new_num_pages; ++index)
+                {
+                    pages[index] = (TElementType*) memalloc(sizeof(TElementType) * PageElementNum);
+                    jsb_check(pages[index]);
+                    memset((void*) pages[index], 0, sizeof(TElementType) * PageElementNum);
+                }
+                num_pages = new_num_pages;
+            }
+
+            jsb_force_inline TElementType& at(size_t p_index) const
+            {
+                jsb_check((p_index >> kPageShift) < num_pages);
+                return pages[p_index >> kPageShift][p_index & kPageMask];
+            }
+
+            size_t capacity() const { return num_pages * PageElementNum; }
+
+            TElementType** pages = nullptr;
+            size_t num_pages = 0;
+        };
+    };
+}
+
+#endif
@@ -0,0 +1,261 @@
+#include "jsb_class_header_index.h"
+#include "jsb_macros.h"
+#include "jsb_logger.h"
+#include "jsb_path_util.h"
+#include "jsb_settings.h"
+#include "jsb_script_lexer.h"
+
+namespace jsb::internal
+{
+    namespace
+    {
+        constexpr uint32_t kCacheMagic = 0x4842534A; // 'JSBH'
+        constexpr uint32_t kCacheVersion = 2;
+
+        // match `class ClassName extends BaseName` (`class` is already consumed).
+        // `r_token` is the last token read (it's not consumed if not matched).
+        bool match_class_extends(ScriptLexer& p_lexer, ScriptToken& r_token, ScriptToken& r_name, ScriptToken& r_base)
+        {
+            r_token = p_lexer.next();
+            if (!p_lexer.is_identifier(r_token) || p_lexer.is_identifier(r_token, "extends")) return false;
+            r_name = r_token;
+            r_token = p_lexer.next();
+            if (!p_lexer.is_identifier(r_token, "extends")) return false;
+            r_token = p_lexer.next();
+            if (!p_lexer.is_identifier(r_token)) return false;
+            r_base = r_token;
+            r_token = p_lexer.next();
+            return true;
+        }
+    }
+
+    bool ScriptClassScanner::scan_typescript(const uint8_t* p_source, size_t p_len, ScriptClassHeader& r_header)
+    {
+        ScriptLexer lexer(p_source, p_len);
+
+        // `@tool()` is applied if it's in the decorator list right before `export default class`
+        bool is_tool = false;
+        ScriptToken token = lexer.next();
+        while (token.kind != ScriptToken::End)
+        {
+            if (lexer.is_punct(token, '@'))
+            {
+                // decorator: `@name`, `@name.name` and optional arguments
+                token = lexer.next();
+                while (lexer.is_identifier(token))
+                {
+                    if (lexer.is_identifier(token, "tool")) is_tool = true;
+                    token = lexer.next();
+                    if (!lexer.is_punct(token, '.')) break;
+                    token = lexer.next();
+                }
+                if (lexer.is_punct(token, '('))
+                {
+                    lexer.skip_parentheses();
+                    token = lexer.next();
+                }
+                continue;
+            }
+
+            if (lexer.is_identifier(token, "export"))
+            {
+                token = lexer.next();
+                if (!lexer.is_identifier(token, "default")) { is_tool = false; continue; }
+                token = lexer.next();
+                if (!lexer.is_identifier(token, "class")) { is_tool = false; continue; }
+
+                ScriptToken name, base;
+                if (match_class_extends(lexer, token, name, base))
+                {
+                    r_header.class_name = lexer.to_string(name);
+                    r_header.base_type = lexer.to_string(base);
+                    r_header.is_tool = is_tool;
+                    return true;
+                }
+                is_tool = false;
+                continue;
+            }
+
+            is_tool = false;
+            token = lexer.next();
+        }
+        return false;
+    }
+
+    bool ScriptClassScanner::scan_javascript(const uint8_t* p_source, size_t p_len, ScriptClassHeader& r_header)
+    {
+        ScriptLexer lexer(p_source, p_len);
+
+        // all `class A extends B` declarations before `exports.default = A` is found
+        LocalVector<std::pair<ScriptToken, ScriptToken>> classes;
+        ScriptToken default_name;
+
+        ScriptToken token = lexer.next();
+        while (token.kind != ScriptToken::End)
+        {
+            if (lexer.is_identifier(token, "class"))
+            {
+                ScriptToken name, base;
+                if (match_class_extends(lexer, token, name, base))
+                {
+                    classes.push_back({ name, base });
+                }
+                continue;
+            }
+
+            if (lexer.is_identifier(token, "exports") && default_name.kind == ScriptToken::End)
+            {
+                token = lexer.next();
+                if (!lexer.is_punct(token, '.')) continue;
+                token = lexer.next();
+                if (!lexer.is_identifier(token, "default")) continue;
+                token = lexer.next();
+                if (!lexer.is_punct(token, '=')) continue;
+                token = lexer.next();
+
+                // exports.default = class ClassName extends BaseName
+                if (lexer.is_identifier(token, "class"))
+                {
+                    ScriptToken name, base;
+                    if (match_class_extends(lexer, token, name, base))
+                    {
+                        r_header.class_name = lexer.to_string(name);
+                        r_header.base_type = lexer.to_string(base);
+                        return true;
+                    }
+                    continue;
+                }
+
+                // exports.default = ClassName (`exports.default = void 0` is not a declaration)
+                if (lexer.is_identifier(token) && !lexer.is_identifier(token, "void"))
+                {
+                    default_name = token;
+                    token = lexer.next();
+                }
+                continue;
+            }
+
+            token = lexer.next();
+        }
+
+        if (default_name.kind == ScriptToken::End) return false;
+        r_header.class_name = lexer.to_string(default_name);
+        r_header.base_type = String();
+        for (const std::pair<ScriptToken, ScriptToken>& it : classes)
+        {
+            if (lexer.equals(it.first, default_name))
+            {
+                r_header.base_type = lexer.to_string(it.second);
+                break;
+            }
+        }
+        return true;
+    }
+
+    bool ScriptClassHeaderIndex::get(const String& p_path, ScriptClassHeader& r_header)
+    {
+        const Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::READ);
+        if (file.is_null())
+        {
+            return false;
+        }
+        const uint64_t size = file->get_length();
+        const uint64_t modified_time = FileAccess::get_modified_time(p_path);
+
+        load();
+        {
+            MutexLock lock(mutex_);
+            if (const Entry* entry = entries_.getptr(p_path); entry && entry->modified_time == modified_time && entry->size == size)
+            {
+                if (entry->valid) r_header = entry->header;
+                return entry->valid;
+            }
+        }
+
+        // scan without holding the lock
+        Vector<uint8_t> source;
+        source.resize((int64_t) size);
+        if (file->get_buffer(source.ptrw(), size) != size)
+        {
+            return false;
+        }
+
+        Entry entry;
+        entry.modified_time = modified_time;
+        entry.size = size;
+        entry.valid = PathUtil::is_recognized_javascript_extension(p_path)
+            ? ScriptClassScanner::scan_javascript(source.ptr(), source.size(), entry.header)
+            : ScriptClassScanner::scan_typescript(source.ptr(), source.size(), entry.header);
+        JSB_LOG(VeryVerbose, "scanned class header %s: %s", p_path, entry.header.class_name);
+        if (entry.valid) r_header = entry.header;
+
+        MutexLock lock(mutex_);
+        entries_[p_path] = entry;
+        dirty_ = true;
+        return entry.valid;
+    }
+
+    void ScriptClassHeaderIndex::load()
+    {
+        MutexLock lock(mutex_);
+        if (loaded_) return;
+        loaded_ = true;
+
+        const Ref<FileAccess> file = FileAccess::open(Settings::get_class_header_cache_path(), FileAccess::READ);
+        if (file.is_null()) return;
+        if (file->get_32() != kCacheMagic || file->get_32() != kCacheVersion)
+        {
+            JSB_LOG(Verbose, "class header cache is outdated");
+            return;
+        }
+        const uint32_t count = file->get_32();
+        for (uint32_t index = 0; index < count && !file->eof_reached(); ++index)
+        {
+            const String path = file->get_pascal_string();
+            Entry entry;
+            entry.modified_time = file->get_64();
+            entry.size = file->get_64();
+            entry.valid = file->get_8() != 0;
+            entry.header.class_name = file->get_pascal_string();
+            entry.header.base_type = file->get_pascal_string();
+            entry.header.is_tool = file->get_8() != 0;
+            entries_.insert(path, entry);
+        }
+        JSB_LOG(Verbose, "%d class headers loaded from cache", entries_.size());
+    }
+
+    void ScriptClassHeaderIndex::save()
+    {
+        MutexLock lock(mutex_);
+        if (!dirty_) return;
+
+        const Ref<FileAccess> file = FileAccess::open(Settings::get_class_header_cache_path(), FileAccess::WRITE);
+        if (file.is_null())
+        {
+            JSB_LOG(Warning, "failed to write class header cache");
+            return;
+        }
+
+        // entries of deleted files are dropped
+        LocalVector<const KeyValue<String, Entry>*> alive;
+        for (const KeyValue<String, Entry>& pair : entries_)
+        {
+            if (FileAccess::exists(pair.key)) alive.push_back(&pair);
+        }
+
+        file->store_32(kCacheMagic);
+        file->store_32(kCacheVersion);
+        file->store_32(alive.size());
+        for (const KeyValue<String, Entry>* pair : alive)
+        {
+            file->store_pascal_string(pair->key);
+            file->store_64(pair->value.modified_time);
+            file->store_64(pair->value.size);
+            file->store_8(pair->value.valid ? 1 : 0);
+            file->store_pascal_string(pair->value.header.class_name);
+            file->store_pascal_string(pair->value.header.base_type);
+            file->store_8(pair->value.header.is_tool ? 1 : 0);
+        }
+        dirty_ = false;
+    }
+}
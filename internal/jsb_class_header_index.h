@@ -0,0 +1,61 @@
+#ifndef GODOTJS_CLASS_HEADER_INDEX_H
+#define GODOTJS_CLASS_HEADER_INDEX_H
+
+#include "jsb_internal_pch.h"
+
+namespace jsb::internal
+{
+    // the declaration of the default exported class in a script source
+    struct ScriptClassHeader
+    {
+        String class_name;
+        String base_type;
+        bool is_tool = false;
+    };
+
+    // a single-pass scanner (without regex) to extract the class header from script sources.
+    // comments and string literals are skipped, identifiers are compared in place without allocation.
+    //   * .ts files: `export default class ClassName extends BaseClassName` (with optional `@tool()` decorator before it)
+    //   * .js files: `exports.default = class ClassName extends BaseClassName`,
+    //                or `class ClassName extends BaseClassName` + `exports.default = ClassName`
+    class ScriptClassScanner
+    {
+    public:
+        static bool scan_typescript(const uint8_t* p_source, size_t p_len, ScriptClassHeader& r_header);
+        static bool scan_javascript(const uint8_t* p_source, size_t p_len, ScriptClassHeader& r_header);
+    };
+
+    // a persistent index of class headers of script files.
+    // a file is scanned again only if the modified time or size is changed.
+    //NOTE it's thread-safe, since it's accessed by EditorFileSystem scanning in background threads.
+    class ScriptClassHeaderIndex
+    {
+    public:
+        // return false if the file can not be read, or no class is declared in it
+        bool get(const String& p_path, ScriptClassHeader& r_header);
+
+        // load the index from the cache file (it's called on the first access implicitly)
+        void load();
+
+        // write the index into the cache file if any change
+        void save();
+
+    private:
+        struct Entry
+        {
+            uint64_t modified_time = 0;
+            uint64_t size = 0;
+
+            // false if no class declared in the file
+            bool valid = false;
+            ScriptClassHeader header;
+        };
+
+        Mutex mutex_;
+        bool loaded_ = false;
+        bool dirty_ = false;
+        HashMap<String, Entry> entries_;
+    };
+}
+
+#endif
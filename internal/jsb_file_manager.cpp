@@ -1,62 +1,29 @@
-﻿// #include "jsb_file_manager.h"
-//
-// namespace jsb::internal
-// {
-//     FileManager* FileManager::singleton_ = nullptr;
-//
-//     FileManager::FileManager()
-//     {
-//         jsb_check(!singleton_);
-//         singleton_ = this;
-//     }
-//
-//     FileManager::~FileManager()
-//     {
-//         jsb_check(singleton_);
-//         singleton_ = nullptr;
-//     }
-//
-//     FileManager::FileHandle FileManager::load_async(const String &p_path)
-//     {
-//         //TODO
-//         return {};
-//     }
-//
-//     FileManager::FileHandle FileManager::load_sync(const String &p_path)
-//     {
-//         mutex_.lock();
-//         mutex_.unlock();
-//         //TODO
-//         return {};
-//     }
-//
-//     void FileManager::run()
-//     {
-//         mutex_.lock();
-//
-//         mutex_.unlock();
-//     }
-//
-//     void FileManager::retain_file(Index32 p_id)
-//     {
-//
-//     }
-//
-//     void FileManager::release_file(Index32 p_id)
-//     {
-//
-//     }
-//
-//     FileManager::FileHandle::FileHandle()
-//     {
-//     }
-//
-//     FileManager::FileHandle::~FileHandle()
-//     {
-//         // if (FileManager* fm = singleton_)
-//         // {
-//         //     fm->release_file(id_);
-//         // }
-//     }
-//
-// }
+﻿#include "jsb_file_manager.h"
+#include "jsb_macros.h"
+#include "jsb_logger.h"
+
+namespace jsb::internal
+{
+    void FileManager::load_async(const String& p_path, uint32_t p_token)
+    {
+        Task* task = memnew(Task);
+        task->manager = this;
+        task->token = p_token;
+        task->path = p_path;
+        queue_.submit(p_token, &_load_task, task, "jsb.load_file");
+    }
+
+    void FileManager::_load_task(void* p_userdata)
+    {
+        Task* task = (Task*) p_userdata;
+        LoadResult result = { task->token, OK, {} };
+        result.data = FileAccess::get_file_as_bytes(task->path, &result.error);
+        if (result.error != OK)
+        {
+            JSB_LOG(Verbose, "failed to load file %s (%d)", task->path, result.error);
+        }
+        task->manager->queue_.add_result(std::move(result));
+        memdelete(task);
+    }
+
+}
@@ -1,66 +1,58 @@
-﻿// #ifndef GODOTJS_FILE_MANAGER_H
-// #define GODOTJS_FILE_MANAGER_H
-//
-// #include "jsb_sarray.h"
-// #include "jsb_sindex.h"
-//
-// namespace jsb::internal
-// {
-//     class FileCallback
-//     {
-//         virtual ~FileCallback() {}
-//
-//         virtual void finish() = 0;
-//     };
-//
-//     class FileManager
-//     {
-//     private:
-//         struct Buffer
-//         {
-//             String file_path_;
-//
-//             size_t size = 0;
-//             uint8_t* ptr = nullptr;
-//             uint32_t ref_count_ = 0;
-//         };
-//
-//         // SArray<Task> pending_;
-//         // SArray<Task> done_;
-//
-//         BinaryMutex mutex_;
-//         static FileManager* singleton_;
-//
-//     public:
-//         struct FileHandle
-//         {
-//         private:
-//             Index32 id_;
-//             FileHandle();
-//             ~FileHandle();
-//
-//         public:
-//             // bool is_null() const;
-//             // bool is_loaded() const;
-//             // String get_path_absolute() const;
-//             // uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const;
-//         };
-//
-//         static FileManager* get_singleton() { return singleton_; }
-//
-//         FileManager();
-//         ~FileManager();
-//
-//         FileHandle load_async(const String& p_path);
-//         FileHandle load_sync(const String& p_path);
-//
-//         void run();
-//
-//     private:
-//         void retain_file(Index32 p_id);
-//         void release_file(Index32 p_id);
-//     };
-//
-// }
-//
-// #endif
+﻿#ifndef GODOTJS_FILE_MANAGER_H
+#define GODOTJS_FILE_MANAGER_H
+
+#include "jsb_internal_pch.h"
+#include "jsb_async_task_queue.h"
+
+namespace jsb::internal
+{
+    // load files in the background threads (WorkerThreadPool).
+    // the loaded results are collected by the owner thread with `poll()`.
+    //NOTE all methods must be called from the owner thread (except `_load_task` which runs in worker threads)
+    class FileManager
+    {
+    public:
+        struct LoadResult
+        {
+            // the token given by `load_async`
+            uint32_t token;
+            Error error;
+
+            // the file content (refcounted and copy-on-write, it's never copied on the way to the owner thread)
+            Vector<uint8_t> data;
+        };
+
+        FileManager() = default;
+        ~FileManager() = default;
+
+        FileManager(const FileManager&) = delete;
+        FileManager& operator=(const FileManager&) = delete;
+
+        // start loading a file, the result will be available in `poll()` with the same `p_token`.
+        // the file is loaded immediately if threading is not enabled.
+        void load_async(const String& p_path, uint32_t p_token);
+
+        // return all finished results since the last call (the caller should clear it after handled).
+        jsb_force_inline std::vector<LoadResult>& poll() { return queue_.poll(); }
+
+        // wait for all pending tasks and discard the results
+        jsb_force_inline void cancel_all() { queue_.cancel_all(); }
+
+        jsb_force_inline bool is_empty() const { return queue_.is_empty(); }
+
+    private:
+        struct Task
+        {
+            FileManager* manager;
+            uint32_t token;
+            String path;
+        };
+
+        static void _load_task(void* p_userdata);
+
+        AsyncTaskQueue<LoadResult> queue_;
+    };
+
+}
+
+#endif
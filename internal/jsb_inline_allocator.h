@@ -12,6 +12,8 @@ namespace jsb::internal
     {
         enum { kInitialElementNum = ElementNum };
 
+        static constexpr bool kStableAddress = false;
+
         template <size_t MemorySize>
         struct ByteCompat
         {
@@ -58,6 +60,11 @@ namespace jsb::internal
                 return (TElementType*)(void*)compat.data;
             }
 
+            jsb_force_inline TElementType& at(size_t p_index) const
+            {
+                return get_data()[p_index];
+            }
+
             constexpr size_t capacity() const { return num; }
 
             ByteCompat<kByteSize> compat;
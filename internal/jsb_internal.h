@@ -15,6 +15,7 @@
 
 #include "jsb_console_output.h"
 #include "jsb_path_util.h"
+#include "jsb_utf8.h"
 #include "jsb_variant_util.h"
 #include "jsb_settings.h"
 
@@ -0,0 +1,76 @@
+#include "jsb_json_parser.h"
+#include "jsb_macros.h"
+#include "jsb_logger.h"
+#include "core/io/json.h"
+
+namespace jsb::internal
+{
+    void AsyncJSONParser::parse_async(const Vector<uint8_t>& p_utf8, uint32_t p_token)
+    {
+        Task* task = memnew(Task);
+        task->parser = this;
+        task->token = p_token;
+        task->utf8 = p_utf8;
+        _submit(task);
+    }
+
+    void AsyncJSONParser::parse_async(const String& p_text, uint32_t p_token)
+    {
+        Task* task = memnew(Task);
+        task->parser = this;
+        task->token = p_token;
+        task->text = p_text;
+        _submit(task);
+    }
+
+    void AsyncJSONParser::_submit(Task* p_task)
+    {
+        queue_.submit(p_task->token, &_parse_task, p_task, "jsb.parse_json");
+    }
+
+    AsyncJSONParser::ParseResult AsyncJSONParser::parse(const String& p_text, uint32_t p_token)
+    {
+        ParseResult result = { p_token, OK, {}, 0, {} };
+        Ref<JSON> json;
+        json.instantiate();
+        result.error = json->parse(p_text);
+        if (result.error == OK)
+        {
+            result.data = json->get_data();
+        }
+        else
+        {
+            result.error_message = json->get_error_message();
+            result.error_line = json->get_error_line();
+        }
+        return result;
+    }
+
+    void AsyncJSONParser::_parse_task(void* p_userdata)
+    {
+        Task* task = (Task*) p_userdata;
+        if (!task->utf8.is_empty())
+        {
+            const uint8_t* data = task->utf8.ptr();
+            int64_t len = task->utf8.size();
+
+            // skip BOM
+            if (len >= 3 && data[0] == 0xEF && data[1] == 0xBB && data[2] == 0xBF)
+            {
+                data += 3;
+                len -= 3;
+            }
+            task->text.parse_utf8((const char*) data, (int) len);
+            task->utf8.clear();
+        }
+
+        ParseResult result = parse(task->text, task->token);
+        if (result.error != OK)
+        {
+            JSB_LOG(Verbose, "failed to parse JSON (%d: %s)", result.error_line, result.error_message);
+        }
+        task->parser->queue_.add_result(std::move(result));
+        memdelete(task);
+    }
+
+}
@@ -0,0 +1,69 @@
+#ifndef GODOTJS_JSON_PARSER_H
+#define GODOTJS_JSON_PARSER_H
+
+#include "jsb_internal_pch.h"
+#include "jsb_async_task_queue.h"
+
+namespace jsb::internal
+{
+    // parse JSON text in the background threads (WorkerThreadPool).
+    // the text is parsed into a Variant tree (engine-neutral), the owner thread materializes it into JS values after `poll()`.
+    //NOTE all methods must be called from the owner thread (except `_parse_task` which runs in worker threads)
+    class AsyncJSONParser
+    {
+    public:
+        struct ParseResult
+        {
+            // the token given by `parse_async`
+            uint32_t token;
+            Error error;
+
+            // only available if failed
+            String error_message;
+            int error_line;
+
+            Variant data;
+        };
+
+        AsyncJSONParser() = default;
+        ~AsyncJSONParser() = default;
+
+        AsyncJSONParser(const AsyncJSONParser&) = delete;
+        AsyncJSONParser& operator=(const AsyncJSONParser&) = delete;
+
+        // start parsing UTF-8 encoded JSON text, the result will be available in `poll()` with the same `p_token`.
+        // the text is parsed immediately if threading is not enabled.
+        void parse_async(const Vector<uint8_t>& p_utf8, uint32_t p_token);
+        void parse_async(const String& p_text, uint32_t p_token);
+
+        // return all finished results since the last call (the caller should clear it after handled).
+        jsb_force_inline std::vector<ParseResult>& poll() { return queue_.poll(); }
+
+        // wait for all pending tasks and discard the results
+        jsb_force_inline void cancel_all() { queue_.cancel_all(); }
+
+        jsb_force_inline bool is_empty() const { return queue_.is_empty(); }
+
+        // parse synchronously in the current thread
+        static ParseResult parse(const String& p_text, uint32_t p_token);
+
+    private:
+        struct Task
+        {
+            AsyncJSONParser* parser;
+            uint32_t token;
+
+            // either of them
+            Vector<uint8_t> utf8;
+            String text;
+        };
+
+        void _submit(Task* p_task);
+        static void _parse_task(void* p_userdata);
+
+        AsyncTaskQueue<ParseResult> queue_;
+    };
+
+}
+
+#endif
@@ -8,9 +8,7 @@ namespace jsb::internal
     {
         MutexLock lock(mutex);
 
-        const String path = p_path.begins_with("uid://")
-            ? ResourceUID::get_singleton()->get_id_path(ResourceUID::get_singleton()->text_to_id(p_path))
-            : p_path;
+        const String path = normalize_path(p_path);
 
         if (ObjectID* object_id = packed_scenes.getptr(path))
         {
@@ -47,4 +45,111 @@ namespace jsb::internal
         }
     }
 
+    String ResourceCache::normalize_path(const String& p_path)
+    {
+        return p_path.begins_with("uid://")
+            ? ResourceUID::get_singleton()->get_id_path(ResourceUID::get_singleton()->text_to_id(p_path))
+            : p_path;
+    }
+
+    void ResourceCache::load_threaded(const String& p_path, const String& p_type_hint, bool p_use_sub_threads, uint32_t p_token)
+    {
+        jsb_check(!pending_tokens_.has(p_token));
+        const String path = normalize_path(p_path);
+        if (PendingLoad* pending = pending_loads_.getptr(path))
+        {
+            JSB_LOG(Verbose, "share the pending load request %s", path);
+            pending->tokens.push_back(p_token);
+            pending_tokens_.insert(p_token, path);
+            return;
+        }
+
+        // already loaded and still alive, no need to start a load request
+        if (Ref<Resource> resource = ::ResourceCache::get_ref(path); resource.is_valid())
+        {
+            ready_.push_back({ p_token, OK, resource });
+            return;
+        }
+
+        if (path.is_empty())
+        {
+            ready_.push_back({ p_token, ERR_FILE_BAD_PATH, {} });
+            return;
+        }
+        const Error err = ResourceLoader::load_threaded_request(path, p_type_hint, p_use_sub_threads);
+        if (err != OK)
+        {
+            JSB_LOG(Verbose, "failed to request threaded loading %s (%d)", path, err);
+            ready_.push_back({ p_token, err, {} });
+            return;
+        }
+        PendingLoad& pending = pending_loads_[path];
+        pending.tokens.push_back(p_token);
+        pending_tokens_.insert(p_token, path);
+    }
+
+    bool ResourceCache::cancel(uint32_t p_token)
+    {
+        if (const String* path = pending_tokens_.getptr(p_token))
+        {
+            PendingLoad* pending = pending_loads_.getptr(*path);
+            jsb_check(pending);
+            pending->tokens.erase(p_token);
+            pending_tokens_.erase(p_token);
+            return true;
+        }
+        for (auto it = ready_.begin(); it != ready_.end(); ++it)
+        {
+            if (it->token == p_token)
+            {
+                ready_.erase(it);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::vector<ResourceCache::LoadResult>& ResourceCache::poll()
+    {
+        jsb_check(done_.empty());
+        done_.swap(ready_);
+
+        LocalVector<String> finished;
+        for (const KeyValue<String, PendingLoad>& pair : pending_loads_)
+        {
+            const ResourceLoader::ThreadLoadStatus status = ResourceLoader::load_threaded_get_status(pair.key);
+            if (status == ResourceLoader::THREAD_LOAD_IN_PROGRESS) continue;
+
+            // it must be called once for each successful `load_threaded_request` even if the result is not used
+            Error err = OK;
+            const Ref<Resource> resource = ResourceLoader::load_threaded_get(pair.key, &err);
+            if (err == OK && resource.is_null()) err = ERR_CANT_ACQUIRE_RESOURCE;
+            for (const uint32_t token : pair.value.tokens)
+            {
+                done_.push_back({ token, err, resource });
+                pending_tokens_.erase(token);
+            }
+            finished.push_back(pair.key);
+        }
+        for (const String& path : finished)
+        {
+            pending_loads_.erase(path);
+        }
+        return done_;
+    }
+
+    void ResourceCache::cancel_all()
+    {
+        for (const KeyValue<String, PendingLoad>& pair : pending_loads_)
+        {
+            // it blocks until the load request is finished
+            Error err;
+            ResourceLoader::load_threaded_get(pair.key, &err);
+        }
+        pending_loads_.clear();
+        pending_tokens_.clear();
+        ready_.clear();
+        done_.clear();
+    }
+
 }
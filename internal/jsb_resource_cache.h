@@ -3,18 +3,69 @@
 
 #include "jsb_internal_pch.h"
 #include "scene/resources/packed_scene.h"
+#include "core/io/resource_loader.h"
 
 namespace jsb::internal
 {
     class ResourceCache
     {
+    public:
+        struct LoadResult
+        {
+            // the token given by `load_threaded`
+            uint32_t token;
+            Error error;
+            Ref<Resource> resource;
+        };
+
+    private:
         // a map of PackedScene, behaves like a weak ref
         HashMap<String, ObjectID> packed_scenes;
 
         Mutex mutex;
 
+        // a threaded load request (ResourceLoader) shared by all concurrent requests of the same path
+        struct PendingLoad
+        {
+            // tokens of the requests waiting for this resource (may be empty if all of them are cancelled)
+            LocalVector<uint32_t> tokens;
+        };
+
+        // path => pending load (of ResourceLoader threaded loading)
+        HashMap<String, PendingLoad> pending_loads_;
+
+        // token => path
+        HashMap<uint32_t, String> pending_tokens_;
+
+        // requests finished without threaded loading (already cached, or failed to start)
+        std::vector<LoadResult> ready_;
+
+        std::vector<LoadResult> done_;
+
     public:
         Ref<PackedScene> get_packed_scene(const String &p_path, Error &r_error);
+
+        // request a resource to load in background threads (with `ResourceLoader::load_threaded_request`).
+        // concurrent requests of the same path share one underlying load request.
+        // the result will be available in `poll()` with the same `p_token`.
+        //NOTE the threaded loading methods must be called from the owner thread
+        void load_threaded(const String& p_path, const String& p_type_hint, bool p_use_sub_threads, uint32_t p_token);
+
+        // the request is dropped without any result.
+        // the underlying load request keeps running if it's shared by other requests (or can not be stopped).
+        // return false if the request is already finished.
+        bool cancel(uint32_t p_token);
+
+        // return all finished results since the last call (the caller should clear it after handled).
+        std::vector<LoadResult>& poll();
+
+        // wait for all pending loads and discard the results
+        void cancel_all();
+
+        jsb_force_inline bool is_loading() const { return !pending_loads_.is_empty() || !ready_.empty(); }
+
+    private:
+        static String normalize_path(const String& p_path);
     };
 }
 
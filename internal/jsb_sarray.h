@@ -5,6 +5,7 @@
 
 #include "jsb_macros.h"
 #include "jsb_ansi_allocator.h"
+#include "jsb_chunked_allocator.h"
 #include "jsb_sindex.h"
 
 #include <cstddef>
@@ -51,9 +52,12 @@ namespace jsb::internal
         int _address_locked = 0;
         AllocatorType allocator;
 
-        Slot* get_data() const
+        // addresses of elements never change if the allocator grows without moving the allocated elements (e.g. ChunkedAllocator)
+        static constexpr bool kStableAddress = TAllocator::kStableAddress;
+
+        jsb_force_inline Slot& get_slot(int p_index) const
         {
-            return (Slot*)allocator.get_data();
+            return allocator.at(p_index);
         }
 
     public:
@@ -163,7 +167,7 @@ namespace jsb::internal
                     return false;
                 }
 #if JSB_SARRAY_DEBUG
-                return container.get_data()[p_slot_index].has_value();
+                return container.get_slot(p_slot_index).has_value();
 #else
                 return true;
 #endif
@@ -171,12 +175,12 @@ namespace jsb::internal
 
             T& get_slot_value(int p_slot_index)
             {
-                return container.get_data()[p_slot_index].value;
+                return container.get_slot(p_slot_index).value;
             }
 
             const T& get_slot_value(int p_slot_index) const
             {
-                return container.get_data()[p_slot_index].value;
+                return container.get_slot(p_slot_index).value;
             }
 
         private:
@@ -200,7 +204,7 @@ namespace jsb::internal
             {
                 while (_first_index != INDEX_NONE)
                 {
-                    Slot& slot = get_data()[_first_index];
+                    Slot& slot = get_slot(_first_index);
                     const int next = slot.next;
 #if JSB_SARRAY_DEBUG
                     jsb_check(slot.has_value());
@@ -233,11 +237,10 @@ namespace jsb::internal
             {
                 return;
             }
-            Slot* slots_base = get_data();
             while (_first_index != INDEX_NONE)
             {
                 const int index = _first_index;
-                Slot& slot = slots_base[index];
+                Slot& slot = get_slot(index);
 
                 // invalidate the revision before destructor to avoid getting from the same position during destructing
                 IndexType::increase_revision(slot.revision);
@@ -261,27 +264,26 @@ namespace jsb::internal
         {
             int forward = _first_index;
             int backward = _last_index;
-            Slot* slots_base = get_data();
             while (forward != backward)
             {
                 jsb_check(forward >= 0 && backward >= 0);
-                SWAP(slots_base[forward].value, slots_base[backward].value);
-                forward = slots_base[forward].next;
-                backward = slots_base[backward].previous;
+                SWAP(get_slot(forward).value, get_slot(backward).value);
+                forward = get_slot(forward).next;
+                backward = get_slot(backward).previous;
             }
         }
 
         IndexType get_first_index() const
         {
             return _first_index != INDEX_NONE
-                       ? IndexType(_first_index, get_data()[_first_index].revision)
+                       ? IndexType(_first_index, get_slot(_first_index).revision)
                        : IndexType::none();
         }
 
         IndexType get_last_index() const
         {
             return _last_index != INDEX_NONE
-                       ? IndexType(_last_index, get_data()[_last_index].revision)
+                       ? IndexType(_last_index, get_slot(_last_index).revision)
                        : IndexType::none();
         }
 
@@ -293,11 +295,11 @@ namespace jsb::internal
                 return;
             }
 
-            const Slot& slot = get_data()[p_index.get_index()];
+            const Slot& slot = get_slot(p_index.get_index());
             if (slot.next != INDEX_NONE)
             {
-                jsb_check(get_data()[slot.next].previous == p_index.get_index());
-                o_next = IndexType(slot.next, get_data()[slot.next].revision);
+                jsb_check(get_slot(slot.next).previous == p_index.get_index());
+                o_next = IndexType(slot.next, get_slot(slot.next).revision);
             }
             else
             {
@@ -305,8 +307,8 @@ namespace jsb::internal
             }
             if (slot.previous != INDEX_NONE)
             {
-                jsb_check(get_data()[slot.previous].next == p_index.get_index());
-                o_previous = IndexType(slot.previous, get_data()[slot.previous].revision);
+                jsb_check(get_slot(slot.previous).next == p_index.get_index());
+                o_previous = IndexType(slot.previous, get_slot(slot.previous).revision);
             }
             else
             {
@@ -317,11 +319,11 @@ namespace jsb::internal
         IndexType get_next_index(const IndexType& p_index) const
         {
             jsb_check(is_valid_index(p_index));
-            const Slot& slot = get_data()[p_index.get_index()];
+            const Slot& slot = get_slot(p_index.get_index());
             if (slot.next != INDEX_NONE)
             {
-                jsb_check(get_data()[slot.next].previous == p_index.get_index());
-                return IndexType(slot.next, get_data()[slot.next].revision);
+                jsb_check(get_slot(slot.next).previous == p_index.get_index());
+                return IndexType(slot.next, get_slot(slot.next).revision);
             }
             return IndexType::none();
         }
@@ -329,11 +331,11 @@ namespace jsb::internal
         IndexType get_previous_index(const IndexType& p_index) const
         {
             jsb_check(is_valid_index(p_index));
-            const Slot& slot = get_data()[p_index.get_index()];
+            const Slot& slot = get_slot(p_index.get_index());
             if (slot.previous != INDEX_NONE)
             {
-                jsb_check(get_data()[slot.previous].next == p_index.get_index());
-                return IndexType(slot.previous, get_data()[slot.previous].revision);
+                jsb_check(get_slot(slot.previous).next == p_index.get_index());
+                return IndexType(slot.previous, get_slot(slot.previous).revision);
             }
             return IndexType::none();
         }
@@ -341,12 +343,12 @@ namespace jsb::internal
         bool is_valid_index(const IndexType& p_index) const
         {
             const int index = p_index.get_index();
-            if (index < 0 || index >= capacity() || p_index.get_revision() == 0 || get_data()[index].revision != p_index.get_revision())
+            if (index < 0 || index >= capacity() || p_index.get_revision() == 0 || get_slot(index).revision != p_index.get_revision())
             {
                 return false;
             }
 #if JSB_SARRAY_DEBUG
-            jsb_check(get_data()[index].has_value());
+            jsb_check(get_slot(index).has_value());
 #endif
             return true;
         }
@@ -356,7 +358,7 @@ namespace jsb::internal
         {
             grow_if_needed(1);
             const int new_index = _free_index;
-            Slot& slot = get_data()[new_index];
+            Slot& slot = get_slot(new_index);
 
             IndexType::increase_revision(slot.revision);
 
@@ -370,7 +372,7 @@ namespace jsb::internal
             ++_used_size;
             if (_last_index != INDEX_NONE)
             {
-                Slot& last_slot = get_data()[_last_index];
+                Slot& last_slot = get_slot(_last_index);
                 last_slot.next = new_index;
             }
             if (_first_index == INDEX_NONE)
@@ -389,9 +391,9 @@ namespace jsb::internal
             jsb_check(is_valid_index(p_index));
             grow_if_needed(1);
 
-            Slot& pivot_slot = get_data()[p_index.get_index()];
+            Slot& pivot_slot = get_slot(p_index.get_index());
             const int new_index = _free_index;
-            Slot& new_slot = get_data()[new_index];
+            Slot& new_slot = get_slot(new_index);
 
             IndexType::increase_revision(new_slot.revision);
 
@@ -402,11 +404,11 @@ namespace jsb::internal
             new_slot.next = p_index.get_index();
             new_slot.previous = pivot_slot.previous;
             pivot_slot.previous = new_index;
-            jsb_check(get_data() + p_index.get_index() == &pivot_slot);
-            jsb_check(get_data()[p_index.get_index()].previous == pivot_slot.previous && pivot_slot.previous == new_index);
+            jsb_check(&get_slot(p_index.get_index()) == &pivot_slot);
+            jsb_check(get_slot(p_index.get_index()).previous == pivot_slot.previous && pivot_slot.previous == new_index);
             if (new_slot.previous != INDEX_NONE)
             {
-                Slot& previous_slot = get_data()[new_slot.previous];
+                Slot& previous_slot = get_slot(new_slot.previous);
                 previous_slot.next = new_index;
             }
             ++_used_size;
@@ -424,7 +426,7 @@ namespace jsb::internal
         {
             if (is_valid_index(p_index))
             {
-                Slot& slot = get_data()[p_index.get_index()];
+                Slot& slot = get_slot(p_index.get_index());
                 out_item = &slot.value;
                 return true;
             }
@@ -437,7 +439,7 @@ namespace jsb::internal
         {
             if (is_valid_index(p_index))
             {
-                const Slot& slot = get_data()[p_index.get_index()];
+                const Slot& slot = get_slot(p_index.get_index());
                 out_item = &slot.value;
                 return true;
             }
@@ -449,7 +451,7 @@ namespace jsb::internal
         {
             if (is_valid_index(p_index))
             {
-                Slot& slot = get_data()[p_index.get_index()];
+                Slot& slot = get_slot(p_index.get_index());
                 out_item = slot.value;
                 return true;
             }
@@ -469,7 +471,7 @@ namespace jsb::internal
         T pop()
         {
             jsb_check(_last_index != INDEX_NONE);
-            const Slot& slot = get_data()[_last_index];
+            const Slot& slot = get_slot(_last_index);
             const T item = std::move(slot.value);
             remove_at({_last_index, slot.revision});
             return item;
@@ -478,7 +480,7 @@ namespace jsb::internal
         void remove_last()
         {
             jsb_check(_last_index != INDEX_NONE);
-            const Slot& slot = get_data()[_last_index];
+            const Slot& slot = get_slot(_last_index);
             remove_at({_last_index, slot.revision});
         }
 
@@ -512,7 +514,7 @@ namespace jsb::internal
             jsb_check(p_index.get_revision() != 0);
             jsb_check(p_index.get_index() >= 0);
             jsb_check(p_index.get_index() < capacity());
-            Slot& slot = get_data()[p_index.get_index()];
+            Slot& slot = get_slot(p_index.get_index());
             jsb_check(p_index.get_revision() == slot.revision);
             return slot.value;
         }
@@ -521,7 +523,7 @@ namespace jsb::internal
         {
             jsb_check(p_index.get_index() >= 0);
             jsb_check(p_index.get_index() < capacity());
-            const Slot& slot = get_data()[p_index.get_index()];
+            const Slot& slot = get_slot(p_index.get_index());
             jsb_check(p_index.get_revision() == slot.revision);
             return slot.value;
         }
@@ -530,7 +532,7 @@ namespace jsb::internal
         {
             if (p_index.get_index() >= 0 && p_index.get_index() < capacity())
             {
-                const Slot& slot = get_data()[p_index.get_index()];
+                const Slot& slot = get_slot(p_index.get_index());
                 if (p_index.get_revision() == slot.revision)
                 {
                     o_value = slot.value;
@@ -552,7 +554,7 @@ namespace jsb::internal
             int current = _first_index;
             while (current != INDEX_NONE)
             {
-                const Slot& slot = get_data()[current];
+                const Slot& slot = get_slot(current);
                 if (slot.value == p_item)
                 {
                     return IndexType(current, slot.revision);
@@ -568,7 +570,7 @@ namespace jsb::internal
             int current = _last_index;
             while (current != INDEX_NONE)
             {
-                const Slot& slot = get_data()[current];
+                const Slot& slot = get_slot(current);
                 if (slot.value == p_item)
                 {
                     return IndexType(current, slot.revision);
@@ -596,7 +598,7 @@ namespace jsb::internal
             {
                 return false;
             }
-            Slot& slot = get_data()[p_index.get_index()];
+            Slot& slot = get_slot(p_index.get_index());
             if (slot.revision != p_index.get_revision())
             {
                 return false;
@@ -623,11 +625,11 @@ namespace jsb::internal
 
             if (next != INDEX_NONE)
             {
-                get_data()[next].previous = previous;
+                get_slot(next).previous = previous;
             }
             if (previous != INDEX_NONE)
             {
-                get_data()[previous].next = next;
+                get_slot(previous).next = next;
             }
             if (_first_index == p_index.get_index())
             {
@@ -661,7 +663,7 @@ namespace jsb::internal
         void grow_if_needed(int p_extra_count)
         {
             jsb_check(p_extra_count > 0);
-            jsb_check(_address_locked == 0);
+            jsb_check(kStableAddress || _address_locked == 0);
             const int current_size = capacity();
             const int expected_size = _used_size + p_extra_count;
             if (expected_size <= current_size)
@@ -669,13 +671,15 @@ namespace jsb::internal
                 return;
             }
 
-            const int new_capacity = std::max(std::max(current_size * 2, 4), expected_size);
-            allocator.resize(current_size, new_capacity);
-            jsb_check(new_capacity == capacity());
-            Slot* slots_base = get_data();
+            // the allocator may round up the capacity (e.g. to the page size).
+            // a stable-address allocator grows page by page, nothing is moved so there is no need to amortize by doubling.
+            const int new_size = kStableAddress ? expected_size : std::max(std::max(current_size * 2, 4), expected_size);
+            allocator.resize(current_size, new_size);
+            const int new_capacity = capacity();
+            jsb_check(new_capacity >= expected_size);
             for (int i = current_size; i < new_capacity; ++i)
             {
-                Slot& slot = slots_base[i];
+                Slot& slot = get_slot(i);
 #if JSB_SARRAY_DEBUG
                 jsb_check(!slot.has_value());
 #endif
@@ -833,8 +837,8 @@ namespace jsb::internal
             int index = other._first_index;
             while (index != INDEX_NONE)
             {
-                add(other.get_data()[index].value);
-                index = other.get_data()[index].next;
+                add(other.get_slot(index).value);
+                index = other.get_slot(index).next;
             }
             return *this;
         }
@@ -853,12 +857,12 @@ namespace jsb::internal
             int rhs_index = rhs._first_index;
             while (lhs_index != INDEX_NONE && rhs_index != INDEX_NONE)
             {
-                if (lhs.get_data()[lhs_index].value != rhs.get_data()[rhs_index].value)
+                if (lhs.get_slot(lhs_index).value != rhs.get_slot(rhs_index).value)
                 {
                     return false;
                 }
-                lhs_index = lhs.get_data()[lhs_index].next;
-                rhs_index = rhs.get_data()[rhs_index].next;
+                lhs_index = lhs.get_slot(lhs_index).next;
+                rhs_index = rhs.get_slot(rhs_index).next;
             }
             return true;
         }
@@ -869,8 +873,9 @@ namespace jsb::internal
         }
 
     private:
-        jsb_force_inline void lock_address() { ++_address_locked; }
-        jsb_force_inline void unlock_address() { jsb_check(_address_locked > 0); --_address_locked; }
+        // it's only tracked for debugging (growing with locked addresses), which is unnecessary if addresses are stable
+        jsb_force_inline void lock_address() { if constexpr (!kStableAddress) ++_address_locked; }
+        jsb_force_inline void unlock_address() { if constexpr (!kStableAddress) { jsb_check(_address_locked > 0); --_address_locked; } }
 
 #if JSB_SARRAY_CONSISTENCY_CHECK
         bool is_consistent() const
@@ -879,7 +884,7 @@ namespace jsb::internal
             int count = 0;
             while (index != INDEX_NONE)
             {
-                const Slot& slot = get_data()[index];
+                const Slot& slot = get_slot(index);
                 index = slot.next;
                 ++count;
             }
@@ -890,7 +895,7 @@ namespace jsb::internal
                 index = _first_index;
                 while (index != INDEX_NONE)
                 {
-                    const Slot& slot = get_data()[index];
+                    const Slot& slot = get_slot(index);
                     jsb_check(is_valid_index({ index, slot.revision }));
                     if (index == _first_index)
                     {
@@ -898,11 +903,11 @@ namespace jsb::internal
                     }
                     if (slot.next != INDEX_NONE)
                     {
-                        jsb_check(get_data()[slot.next].previous == index);
+                        jsb_check(get_slot(slot.next).previous == index);
                     }
                     if (slot.previous != INDEX_NONE)
                     {
-                        jsb_check(get_data()[slot.previous].next == index);
+                        jsb_check(get_slot(slot.previous).next == index);
                     }
                     ++count;
                     jsb_check(count <= _used_size);
@@ -0,0 +1,197 @@
+#ifndef GODOTJS_SCRIPT_LEXER_H
+#define GODOTJS_SCRIPT_LEXER_H
+
+#include "jsb_internal_pch.h"
+
+namespace jsb::internal
+{
+    struct ScriptToken
+    {
+        enum Kind : uint8_t
+        {
+            End,
+            Identifier,
+            // string literal (including template literal)
+            Literal,
+            // regular expression literal
+            RegExp,
+            Punct,
+        };
+
+        Kind kind = End;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    // a minimal JS/TS tokenizer which is only good enough for matching declarations and `require` calls in place.
+    // comments are skipped, string/template/regex literals are returned as a single token without unescaping.
+    class ScriptLexer
+    {
+    public:
+        ScriptLexer(const uint8_t* p_source, size_t p_len) : src_(p_source), len_(p_len) {}
+
+        ScriptToken next()
+        {
+            while (pos_ < len_)
+            {
+                const uint8_t c = src_[pos_];
+                if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+                {
+                    ++pos_;
+                    continue;
+                }
+                if (c == '/' && pos_ + 1 < len_)
+                {
+                    if (src_[pos_ + 1] == '/')
+                    {
+                        while (pos_ < len_ && src_[pos_] != '\n') ++pos_;
+                        continue;
+                    }
+                    if (src_[pos_ + 1] == '*')
+                    {
+                        pos_ += 2;
+                        while (pos_ + 1 < len_ && !(src_[pos_] == '*' && src_[pos_ + 1] == '/')) ++pos_;
+                        pos_ = pos_ + 2 < len_ ? pos_ + 2 : len_;
+                        continue;
+                    }
+                }
+
+                ScriptToken token;
+                token.begin = pos_;
+                if (c == '\'' || c == '"' || c == '`')
+                {
+                    // skip the string literal
+                    ++pos_;
+                    while (pos_ < len_ && src_[pos_] != c)
+                    {
+                        pos_ += src_[pos_] == '\\' ? 2 : 1;
+                    }
+                    pos_ = pos_ + 1 < len_ ? pos_ + 1 : len_;
+                    token.kind = ScriptToken::Literal;
+                }
+                else if (c == '/' && is_regexp_allowed())
+                {
+                    skip_regexp();
+                    token.kind = ScriptToken::RegExp;
+                }
+                else if (is_identifier_char(c))
+                {
+                    while (pos_ < len_ && is_identifier_char(src_[pos_])) ++pos_;
+                    token.kind = ScriptToken::Identifier;
+                }
+                else
+                {
+                    ++pos_;
+                    token.kind = ScriptToken::Punct;
+                }
+                token.end = pos_ < len_ ? pos_ : len_;
+                last_ = token;
+                return token;
+            }
+            return {};
+        }
+
+        bool is_identifier(const ScriptToken& p_token) const { return p_token.kind == ScriptToken::Identifier; }
+
+        template<size_t N>
+        bool is_identifier(const ScriptToken& p_token, const char (&p_name)[N]) const
+        {
+            return p_token.kind == ScriptToken::Identifier
+                && p_token.end - p_token.begin == N - 1
+                && memcmp(src_ + p_token.begin, p_name, N - 1) == 0;
+        }
+
+        bool is_punct(const ScriptToken& p_token, char p_char) const
+        {
+            return p_token.kind == ScriptToken::Punct && src_[p_token.begin] == (uint8_t) p_char;
+        }
+
+        bool equals(const ScriptToken& p_a, const ScriptToken& p_b) const
+        {
+            return p_a.end - p_a.begin == p_b.end - p_b.begin && memcmp(src_ + p_a.begin, src_ + p_b.begin, p_a.end - p_a.begin) == 0;
+        }
+
+        String to_string(const ScriptToken& p_token) const
+        {
+            String str;
+            str.parse_utf8((const char*) src_ + p_token.begin, (int) (p_token.end - p_token.begin));
+            return str;
+        }
+
+        // get the content of a string literal without quotes.
+        // return false if it's not a string literal, or it's a template literal with substitutions.
+        bool get_literal_string(const ScriptToken& p_token, String& r_string) const
+        {
+            if (p_token.kind != ScriptToken::Literal || p_token.end - p_token.begin < 2) return false;
+            const char* begin = (const char*) src_ + p_token.begin + 1;
+            const int len = (int) (p_token.end - p_token.begin - 2);
+            if (*(begin - 1) == '`' && memchr(begin, '$', len)) return false;
+            r_string.parse_utf8(begin, len);
+            return true;
+        }
+
+        // skip tokens until the closing parenthesis (the opening one is already consumed)
+        void skip_parentheses()
+        {
+            int depth = 1;
+            for (ScriptToken token = next(); token.kind != ScriptToken::End; token = next())
+            {
+                if (is_punct(token, '(')) ++depth;
+                else if (is_punct(token, ')') && --depth == 0) return;
+            }
+        }
+
+    private:
+        static bool is_identifier_char(uint8_t c)
+        {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_' || c == '$' || c >= 0x80;
+        }
+
+        // a slash starts a regex literal instead of a division if it's not after an operand
+        bool is_regexp_allowed() const
+        {
+            switch (last_.kind)
+            {
+            case ScriptToken::End: return true;
+            case ScriptToken::Literal:
+            case ScriptToken::RegExp: return false;
+            case ScriptToken::Punct:
+                {
+                    const uint8_t c = src_[last_.begin];
+                    return c != ')' && c != ']';
+                }
+            case ScriptToken::Identifier:
+                return is_identifier(last_, "return") || is_identifier(last_, "typeof") || is_identifier(last_, "case")
+                    || is_identifier(last_, "do") || is_identifier(last_, "else") || is_identifier(last_, "in")
+                    || is_identifier(last_, "of") || is_identifier(last_, "new") || is_identifier(last_, "delete")
+                    || is_identifier(last_, "void") || is_identifier(last_, "throw") || is_identifier(last_, "instanceof")
+                    || is_identifier(last_, "yield") || is_identifier(last_, "await");
+            default: return false;
+            }
+        }
+
+        void skip_regexp()
+        {
+            bool in_class = false;
+            ++pos_;
+            while (pos_ < len_ && src_[pos_] != '\n')
+            {
+                const uint8_t c = src_[pos_];
+                if (c == '\\') { pos_ += 2; continue; }
+                ++pos_;
+                if (c == '[') in_class = true;
+                else if (c == ']') in_class = false;
+                else if (c == '/' && !in_class) break;
+            }
+            // flags
+            while (pos_ < len_ && is_identifier_char(src_[pos_])) ++pos_;
+        }
+
+        const uint8_t* src_;
+        size_t len_;
+        size_t pos_ = 0;
+        ScriptToken last_;
+    };
+}
+
+#endif
@@ -14,6 +14,7 @@ namespace jsb::internal
 #ifdef TOOLS_ENABLED
     static constexpr char kEdDebuggerPort[] =     JSB_MODULE_NAME_STRING "/debugger/editor_port";
     static constexpr char kEdIgnoredClasses[] =     JSB_MODULE_NAME_STRING "/codegen/ignored_classes";
+    static constexpr char kEdTranspileOnChange[] =     JSB_MODULE_NAME_STRING "/typescript/transpile_on_change";
 #endif
 
     // use unnecessary first category layer (runtime and editor) to make the second layer shown as sections in project settings
@@ -26,6 +27,7 @@ namespace jsb::internal
     // editor specific settings, but we need it configured as project-wise instead of global-wise
     static constexpr char kRtPackagingWithSourceMap[] = JSB_MODULE_NAME_STRING "/editor/packaging/source_map_included";
     static constexpr char kRtPackagingIncludeFiles[] = JSB_MODULE_NAME_STRING "/editor/packaging/include_files";
+    static constexpr char kRtPackagingEliminateDeadModules[] = JSB_MODULE_NAME_STRING "/editor/packaging/eliminate_dead_modules";
 
     void init_settings()
     {
@@ -58,6 +60,7 @@ namespace jsb::internal
             {
                 _EDITOR_DEF(kEdDebuggerPort, 9230, true);
                 _EDITOR_DEF(kEdIgnoredClasses, PackedStringArray(), false);
+                _EDITOR_DEF(kEdTranspileOnChange, false, false);
             }
 #endif
             _GLOBAL_DEF(kRtDebuggerPort, 9229, JSB_SET_RESTART(true), JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(false), JSB_SET_INTERNAL(false));
@@ -82,6 +85,7 @@ namespace jsb::internal
                 PackagingIncludeFiles.hint_string = vformat("%s/%s:%s", Variant::STRING, PROPERTY_HINT_FILE, filter);
                 _GLOBAL_DEF(PackagingIncludeFiles, Array(), false, JSB_SET_IGNORE_DOCS(false), JSB_SET_BASIC(true),  JSB_SET_INTERNAL(false));
             }
+            _GLOBAL_DEF(kRtPackagingEliminateDeadModules, false, false);
         }
     }
 
@@ -91,6 +95,12 @@ namespace jsb::internal
         init_settings();
         return EDITOR_GET(kEdIgnoredClasses);
     }
+
+    bool Settings::is_transpile_on_change_enabled()
+    {
+        init_settings();
+        return EDITOR_GET(kEdTranspileOnChange);
+    }
 #endif
 
     bool Settings::is_packaging_with_source_map()
@@ -99,6 +109,12 @@ namespace jsb::internal
         return GLOBAL_GET(kRtPackagingWithSourceMap);
     }
 
+    bool Settings::is_packaging_dead_module_elimination()
+    {
+        init_settings();
+        return GLOBAL_GET(kRtPackagingEliminateDeadModules);
+    }
+
     PackedStringArray Settings::get_packaging_include_files()
     {
         init_settings();
@@ -146,6 +162,26 @@ namespace jsb::internal
         return "res://" + get_jsb_out_dir_name();
     }
 
+    String Settings::get_class_header_cache_path()
+    {
+        return "res://" + get_project_data_dir_name().path_join("jsb_class_headers.cache");
+    }
+
+    String Settings::get_codegen_cache_path()
+    {
+        return "res://" + get_project_data_dir_name().path_join("jsb_codegen.cache.json");
+    }
+
+    String Settings::get_export_cache_path()
+    {
+        return "res://" + get_project_data_dir_name().path_join("jsb_export.cache");
+    }
+
+    String Settings::get_transpile_cache_path()
+    {
+        return "res://" + get_project_data_dir_name().path_join("jsb_transpile.cache.json");
+    }
+
     PackedStringArray Settings::get_additional_search_paths()
     {
         init_settings();
@@ -28,6 +28,26 @@ namespace jsb::internal
          */
         static String get_jsb_out_res_path();
 
+        /**
+         * get the res path of the class header index cache (.godot/jsb_class_headers.cache)
+         */
+        static String get_class_header_cache_path();
+
+        /**
+         * get the res path of the godot.d.ts codegen cache (.godot/jsb_codegen.cache.json)
+         */
+        static String get_codegen_cache_path();
+
+        /**
+         * get the res path of the export pipeline cache (.godot/jsb_export.cache)
+         */
+        static String get_export_cache_path();
+
+        /**
+         * get the res path of the editor transpile cache (.godot/jsb_transpile.cache.json)
+         */
+        static String get_transpile_cache_path();
+
         static String get_indentation();
 
         static String get_project_data_dir_name();
@@ -40,9 +60,18 @@ namespace jsb::internal
 
         static PackedStringArray get_packaging_include_files();
 
+        // only export modules reachable from scenes/resources, autoloads, the entry script and explicitly included files.
+        // modules loaded by non-literal `require` or `ResourceLoader.load` must be explicitly included if it's enabled.
+        static bool is_packaging_dead_module_elimination();
+
 #ifdef TOOLS_ENABLED
         // [EDITOR ONLY]
         static PackedStringArray get_ignored_classes();
+
+        // [EDITOR ONLY] transpile changed typescripts in the editor (type-checking is left to tsc, it runs with --noEmit then).
+        // disabled by default, each file is transpiled in isolation (`isolatedModules`), `const enum` is preserved as a real enum object,
+        // but an ambient `declare const enum` (in .d.ts) has no value at runtime and can't be used with it.
+        static bool is_transpile_on_change_enabled();
 #endif
     };
 }
@@ -59,3 +59,35 @@ DEF(onerror)
 DEF(postMessage)
 DEF(transfer)
 DEF(close)
+DEF(SceneBuilder)
+DEF(onbuild)
+
+// weak reference
+DEF(GodotWeakRef)
+
+// text codec
+DEF(TextEncoder)
+DEF(TextDecoder)
+DEF(Uint8Array)
+DEF(buffer)
+DEF(byteOffset)
+DEF(byteLength)
+DEF(fatal)
+DEF(ignoreBOM)
+DEF(stream)
+DEF(read)
+DEF(written)
+
+// json
+DEF(toJSON)
+DEF(keys)
+
+// reflect (patching prototypes on reload)
+DEF(Reflect)
+DEF(ownKeys)
+DEF(defineProperty)
+DEF(deleteProperty)
+DEF(getOwnPropertyDescriptor)
+
+// script signals
+DEF(arguments)
@@ -0,0 +1,131 @@
+#ifndef GODOTJS_UTF8_H
+#define GODOTJS_UTF8_H
+
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+
+namespace jsb::internal
+{
+    // minimal UTF-8 scanning utilities (used by TextEncoder/TextDecoder).
+    // all functions work on raw bytes without any allocation.
+    class UTF8
+    {
+    public:
+        enum Sequence : uint8_t
+        {
+            Valid,
+            // ill-formed, `r_len` is the length of the maximal subpart (at least 1)
+            Invalid,
+            // well-formed so far, but truncated by the end of input
+            Incomplete,
+        };
+
+        // the number of leading ASCII bytes.
+        // it checks a machine word at a time (SWAR) for long ASCII runs which are the most common case in practice.
+        static size_t ascii_prefix(const uint8_t* p_data, size_t p_len)
+        {
+            constexpr uint64_t kHighBits = 0x8080808080808080ULL;
+            size_t pos = 0;
+            for (; pos + sizeof(uint64_t) <= p_len; pos += sizeof(uint64_t))
+            {
+                uint64_t word;
+                memcpy(&word, p_data + pos, sizeof(uint64_t));
+                if (word & kHighBits) break;
+            }
+            while (pos < p_len && p_data[pos] < 0x80) ++pos;
+            return pos;
+        }
+
+        // check the sequence at the beginning of `p_data` (`p_len` must not be zero)
+        static Sequence next(const uint8_t* p_data, size_t p_len, int& r_len)
+        {
+            const uint8_t lead = p_data[0];
+            if (lead < 0x80) { r_len = 1; return Valid; }
+
+            int size;
+            uint8_t lower = 0x80, upper = 0xBF; // range of the second byte
+            if (lead >= 0xC2 && lead <= 0xDF) size = 2;
+            else if (lead >= 0xE0 && lead <= 0xEF)
+            {
+                size = 3;
+                if (lead == 0xE0) lower = 0xA0;      // overlong
+                else if (lead == 0xED) upper = 0x9F; // surrogates
+            }
+            else if (lead >= 0xF0 && lead <= 0xF4)
+            {
+                size = 4;
+                if (lead == 0xF0) lower = 0x90;      // overlong
+                else if (lead == 0xF4) upper = 0x8F; // > U+10FFFF
+            }
+            else { r_len = 1; return Invalid; }
+
+            for (int index = 1; index < size; ++index)
+            {
+                if ((size_t) index >= p_len) { r_len = index; return Incomplete; }
+                const uint8_t byte = p_data[index];
+                if (byte < lower || byte > upper) { r_len = index; return Invalid; }
+                lower = 0x80;
+                upper = 0xBF;
+            }
+            r_len = size;
+            return Valid;
+        }
+
+        // the length of the longest well-formed prefix
+        static size_t valid_prefix(const uint8_t* p_data, size_t p_len)
+        {
+            size_t pos = 0;
+            while (pos < p_len)
+            {
+                pos += ascii_prefix(p_data + pos, p_len - pos);
+                if (pos == p_len) break;
+                int len;
+                if (next(p_data + pos, p_len - pos, len) != Valid) break;
+                pos += len;
+            }
+            return pos;
+        }
+
+        // the number of bytes of the longest prefix of complete sequences which fits into `p_capacity`.
+        // `r_utf16_len` is the number of UTF-16 code units of the prefix.
+        //NOTE `p_data` must be well-formed (or at least generated by a JS engine, lone surrogates are accepted)
+        static size_t truncate(const uint8_t* p_data, size_t p_len, size_t p_capacity, size_t& r_utf16_len)
+        {
+            const size_t limit = p_len < p_capacity ? p_len : p_capacity;
+            size_t pos = ascii_prefix(p_data, limit);
+            size_t units = pos;
+            while (pos < limit)
+            {
+                const uint8_t lead = p_data[pos];
+                const size_t size = lead < 0x80 ? 1 : lead < 0xE0 ? 2 : lead < 0xF0 ? 3 : 4;
+                if (pos + size > limit) break;
+                pos += size;
+                units += size == 4 ? 2 : 1;
+            }
+            r_utf16_len = units;
+            return pos;
+        }
+
+        // replace the lone surrogates (encoded as 3 bytes `ED A0..BF xx` by some engines) with U+FFFD in place.
+        // the length is unchanged since U+FFFD is also 3 bytes in UTF-8.
+        static void replace_surrogates(uint8_t* p_data, size_t p_len)
+        {
+            size_t pos = ascii_prefix(p_data, p_len);
+            while (pos + 2 < p_len)
+            {
+                if (p_data[pos] == 0xED && p_data[pos + 1] >= 0xA0)
+                {
+                    p_data[pos] = 0xEF;
+                    p_data[pos + 1] = 0xBF;
+                    p_data[pos + 2] = 0xBD;
+                    pos += 3;
+                    continue;
+                }
+                ++pos;
+            }
+        }
+    };
+}
+
+#endif
@@ -77,6 +77,37 @@ namespace jsb::internal
         jsb_force_inline void decrement() {}
 #endif
     };
+
+    // a bump-pointer page for the Variants of short-lived valuetypes, it's reset as a whole at the end of frame.
+    // all Variants in it must be either destructed or moved out before `reset()`.
+    class VariantNursery
+    {
+        Variant* page_ = nullptr;
+        uint32_t capacity_;
+        uint32_t top_ = 0;
+
+    public:
+        explicit VariantNursery(uint32_t p_capacity) : capacity_(p_capacity) {}
+        ~VariantNursery() { if (page_) memfree(page_); }
+
+        VariantNursery(const VariantNursery&) = delete;
+        VariantNursery& operator=(const VariantNursery&) = delete;
+
+        jsb_force_inline bool is_full() const { return top_ == capacity_; }
+        jsb_force_inline uint32_t size() const { return top_; }
+
+        jsb_force_inline bool owns(const Variant* p_var) const { return p_var >= page_ && p_var < page_ + top_; }
+
+        jsb_force_inline Variant* alloc(const Variant& p_templet)
+        {
+            jsb_check(!is_full());
+            // the page is allocated on demand (most workers never use it)
+            if (unlikely(!page_)) page_ = (Variant*) memalloc(sizeof(Variant) * capacity_);
+            return memnew_placement(page_ + top_++, Variant(p_templet));
+        }
+
+        jsb_force_inline void reset() { top_ = 0; }
+    };
 }
 
 #endif
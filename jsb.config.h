@@ -41,7 +41,7 @@
 #define JSB_BENCHMARK 1
 
 // [EXPERIMENTAL] enable auto-complete feature in the input field of REPL.
-//NOTE this feature introduces side effects since it will try to evaluate the input string before you submit.
+// the input is not evaluated, only the trailing `a.b.c` chain is resolved through data properties (getters are not invoked).
 #define JSB_REPL_AUTO_COMPLETE 1
 
 // (only available when using v8)
@@ -102,7 +102,8 @@
 // [EXPERIMENTAL] DONT CHANGE IT
 #define JSB_THREADING 1
 
-// slots for object/script/class info is reallocated on heap (as a whole block of memory)
+// initial slots for object/script/class info.
+// object slots grow page by page (never reallocated), script/class info slots are reallocated on heap (as a whole block of memory).
 // a suitable value can avoid unnecessary reallocation
 #define JSB_MASTER_INITIAL_OBJECT_SLOTS (1024 * 64)
 #define JSB_MASTER_INITIAL_SCRIPT_SLOTS 1024
@@ -112,6 +113,32 @@
 #define JSB_WORKER_INITIAL_SCRIPT_SLOTS 1024
 #define JSB_WORKER_INITIAL_CLASS_SLOTS 512
 
+// max time (in microseconds) spent on replaying the scenes built by `SceneBuilder` (in workers) in each `Environment::update`
+#define JSB_SCENE_BUILD_BUDGET_USEC 2000
+
+// max time (in microseconds) spent on finalizing the native objects of garbage collected JS objects in each `Environment::update`,
+// the rest are finalized in the following frames.
+#define JSB_GC_FINALIZE_BUDGET_USEC 1000
+
+// interval (in microseconds) of checking GodotWeakRef whose object is alive but unbound, for the deletion or the rebinding of the object.
+#define JSB_WEAK_REF_PARKED_CHECK_INTERVAL_USEC 500000
+
+// (only available when using quickjs)
+// reuse the JS wrappers of math valuetypes (Vector2 ... Color) which are no longer referenced by scripts at the end of frame.
+// wrappers used as WeakMap/WeakSet keys (or changed by scripts in any way) are never reused.
+// NOTE the bundled quickjs has no WeakRef/FinalizationRegistry, it must be revisited if they're supported.
+#define JSB_WITH_VALUETYPE_RECYCLING 1
+
+// max num of free wrappers kept for each valuetype
+#define JSB_VALUETYPE_POOL_SIZE 256
+
+// max num of wrappers tracked for recycling in each frame, the rest are left to GC.
+// it's also the capacity of the nursery page where the Variants of tracked wrappers are allocated.
+#define JSB_VALUETYPE_POOL_TRACK_LIMIT 8192
+
+// num of bits of the direct-mapped identity cache of godot objects converted to JS (2^N entries)
+#define JSB_OBJECT_IDENTITY_CACHE_BITS 8
+
 // always exclude the worker scripts end with `.worker.js/ts` from ResourceLoader.
 // they should only be loaded by JSWorker.
 #define JSB_EXCLUDE_WORKER_RES_SCRIPTS 1
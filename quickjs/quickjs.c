@@ -12105,6 +12105,16 @@ int JS_IsArrayBuffer(JSValueConst val)
         return FALSE;
     }
 }
+int JS_IsWeakRefTarget(JSValueConst val)
+{
+    JSObject *p;
+    if (JS_VALUE_GET_TAG(val) == JS_TAG_OBJECT) {
+        p = JS_VALUE_GET_OBJ(val);
+        return p->first_weak_ref != NULL;
+    } else {
+        return FALSE;
+    }
+}
 //NOTE jsb:modified [end]
 
 static double js_pow(double a, double b)
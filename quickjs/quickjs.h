@@ -750,6 +750,8 @@ int JS_IsArray(JSContext *ctx, JSValueConst val);
 int JS_IsMap(JSValueConst val);
 int JS_IsPromise(JSValueConst val);
 int JS_IsArrayBuffer(JSValueConst val);
+/* TRUE if the object is a key of any WeakMap/WeakSet */
+int JS_IsWeakRefTarget(JSValueConst val);
 //NOTE jsb:modified [end]
 
 JSValue JS_GetPropertyInternal(JSContext *ctx, JSValueConst obj,
@@ -9,6 +9,19 @@ if (!jsb.TOOLS_ENABLED) {
 const tab = "    ";
 const GodotAnyType: string = "GAny";
 
+// bump it if the output of codegen is changed, all cached classes will be emitted again
+const CodeGenCacheVersion = 1;
+
+interface CodeGenCache {
+    version: number;
+
+    // context hash from `jsb.editor.ClassDump`
+    hash: string;
+
+    // emitted lines of godot classes (keyed by class name, or `singleton:` + class name in singleton mode)
+    classes: { [key: string]: { hash: string, lines: string[] } };
+}
+
 interface CodeWriter {
     get types(): TypeDB;
     get size(): number;
@@ -674,51 +687,56 @@ class EnumWriter extends IndentWriter {
     }
 }
 
-class FileWriter extends AbstractWriter {
-    private _file: FileAccess;
+// collect lines in memory (for the content of a generated file, or the cached content of a class)
+class BufferWriter extends AbstractWriter {
+    private _lines: string[] = [];
     private _size = 0;
-    private _lineno = 0;
     private _types: TypeDB;
 
-    constructor(types: TypeDB, file: FileAccess) {
+    constructor(types: TypeDB) {
         super();
         this._types = types;
-        this._file = file;
     }
 
     get size() { return this._size; }
-    get lineno() { return this._lineno; }
+    get lineno() { return this._lines.length; }
     get types() { return this._types; }
+    get lines() { return this._lines; }
 
     line(text: string): void {
-        this._file.store_line(text);
+        this._lines.push(text);
         this._size += text.length;
-        this._lineno += 1;
     }
 
-    finish(): void {
-        this._file.flush();
-    }
+    finish(): void { }
 }
 
 class FileSplitter {
-    private _file: FileAccess;
+    private _path: string;
+    private _buffer: BufferWriter;
     private _toplevel: ModuleWriter;
-    private _types: TypeDB;
 
     constructor(types: TypeDB, filePath: string) {
-        this._types = types;
-        this._file = FileAccess.open(filePath, FileAccess.ModeFlags.WRITE);
-        this._toplevel = new ModuleWriter(new FileWriter(this._types, this._file), "godot");
-
-        this._file.store_line("// AUTO-GENERATED");
-        this._file.store_line('/// <reference no-default-lib="true"/>');
+        this._path = filePath;
+        this._buffer = new BufferWriter(types);
+        this._toplevel = new ModuleWriter(this._buffer, "godot");
     }
 
-    close() {
+    /**
+     * write the file only if the content is changed, 
+     * so that unchanged files will not be reloaded by VSCode TS server and file watchers.
+     * @returns false if the file is unchanged
+     */
+    close(): boolean {
         this._toplevel.finish();
-        this._file.flush();
-        this._file.close();
+        const text = ["// AUTO-GENERATED", '/// <reference no-default-lib="true"/>', ...this._buffer.lines, ""].join("\n");
+        if (FileAccess.file_exists(this._path) && FileAccess.get_file_as_string(this._path) == text) {
+            return false;
+        }
+        const file = FileAccess.open(this._path, FileAccess.ModeFlags.WRITE);
+        file.store_string(text);
+        file.close();
+        return true;
     }
 
     get_writer() {
@@ -731,7 +749,14 @@ class FileSplitter {
 
 export class TypeDB {
     singletons: { [name: string]: jsb.editor.SingletonInfo } = {};
-    classes: { [name: string]: jsb.editor.ClassInfo } = {};
+
+    // brief of all godot classes, the full class info is loaded lazily with `get_class`
+    classes: { [name: string]: jsb.editor.ClassDumpEntry } = {};
+    class_infos: { [name: string]: jsb.editor.ClassInfo } = {};
+
+    // hash of the class list, singletons and global enums
+    hash: string;
+
     primitive_types: { [name: string]: jsb.editor.PrimitiveClassInfo } = {};
     primitive_type_names: { [type: number /* Variant.Type */]: string } = {};
     globals: { [name: string]: jsb.editor.GlobalConstantInfo } = {};
@@ -741,7 +766,8 @@ export class TypeDB {
     class_docs: { [name: string]: jsb.editor.ClassDoc | false } = {};
 
     constructor() {
-        const classes = jsb.editor.get_classes();
+        const dump: jsb.editor.ClassDump = JSON.parse(jsb.editor.get_class_dump());
+        const classes = dump.classes;
         const primitive_types = jsb.editor.get_primitive_types();
         const singletons = jsb.editor.get_singletons();
         const globals = jsb.editor.get_global_constants();
@@ -762,6 +788,16 @@ export class TypeDB {
         for (let utility of utilities) {
             this.utilities[utility.name] = utility;
         }
+        this.hash = dump.hash;
+    }
+
+    get_class(class_name: string): jsb.editor.ClassInfo | undefined {
+        let class_info = this.class_infos[class_name];
+        if (typeof class_info === "undefined" && typeof this.classes[class_name] !== "undefined") {
+            class_info = jsb.editor.get_class_info(class_name)!;
+            this.class_infos[class_name] = class_info;
+        }
+        return class_info;
     }
 
     find_doc(class_name: string): jsb.editor.ClassDoc | undefined {
@@ -808,7 +844,7 @@ export class TypeDB {
                         return class_name;
                     }
                     const cls = types.classes[layers[0]];
-                    if (typeof cls !== "undefined" && cls.enums!.findIndex(v => v.name == layers[1]) >= 0) {
+                    if (typeof cls !== "undefined" && cls.enums.indexOf(layers[1]) >= 0) {
                         return class_name;
                     }
                 }
@@ -965,12 +1001,49 @@ export default class TSDCodeGen {
     private _outDir: string;
     private _splitter: FileSplitter | undefined;
     private _types: TypeDB;
+    private _cache_path: string | undefined;
+    private _cache: CodeGenCache;
+    private _next_cache: CodeGenCache;
+    private _stats = { emitted: 0, reused: 0, written: 0 };
 
-    constructor(outDir: string) {
+    /**
+     * @param outDir the directory of generated files
+     * @param cachePath the path of codegen cache, only changed classes are emitted again if available
+     */
+    constructor(outDir: string, cachePath?: string) {
         this._split_index = 0;
         this._outDir = outDir;
 
         this._types = new TypeDB();
+        this._cache_path = cachePath;
+        this._cache = this.load_cache();
+        this._next_cache = { version: CodeGenCacheVersion, hash: this._types.hash, classes: {} };
+    }
+
+    private load_cache(): CodeGenCache {
+        const empty: CodeGenCache = { version: CodeGenCacheVersion, hash: this._types.hash, classes: {} };
+        if (typeof this._cache_path !== "string" || !FileAccess.file_exists(this._cache_path)) {
+            return empty;
+        }
+        try {
+            const cache: CodeGenCache = JSON.parse(FileAccess.get_file_as_string(this._cache_path));
+            if (cache.version === CodeGenCacheVersion && cache.hash === this._types.hash) {
+                return cache;
+            }
+            console.log("codegen cache is outdated");
+        } catch (error) {
+            console.warn("failed to read codegen cache", error);
+        }
+        return empty;
+    }
+
+    private save_cache() {
+        if (typeof this._cache_path !== "string") {
+            return;
+        }
+        if (!jsb.json.stringifyToFile(this._cache_path, this._next_cache)) {
+            console.warn("failed to write codegen cache", this._cache_path);
+        }
     }
 
     private make_path(index: number) {
@@ -984,10 +1057,14 @@ export default class TSDCodeGen {
         return this._outDir + "/" + filename;
     }
 
-    private new_splitter() {
-        if (this._splitter !== undefined) {
-            this._splitter.close();
+    private close_splitter() {
+        if (this._splitter !== undefined && this._splitter.close()) {
+            ++this._stats.written;
         }
+    }
+
+    private new_splitter() {
+        this.close_splitter();
         const filename = this.make_path(this._split_index++);
         console.log("new writer", filename);
         this._splitter = new FileSplitter(this._types, filename);
@@ -1030,8 +1107,10 @@ export default class TSDCodeGen {
         this.emit_godot();
         this.emit_globals();
         this.emit_utilities();
-        this._splitter?.close();
+        this.close_splitter();
         this.cleanup();
+        this.save_cache();
+        console.log(`godot classes: ${this._stats.emitted} emitted, ${this._stats.reused} reused from cache, ${this._stats.written} files written`);
     }
 
     private emit_mock() {
@@ -1058,10 +1137,10 @@ export default class TSDCodeGen {
         for (let singleton_name in this._types.singletons) {
             const singleton = this._types.singletons[singleton_name];
 
-            const cls = this._types.classes[singleton.class_name];
-            if (typeof cls !== "undefined") {
+            const entry = this._types.classes[singleton.class_name];
+            if (typeof entry !== "undefined") {
                 cg.line_comment_(`_singleton_class_: ${singleton.class_name}`);
-                this.emit_godot_class(cg, cls, true);
+                this.emit_godot_class(cg, entry, true);
             } else {
                 cg.line_comment_(`ERROR: singleton ${singleton.name} without class info ${singleton.class_name}`)
             }
@@ -1105,7 +1184,7 @@ export default class TSDCodeGen {
 
     private emit_godot() {
         for (let class_name in this._types.classes) {
-            const cls = this._types.classes[class_name];
+            const entry = this._types.classes[class_name];
             if (IgnoredTypes.has(class_name)) {
                 continue;
             }
@@ -1113,7 +1192,7 @@ export default class TSDCodeGen {
                 // ignore the class if it's already defined as Singleton
                 continue;
             }
-            this.emit_godot_class(this.split(), cls, false);
+            this.emit_godot_class(this.split(), entry, false);
         }
 
         for (let class_name in this._types.primitive_types) {
@@ -1205,7 +1284,25 @@ export default class TSDCodeGen {
         class_cg.finish();
     }
 
-    private emit_godot_class(cg: CodeWriter, cls: jsb.editor.ClassInfo, singleton_mode: boolean) {
+    // reuse the cached lines if the class is unchanged, otherwise emit the class again
+    private emit_godot_class(cg: CodeWriter, entry: jsb.editor.ClassDumpEntry, singleton_mode: boolean) {
+        const key = singleton_mode ? `singleton:${entry.name}` : entry.name;
+        let cached = this._cache.classes[key];
+        if (typeof cached === "undefined" || cached.hash !== entry.hash) {
+            const buffer = new BufferWriter(this._types);
+            this.emit_godot_class_content(buffer, this._types.get_class(entry.name)!, singleton_mode);
+            cached = { hash: entry.hash, lines: buffer.lines };
+            ++this._stats.emitted;
+        } else {
+            ++this._stats.reused;
+        }
+        this._next_cache.classes[key] = cached;
+        for (let line of cached.lines) {
+            cg.line(line);
+        }
+    }
+
+    private emit_godot_class_content(cg: CodeWriter, cls: jsb.editor.ClassInfo, singleton_mode: boolean) {
         try {
             const class_doc = this._types.find_doc(cls.name);
             const ignored_consts: Set<string> = new Set();
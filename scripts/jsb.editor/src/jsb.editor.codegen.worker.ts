@@ -0,0 +1,80 @@
+
+import * as jsb from "godot-jsb";
+import { JSWorker, JSWorkerParent } from "godot.worker";
+import TSDCodeGen from "./jsb.editor.codegen";
+
+interface CodeGenRequest {
+    out_dir: string;
+    cache_path: string;
+}
+
+interface CodeGenResult {
+    error?: string;
+    elapsed: number;
+}
+
+// the worker is given up if no result is received in time (ms),
+// the master is not notified if the worker dies without a message (e.g. failed to load the worker script)
+const CodeGenTimeout = 5 * 60 * 1000;
+
+let running_worker: JSWorker | undefined;
+
+function finish_worker(worker: JSWorker) {
+    if (running_worker !== worker) {
+        return false;
+    }
+    running_worker = undefined;
+    worker.terminate();
+    jsb.editor.release_class_snapshot();
+    return true;
+}
+
+/**
+ * generate godot.d.ts in a worker thread, the editor is not blocked while generating.
+ * @returns false if the previous generation is still in progress
+ */
+export function emit_in_worker(out_dir: string, cache_path: string): boolean {
+    if (typeof running_worker !== "undefined") {
+        console.warn("godot.d.ts generation is already in progress");
+        return false;
+    }
+
+    // the worker reads the class data from the snapshot, ClassDB is not accessible off the main thread
+    jsb.editor.take_class_snapshot();
+    const worker = new JSWorker("jsb.editor.codegen.worker");
+    running_worker = worker;
+    const timeout = setTimeout(function () {
+        if (finish_worker(worker)) {
+            console.error(`failed to generate godot.d.ts: no response from the worker in ${CodeGenTimeout}ms`);
+        }
+    }, CodeGenTimeout);
+    worker.onmessage = function (result: CodeGenResult) {
+        clearTimeout(timeout);
+        if (!finish_worker(worker)) {
+            return;
+        }
+        if (typeof result.error === "string") {
+            console.error("failed to generate godot.d.ts:", result.error);
+        } else {
+            console.log(`godot.d.ts generated successfully (${result.elapsed}ms)`);
+        }
+    }
+    worker.postMessage(<CodeGenRequest>{ out_dir: out_dir, cache_path: cache_path });
+    return true;
+}
+
+// run as worker script
+if (typeof JSWorkerParent !== "undefined") {
+    const parent = JSWorkerParent;
+    parent.onmessage = function (request: CodeGenRequest) {
+        const start = Date.now();
+        let result: CodeGenResult;
+        try {
+            new TSDCodeGen(request.out_dir, request.cache_path).emit();
+            result = { elapsed: Date.now() - start };
+        } catch (error) {
+            result = { error: `${error}`, elapsed: Date.now() - start };
+        }
+        parent.postMessage(result);
+    }
+}
@@ -1,34 +1,116 @@
 // entry point (editor only)
-import { OS, PackedStringArray } from "godot";
-
-export function auto_complete(pattern: string): PackedStringArray {
-    let results = new PackedStringArray();
-    if (typeof pattern !== "string") {
-        return results;
-    }
-    
-    let scope: any = null;
-    let head = '';
-    let index = pattern.lastIndexOf('.');
-    let left = '';
-    if (index >= 0) {
-        left = pattern.substring(0, index + 1);
+import { OS } from "godot";
+import * as jsb from "godot-jsb";
+
+/**
+ * evaluate the source as a global script (for REPL), top-level declarations (let/const/class) are visible to later inputs.
+ * if the result is a promise, the settled value is printed to the console when it arrives.
+ * `await` is allowed at the top level, see `transform_top_level_await`.
+ */
+export function repl_eval(source: string): any {
+    const async_source = transform_top_level_await(source);
+    const result = jsb.internal.eval_script(typeof async_source !== "undefined" ? async_source : source, "repl");
+    if (result instanceof Promise) {
+        result.then(value => console.log(value), reason => console.error(reason));
+        return "Promise { <pending> }";
+    }
+    return result;
+}
+
+/**
+ * rewrite the source into an async function if `await` is used at the top level (not in nested functions or classes),
+ * top-level declarations are hoisted out of the function to keep them in the global scope (like the REPL of node.js).
+ * the value of the last expression statement is the result of the returned promise.
+ * @returns undefined if `await` is not used at the top level (or the parser is not available)
+ */
+export function transform_top_level_await(source: string): string | undefined {
+    // the parser is only used if the word `await` appears anywhere (including strings and comments)
+    if (!/\bawait\b/.test(source)) {
+        return undefined;
+    }
+    const ts = get_typescript();
+    if (!ts) {
+        return undefined;
+    }
+    const file = ts.createSourceFile("repl.js", source, ts.ScriptTarget.Latest, false, ts.ScriptKind.JS);
+    if (!contains_top_level_await(ts, file)) {
+        return undefined;
+    }
+
+    const hoisted: string[] = [];
+    const edits: { start: number, end: number, text: string }[] = [];
+    const statements = file.statements;
+    for (let i = 0; i < statements.length; ++i) {
+        const statement = statements[i];
+        const start = statement.getStart(file);
+        if (ts.isVariableStatement(statement)) {
+            // `const a = 1, { b } = c;` => `let a, b;` + `void (a = 1, { b } = c);`
+            const is_block_scoped = (statement.declarationList.flags & ts.NodeFlags.BlockScoped) != 0;
+            const names: string[] = [];
+            const assignments: string[] = [];
+            for (const declaration of statement.declarationList.declarations) {
+                collect_binding_names(ts, declaration.name, names);
+                if (declaration.initializer) {
+                    assignments.push(`${declaration.name.getText(file)} = ${declaration.initializer.getText(file)}`);
+                }
+            }
+            hoisted.push(`${is_block_scoped ? "let" : "var"} ${names.join(", ")};`);
+            edits.push({ start: start, end: statement.end, text: assignments.length != 0 ? `void (${assignments.join(", ")});` : "" });
+        } else if ((ts.isClassDeclaration(statement) || ts.isFunctionDeclaration(statement)) && statement.name) {
+            // `class A {}` => `let A;` + `A = class A {}`
+            const name = statement.name.text;
+            hoisted.push(`${ts.isClassDeclaration(statement) ? "let" : "var"} ${name};`);
+            edits.push({ start: start, end: start, text: `${name} = ` });
+        } else if (i == statements.length - 1 && ts.isExpressionStatement(statement)) {
+            edits.push({ start: start, end: statement.end, text: `return (${statement.expression.getText(file)});` });
+        }
+    }
+
+    let body = source;
+    for (let i = edits.length - 1; i >= 0; --i) {
+        const edit = edits[i];
+        body = body.substring(0, edit.start) + edit.text + body.substring(edit.end);
+    }
+    return `${hoisted.join(" ")}\n(async () => {\n${body}\n})()`;
+}
+
+let typescript_module: any;
+
+// typescript (in node_modules of the project) is loaded on demand, it's only used as the parser here
+function get_typescript(): any {
+    if (typeof typescript_module === "undefined") {
         try {
-            scope = eval(pattern.substring(0, index));
-        } catch (e) {
-            return results;
+            typescript_module = require("typescript");
+        } catch (error) {
+            console.warn("top-level await in REPL requires typescript to be installed", error);
+            typescript_module = null;
         }
-        pattern = pattern.substring(index + 1);
-    } else {
-        scope = globalThis;
     }
+    return typescript_module;
+}
 
-    for (let k in scope) {
-        if (k.indexOf(pattern) == 0) {
-            results.append(head + left + k);
+function contains_top_level_await(ts: any, node: any): boolean {
+    if (ts.isAwaitExpression(node) || (ts.isForOfStatement(node) && node.awaitModifier)) {
+        return true;
+    }
+    // `await` in nested functions or classes is not at the top level
+    if (ts.isFunctionLike(node) || ts.isClassLike(node)) {
+        return false;
+    }
+    return !!ts.forEachChild(node, (child: any) => contains_top_level_await(ts, child) || undefined);
+}
+
+function collect_binding_names(ts: any, name: any, names: string[]) {
+    if (ts.isIdentifier(name)) {
+        names.push(name.text);
+        return;
+    }
+    // object or array binding pattern
+    for (const element of name.elements) {
+        if (!ts.isOmittedExpression(element)) {
+            collect_binding_names(ts, element.name, names);
         }
     }
-    return results;
 }
 
 export function run_npm_install() {
@@ -0,0 +1,287 @@
+
+import { DirAccess, FileAccess, ResourceLoader, Script } from "godot";
+import { JSWorker, JSWorkerParent } from "godot.worker";
+
+const TranspileCacheVersion = 2;
+
+export interface TranspileFile {
+    // the typescript source path (res://)
+    source: string;
+    // the compiled script path (in the jsb out dir)
+    output: string;
+}
+
+interface TranspileRequest {
+    files: TranspileFile[];
+    cache_path: string;
+}
+
+interface TranspileResult {
+    // sources of the actually (re)written scripts
+    transpiled: string[];
+    errors: { source: string, message: string }[];
+    elapsed: number;
+}
+
+interface TranspileCache {
+    version: number;
+    // md5 of tsconfig.json, all entries are invalidated if compiler options changed
+    config: string;
+    // md5 of typescript sources which are transpiled to the current outputs
+    sources: { [path: string]: string };
+}
+
+// the worker is terminated if no result is received in time (ms),
+// the master is not notified if the worker dies without a message (e.g. failed to load the typescript compiler)
+const TranspileTimeout = 5 * 60 * 1000;
+
+let transpile_worker: JSWorker | undefined;
+let transpile_timeout: number | undefined;
+let running = false;
+let pending: { [source: string]: TranspileFile } | undefined;
+let pending_cache_path = "";
+
+/**
+ * transpile (without type-checking) typescript sources one by one in a dedicated worker,
+ * the typescript compiler is loaded once in the worker and reused for all later requests.
+ * changed scripts are marked as reloading when the outputs are written.
+ * NOTE each file is transpiled in isolation (`isolatedModules`), `const enum` can not be inlined across files,
+ *      it's preserved as a real enum object instead. an ambient `declare const enum` has no value at runtime and is not supported.
+ * @returns false if the request is queued because the previous one is still in progress
+ */
+export function transpile_in_worker(files: TranspileFile[], cache_path: string): boolean {
+    if (running) {
+        if (typeof pending === "undefined") {
+            pending = {};
+        }
+        for (let file of files) {
+            pending[file.source] = file;
+        }
+        pending_cache_path = cache_path;
+        return false;
+    }
+
+    if (typeof transpile_worker === "undefined") {
+        const worker = new JSWorker("jsb.editor.transpile");
+        transpile_worker = worker;
+        worker.onmessage = function (result: TranspileResult) {
+            if (transpile_worker !== worker) {
+                // a late result from a worker already given up
+                return;
+            }
+            clearTimeout(transpile_timeout);
+            transpile_timeout = undefined;
+            running = false;
+            on_transpiled(result);
+            flush_pending();
+        }
+    }
+    running = true;
+    transpile_worker.postMessage(<TranspileRequest>{ files: files, cache_path: cache_path });
+    transpile_timeout = setTimeout(function () {
+        transpile_timeout = undefined;
+        console.error(`failed to transpile ${files.length} scripts: no response from the worker in ${TranspileTimeout}ms`);
+        reset_worker();
+        // the queued requests are sent to a new worker
+        flush_pending();
+    }, TranspileTimeout);
+    return true;
+}
+
+export function terminate_worker() {
+    reset_worker();
+    pending = undefined;
+}
+
+function reset_worker() {
+    if (typeof transpile_timeout !== "undefined") {
+        clearTimeout(transpile_timeout);
+        transpile_timeout = undefined;
+    }
+    if (typeof transpile_worker !== "undefined") {
+        transpile_worker.terminate();
+        transpile_worker = undefined;
+    }
+    running = false;
+}
+
+function flush_pending() {
+    if (typeof pending !== "undefined") {
+        const next = Object.keys(pending).map(source => pending![source]);
+        pending = undefined;
+        transpile_in_worker(next, pending_cache_path);
+    }
+}
+
+function on_transpiled(result: TranspileResult) {
+    for (let error of result.errors) {
+        console.error(`failed to transpile ${error.source}:`, error.message);
+    }
+    for (let source of result.transpiled) {
+        // scripts not loaded yet will read the latest output when loading
+        if (ResourceLoader.has_cached(source)) {
+            const script = <Script>ResourceLoader.load(source);
+            script.reload(true);
+        }
+    }
+    if (result.transpiled.length != 0) {
+        console.log(`${result.transpiled.length} scripts transpiled (${result.elapsed}ms)`);
+    }
+}
+
+function dirname(path: string) {
+    const index = path.lastIndexOf("/");
+    return index >= 0 ? path.substring(0, index) : "";
+}
+
+function basename(path: string) {
+    return path.substring(path.lastIndexOf("/") + 1);
+}
+
+// relative path between two res:// paths
+function relative(from_dir: string, to: string) {
+    const from_parts = from_dir.substring("res://".length).split("/").filter(p => p.length != 0);
+    const to_parts = to.substring("res://".length).split("/");
+    let common = 0;
+    while (common < from_parts.length && common < to_parts.length - 1 && from_parts[common] == to_parts[common]) {
+        ++common;
+    }
+    return [...from_parts.slice(common).map(_ => ".."), ...to_parts.slice(common)].join("/");
+}
+
+class Transpiler {
+    private _ts: any;
+    private _options: any;
+    private _config_hash = "";
+    private _cache_path = "";
+    private _cache!: TranspileCache;
+
+    constructor() {
+        const start = Date.now();
+        this._ts = require("typescript");
+        console.log(`typescript ${this._ts.version} loaded (${Date.now() - start}ms)`);
+    }
+
+    private load_options() {
+        const config_path = "res://tsconfig.json";
+        const config_hash = FileAccess.file_exists(config_path) ? FileAccess.get_md5(config_path) : "";
+        if (typeof this._options !== "undefined" && config_hash == this._config_hash) {
+            return;
+        }
+
+        const ts = this._ts;
+        let compiler_options = {};
+        if (config_hash.length != 0) {
+            const parsed = ts.parseConfigFileTextToJson(config_path, FileAccess.get_file_as_string(config_path));
+            if (parsed.error) {
+                console.warn("failed to parse tsconfig.json", ts.flattenDiagnosticMessageText(parsed.error.messageText, "\n"));
+            } else if (parsed.config && parsed.config.compilerOptions) {
+                compiler_options = parsed.config.compilerOptions;
+            }
+        }
+        const converted = ts.convertCompilerOptionsFromJson(compiler_options, "res://");
+        this._options = converted.options;
+
+        // transpile-only options (outDir and declarations are handled here instead)
+        this._options.sourceMap = true;
+        this._options.inlineSourceMap = false;
+        this._options.declaration = false;
+        this._options.noEmit = false;
+        // references to a `const enum` declared in other files are not inlined by `transpileModule`,
+        // they're emitted as property accesses on the imported enum which must exist at runtime
+        this._options.preserveConstEnums = true;
+        this._config_hash = config_hash;
+    }
+
+    private load_cache(cache_path: string) {
+        if (this._cache_path == cache_path && typeof this._cache !== "undefined" && this._cache.config == this._config_hash) {
+            return;
+        }
+        this._cache_path = cache_path;
+        this._cache = { version: TranspileCacheVersion, config: this._config_hash, sources: {} };
+        if (!FileAccess.file_exists(cache_path)) {
+            return;
+        }
+        try {
+            const cache: TranspileCache = JSON.parse(FileAccess.get_file_as_string(cache_path));
+            if (cache.version === TranspileCacheVersion && cache.config === this._config_hash) {
+                this._cache = cache;
+            }
+        } catch (error) {
+            console.warn("failed to read transpile cache", error);
+        }
+    }
+
+    private write_file(path: string, text: string) {
+        DirAccess.make_dir_recursive_absolute(dirname(path));
+        const file = FileAccess.open(path, FileAccess.ModeFlags.WRITE);
+        if (!file) {
+            throw new Error(`can not write ${path}`);
+        }
+        file.store_string(text);
+        file.close();
+    }
+
+    transpile(request: TranspileRequest): TranspileResult {
+        const start = Date.now();
+        const result: TranspileResult = { transpiled: [], errors: [], elapsed: 0 };
+        this.load_options();
+        this.load_cache(request.cache_path);
+
+        let dirty = false;
+        for (let file of request.files) {
+            try {
+                if (!FileAccess.file_exists(file.source)) {
+                    continue;
+                }
+                const hash = FileAccess.get_md5(file.source);
+                if (this._cache.sources[file.source] === hash && FileAccess.file_exists(file.output)) {
+                    continue;
+                }
+
+                const output = this._ts.transpileModule(FileAccess.get_file_as_string(file.source), {
+                    compilerOptions: this._options,
+                    fileName: basename(file.source),
+                    reportDiagnostics: false,
+                });
+
+                // locate the source in the same way as tsc does with `rootDir: "./"`
+                const source_map = JSON.parse(output.sourceMapText);
+                source_map.file = basename(file.output);
+                source_map.sources = [relative(this._options.sourceRoot ? "res://" : dirname(file.output), file.source)];
+                this.write_file(file.output, output.outputText);
+                this.write_file(file.output + ".map", JSON.stringify(source_map));
+
+                this._cache.sources[file.source] = hash;
+                dirty = true;
+                result.transpiled.push(file.source);
+            } catch (error) {
+                result.errors.push({ source: file.source, message: `${error}` });
+            }
+        }
+
+        if (dirty) {
+            this.write_file(this._cache_path, JSON.stringify(this._cache));
+        }
+        result.elapsed = Date.now() - start;
+        return result;
+    }
+}
+
+// run as worker script
+if (typeof JSWorkerParent !== "undefined") {
+    const parent = JSWorkerParent;
+    let transpiler: Transpiler | undefined;
+    parent.onmessage = function (request: TranspileRequest) {
+        let result: TranspileResult;
+        try {
+            if (typeof transpiler === "undefined") {
+                transpiler = new Transpiler();
+            }
+            result = transpiler.transpile(request);
+        } catch (error) {
+            result = { transpiled: [], errors: request.files.map(file => ({ source: file.source, message: `${error}` })), elapsed: 0 };
+        }
+        parent.postMessage(result);
+    }
+}
@@ -43,11 +43,12 @@ export function TypePair(key: ClassDescriptor, value: ClassDescriptor): TypePair
 export type ClassDescriptor = Function | Symbol | EnumPlaceholder | TypePairPlaceholder;
 
 /**
- *
+ * @param argument_names (optional) names of the signal arguments, they're listed in the editor
+ *                       and a change of the argument count requires a full reload of live instances
  */
-export function signal() {
+export function signal(...argument_names: string[]) {
     return function (target: any, key: string) {
-        jsb.internal.add_script_signal(target, key);
+        jsb.internal.add_script_signal(target, key, argument_names);
     }
 }
 
@@ -67,6 +67,72 @@ require("godot.typeloader").on_type_loaded("Signal", function (type: any) {
     }
 });
 
+Object.defineProperty(require("godot-jsb"), "fs", {
+    value: {
+        read: function (path: string): Promise<ArrayBuffer> {
+            return new Promise(function (resolve, reject) {
+                require("godot-jsb").internal.read_file_async(path, function (error: string | undefined, data: ArrayBuffer | undefined) {
+                    if (typeof error !== "undefined") {
+                        reject(new Error(`failed to read ${path}: ${error}`));
+                        return;
+                    }
+                    resolve(<ArrayBuffer>data);
+                });
+            });
+        }
+    }
+});
+
+Object.defineProperty(require("godot-jsb"), "json", {
+    value: {
+        parseAsync: function (text: any): Promise<any> {
+            return new Promise(function (resolve, reject) {
+                require("godot-jsb").internal.parse_json_async(text, function (error: string | undefined, data: any) {
+                    if (typeof error !== "undefined") {
+                        reject(new SyntaxError(`failed to parse JSON: ${error}`));
+                        return;
+                    }
+                    resolve(data);
+                });
+            });
+        },
+        stringifyToBuffer: function (value: any, space?: string | number): any {
+            return require("godot-jsb").internal.stringify_json(value, space);
+        },
+        stringifyToFile: function (path: string, value: any, space?: string | number): boolean {
+            return require("godot-jsb").internal.stringify_json_to_file(path, value, space);
+        }
+    }
+});
+
+Object.defineProperty(require("godot-jsb"), "load", {
+    value: function (path: string, options?: { type_hint?: string, priority?: number }): any {
+        const internal = require("godot-jsb").internal;
+        let token: number | undefined;
+        let reject_fn: ((reason: any) => void) | undefined;
+        const promise: any = new Promise(function (resolve, reject) {
+            reject_fn = reject;
+            token = internal.load_resource_async(path, options?.type_hint ?? "", (options?.priority ?? 0) > 0, function (error: string | undefined, resource: any) {
+                token = undefined;
+                if (typeof error !== "undefined") {
+                    reject(new Error(`failed to load ${path}: ${error}`));
+                    return;
+                }
+                resolve(resource);
+            });
+        });
+        promise.cancel = function (): boolean {
+            if (typeof token === "undefined" || !internal.cancel_load_resource(token)) {
+                return false;
+            }
+            token = undefined;
+            (<(reason: any) => void>reject_fn)(new Error(`loading ${path} is cancelled`));
+            return true;
+        };
+        return promise;
+    }
+});
+
 Object.defineProperty(require("godot"), "GLOBAL_GET", {
     value: function (entry_path: string): any {
         return require("godot").ProjectSettings.get_setting_with_override(entry_path);
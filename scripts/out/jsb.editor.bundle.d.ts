@@ -5,8 +5,12 @@ declare module "jsb.editor.codegen" {
             [name: string]: jsb.editor.SingletonInfo;
         };
         classes: {
+            [name: string]: jsb.editor.ClassDumpEntry;
+        };
+        class_infos: {
             [name: string]: jsb.editor.ClassInfo;
         };
+        hash: string;
         primitive_types: {
             [name: string]: jsb.editor.PrimitiveClassInfo;
         };
@@ -23,6 +27,7 @@ declare module "jsb.editor.codegen" {
             [name: string]: jsb.editor.ClassDoc | false;
         };
         constructor();
+        get_class(class_name: string): jsb.editor.ClassInfo | undefined;
         find_doc(class_name: string): jsb.editor.ClassDoc | undefined;
         is_primitive_type(name: string): boolean;
         is_valid_method_name(name: string): boolean;
@@ -41,8 +46,19 @@ declare module "jsb.editor.codegen" {
         private _outDir;
         private _splitter;
         private _types;
-        constructor(outDir: string);
+        private _cache_path;
+        private _cache;
+        private _next_cache;
+        private _stats;
+        /**
+         * @param outDir the directory of generated files
+         * @param cachePath the path of codegen cache, only changed classes are emitted again if available
+         */
+        constructor(outDir: string, cachePath?: string);
+        private load_cache;
+        private save_cache;
         private make_path;
+        private close_splitter;
         private new_splitter;
         private split;
         private cleanup;
@@ -55,10 +71,45 @@ declare module "jsb.editor.codegen" {
         private emit_godot;
         private emit_godot_primitive;
         private emit_godot_class;
+        private emit_godot_class_content;
     }
 }
+declare module "jsb.editor.codegen.worker" {
+    /**
+     * generate godot.d.ts in a worker thread, the editor is not blocked while generating.
+     * @returns false if the previous generation is still in progress
+     */
+    export function emit_in_worker(out_dir: string, cache_path: string): boolean;
+}
 declare module "jsb.editor.main" {
-    import { PackedStringArray } from "godot";
-    export function auto_complete(pattern: string): PackedStringArray;
+    /**
+     * evaluate the source as a global script (for REPL), top-level declarations (let/const/class) are visible to later inputs.
+     * if the result is a promise, the settled value is printed to the console when it arrives.
+     * `await` is allowed at the top level, see `transform_top_level_await`.
+     */
+    export function repl_eval(source: string): any;
+    /**
+     * rewrite the source into an async function if `await` is used at the top level (not in nested functions or classes),
+     * top-level declarations are hoisted out of the function to keep them in the global scope (like the REPL of node.js).
+     * the value of the last expression statement is the result of the returned promise.
+     * @returns undefined if `await` is not used at the top level (or the parser is not available)
+     */
+    export function transform_top_level_await(source: string): string | undefined;
     export function run_npm_install(): void;
 }
+declare module "jsb.editor.transpile" {
+    export interface TranspileFile {
+        source: string;
+        output: string;
+    }
+    /**
+     * transpile (without type-checking) typescript sources one by one in a dedicated worker,
+     * the typescript compiler is loaded once in the worker and reused for all later requests.
+     * changed scripts are marked as reloading when the outputs are written.
+     * NOTE each file is transpiled in isolation (`isolatedModules`), `const enum` can not be inlined across files,
+     *      it's preserved as a real enum object instead. an ambient `declare const enum` has no value at runtime and is not supported.
+     * @returns false if the request is queued because the previous one is still in progress
+     */
+    export function transpile_in_worker(files: TranspileFile[], cache_path: string): boolean;
+    export function terminate_worker(): void;
+}
@@ -21,6 +21,9 @@ var __importStar = (this && this.__importStar) || function (mod) {
     __setModuleDefault(result, mod);
     return result;
 };
+var __importDefault = (this && this.__importDefault) || function (mod) {
+    return (mod && mod.__esModule) ? mod : { "default": mod };
+};
 define("jsb.editor.codegen", ["require", "exports", "godot", "godot-jsb"], function (require, exports, godot_1, jsb) {
     "use strict";
     Object.defineProperty(exports, "__esModule", { value: true });
@@ -31,6 +34,8 @@ define("jsb.editor.codegen", ["require", "exports", "godot", "godot-jsb"], funct
     }
     const tab = "    ";
     const GodotAnyType = "GAny";
+    // bump it if the output of codegen is changed, all cached classes will be emitted again
+    const CodeGenCacheVersion = 1;
     const MockLines = [
         "type byte = number",
         "type int32 = number",
@@ -601,38 +606,45 @@ define("jsb.editor.codegen", ["require", "exports", "godot", "godot-jsb"], funct
             this.line(`${name} = ${value},`);
         }
     }
-    class FileWriter extends AbstractWriter {
-        constructor(types, file) {
+    // collect lines in memory (for the content of a generated file, or the cached content of a class)
+    class BufferWriter extends AbstractWriter {
+        constructor(types) {
             super();
+            this._lines = [];
             this._size = 0;
-            this._lineno = 0;
             this._types = types;
-            this._file = file;
         }
         get size() { return this._size; }
-        get lineno() { return this._lineno; }
+        get lineno() { return this._lines.length; }
         get types() { return this._types; }
+        get lines() { return this._lines; }
         line(text) {
-            this._file.store_line(text);
+            this._lines.push(text);
             this._size += text.length;
-            this._lineno += 1;
-        }
-        finish() {
-            this._file.flush();
         }
+        finish() { }
     }
     class FileSplitter {
         constructor(types, filePath) {
-            this._types = types;
-            this._file = godot_1.FileAccess.open(filePath, godot_1.FileAccess.ModeFlags.WRITE);
-            this._toplevel = new ModuleWriter(new FileWriter(this._types, this._file), "godot");
-            this._file.store_line("// AUTO-GENERATED");
-            this._file.store_line('/// <reference no-default-lib="true"/>');
+            this._path = filePath;
+            this._buffer = new BufferWriter(types);
+            this._toplevel = new ModuleWriter(this._buffer, "godot");
         }
+        /**
+         * write the file only if the content is changed,
+         * so that unchanged files will not be reloaded by VSCode TS server and file watchers.
+         * @returns false if the file is unchanged
+         */
         close() {
             this._toplevel.finish();
-            this._file.flush();
-            this._file.close();
+            const text = ["// AUTO-GENERATED", '/// <reference no-default-lib="true"/>', ...this._buffer.lines, ""].join("\n");
+            if (godot_1.FileAccess.file_exists(this._path) && godot_1.FileAccess.get_file_as_string(this._path) == text) {
+                return false;
+            }
+            const file = godot_1.FileAccess.open(this._path, godot_1.FileAccess.ModeFlags.WRITE);
+            file.store_string(text);
+            file.close();
+            return true;
         }
         get_writer() {
             return this._toplevel;
@@ -643,14 +655,17 @@ define("jsb.editor.codegen", ["require", "exports", "godot", "godot-jsb"], funct
     class TypeDB {
         constructor() {
             this.singletons = {};
+            // brief of all godot classes, the full class info is loaded lazily with `get_class`
             this.classes = {};
+            this.class_infos = {};
             this.primitive_types = {};
             this.primitive_type_names = {};
             this.globals = {};
             this.utilities = {};
             // `class_doc` is loaded lazily once used, and be cached in `class_docs`
             this.class_docs = {};
-            const classes = jsb.editor.get_classes();
+            const dump = JSON.parse(jsb.editor.get_class_dump());
+            const classes = dump.classes;
             const primitive_types = jsb.editor.get_primitive_types();
             const singletons = jsb.editor.get_singletons();
             const globals = jsb.editor.get_global_constants();
@@ -671,6 +686,15 @@ define("jsb.editor.codegen", ["require", "exports", "godot", "godot-jsb"], funct
             for (let utility of utilities) {
                 this.utilities[utility.name] = utility;
             }
+            this.hash = dump.hash;
+        }
+        get_class(class_name) {
+            let class_info = this.class_infos[class_name];
+            if (typeof class_info === "undefined" && typeof this.classes[class_name] !== "undefined") {
+                class_info = jsb.editor.get_class_info(class_name);
+                this.class_infos[class_name] = class_info;
+            }
+            return class_info;
         }
         find_doc(class_name) {
             let class_doc = this.class_docs[class_name];
@@ -714,7 +738,7 @@ define("jsb.editor.codegen", ["require", "exports", "godot", "godot-jsb"], funct
                             return class_name;
                         }
                         const cls = types.classes[layers[0]];
-                        if (typeof cls !== "undefined" && cls.enums.findIndex(v => v.name == layers[1]) >= 0) {
+                        if (typeof cls !== "undefined" && cls.enums.indexOf(layers[1]) >= 0) {
                             return class_name;
                         }
                     }
@@ -864,10 +888,43 @@ define("jsb.editor.codegen", ["require", "exports", "godot", "godot-jsb"], funct
     exports.TypeDB = TypeDB;
     // d.ts generator
     class TSDCodeGen {
-        constructor(outDir) {
+        /**
+         * @param outDir the directory of generated files
+         * @param cachePath the path of codegen cache, only changed classes are emitted again if available
+         */
+        constructor(outDir, cachePath) {
+            this._stats = { emitted: 0, reused: 0, written: 0 };
             this._split_index = 0;
             this._outDir = outDir;
             this._types = new TypeDB();
+            this._cache_path = cachePath;
+            this._cache = this.load_cache();
+            this._next_cache = { version: CodeGenCacheVersion, hash: this._types.hash, classes: {} };
+        }
+        load_cache() {
+            const empty = { version: CodeGenCacheVersion, hash: this._types.hash, classes: {} };
+            if (typeof this._cache_path !== "string" || !godot_1.FileAccess.file_exists(this._cache_path)) {
+                return empty;
+            }
+            try {
+                const cache = JSON.parse(godot_1.FileAccess.get_file_as_string(this._cache_path));
+                if (cache.version === CodeGenCacheVersion && cache.hash === this._types.hash) {
+                    return cache;
+                }
+                console.log("codegen cache is outdated");
+            }
+            catch (error) {
+                console.warn("failed to read codegen cache", error);
+            }
+            return empty;
+        }
+        save_cache() {
+            if (typeof this._cache_path !== "string") {
+                return;
+            }
+            if (!jsb.json.stringifyToFile(this._cache_path, this._next_cache)) {
+                console.warn("failed to write codegen cache", this._cache_path);
+            }
         }
         make_path(index) {
             const filename = `godot${index}.gen.d.ts`;
@@ -879,10 +936,13 @@ define("jsb.editor.codegen", ["require", "exports", "godot", "godot-jsb"], funct
             }
             return this._outDir + "/" + filename;
         }
-        new_splitter() {
-            if (this._splitter !== undefined) {
-                this._splitter.close();
+        close_splitter() {
+            if (this._splitter !== undefined && this._splitter.close()) {
+                ++this._stats.written;
             }
+        }
+        new_splitter() {
+            this.close_splitter();
             const filename = this.make_path(this._split_index++);
             console.log("new writer", filename);
             this._splitter = new FileSplitter(this._types, filename);
@@ -915,14 +975,15 @@ define("jsb.editor.codegen", ["require", "exports", "godot", "godot-jsb"], funct
             return typeof name === "string" && typeof this._types.classes[name] !== "undefined";
         }
         emit() {
-            var _a;
             this.emit_mock();
             this.emit_singletons();
             this.emit_godot();
             this.emit_globals();
             this.emit_utilities();
-            (_a = this._splitter) === null || _a === void 0 ? void 0 : _a.close();
+            this.close_splitter();
             this.cleanup();
+            this.save_cache();
+            console.log(`godot classes: ${this._stats.emitted} emitted, ${this._stats.reused} reused from cache, ${this._stats.written} files written`);
         }
         emit_mock() {
             const cg = this.split();
@@ -945,10 +1006,10 @@ define("jsb.editor.codegen", ["require", "exports", "godot", "godot-jsb"], funct
             const cg = this.split();
             for (let singleton_name in this._types.singletons) {
                 const singleton = this._types.singletons[singleton_name];
-                const cls = this._types.classes[singleton.class_name];
-                if (typeof cls !== "undefined") {
+                const entry = this._types.classes[singleton.class_name];
+                if (typeof entry !== "undefined") {
                     cg.line_comment_(`_singleton_class_: ${singleton.class_name}`);
-                    this.emit_godot_class(cg, cls, true);
+                    this.emit_godot_class(cg, entry, true);
                 }
                 else {
                     cg.line_comment_(`ERROR: singleton ${singleton.name} without class info ${singleton.class_name}`);
@@ -991,7 +1052,7 @@ define("jsb.editor.codegen", ["require", "exports", "godot", "godot-jsb"], funct
         }
         emit_godot() {
             for (let class_name in this._types.classes) {
-                const cls = this._types.classes[class_name];
+                const entry = this._types.classes[class_name];
                 if (IgnoredTypes.has(class_name)) {
                     continue;
                 }
@@ -999,7 +1060,7 @@ define("jsb.editor.codegen", ["require", "exports", "godot", "godot-jsb"], funct
                     // ignore the class if it's already defined as Singleton
                     continue;
                 }
-                this.emit_godot_class(this.split(), cls, false);
+                this.emit_godot_class(this.split(), entry, false);
             }
             for (let class_name in this._types.primitive_types) {
                 const cls = this._types.primitive_types[class_name];
@@ -1088,7 +1149,25 @@ define("jsb.editor.codegen", ["require", "exports", "godot", "godot-jsb"], funct
             }
             class_cg.finish();
         }
-        emit_godot_class(cg, cls, singleton_mode) {
+        // reuse the cached lines if the class is unchanged, otherwise emit the class again
+        emit_godot_class(cg, entry, singleton_mode) {
+            const key = singleton_mode ? `singleton:${entry.name}` : entry.name;
+            let cached = this._cache.classes[key];
+            if (typeof cached === "undefined" || cached.hash !== entry.hash) {
+                const buffer = new BufferWriter(this._types);
+                this.emit_godot_class_content(buffer, this._types.get_class(entry.name), singleton_mode);
+                cached = { hash: entry.hash, lines: buffer.lines };
+                ++this._stats.emitted;
+            }
+            else {
+                ++this._stats.reused;
+            }
+            this._next_cache.classes[key] = cached;
+            for (let line of cached.lines) {
+                cg.line(line);
+            }
+        }
+        emit_godot_class_content(cg, cls, singleton_mode) {
             try {
                 const class_doc = this._types.find_doc(cls.name);
                 const ignored_consts = new Set();
@@ -1140,39 +1219,187 @@ define("jsb.editor.codegen", ["require", "exports", "godot", "godot-jsb"], funct
     }
     exports.default = TSDCodeGen;
 });
-define("jsb.editor.main", ["require", "exports", "godot"], function (require, exports, godot_2) {
+define("jsb.editor.codegen.worker", ["require", "exports", "godot-jsb", "godot.worker", "jsb.editor.codegen"], function (require, exports, jsb, godot_worker_1, jsb_editor_codegen_1) {
+    "use strict";
+    Object.defineProperty(exports, "__esModule", { value: true });
+    exports.emit_in_worker = emit_in_worker;
+    jsb = __importStar(jsb);
+    jsb_editor_codegen_1 = __importDefault(jsb_editor_codegen_1);
+    // the worker is given up if no result is received in time (ms),
+    // the master is not notified if the worker dies without a message (e.g. failed to load the worker script)
+    const CodeGenTimeout = 5 * 60 * 1000;
+    let running_worker;
+    function finish_worker(worker) {
+        if (running_worker !== worker) {
+            return false;
+        }
+        running_worker = undefined;
+        worker.terminate();
+        jsb.editor.release_class_snapshot();
+        return true;
+    }
+    /**
+     * generate godot.d.ts in a worker thread, the editor is not blocked while generating.
+     * @returns false if the previous generation is still in progress
+     */
+    function emit_in_worker(out_dir, cache_path) {
+        if (typeof running_worker !== "undefined") {
+            console.warn("godot.d.ts generation is already in progress");
+            return false;
+        }
+        // the worker reads the class data from the snapshot, ClassDB is not accessible off the main thread
+        jsb.editor.take_class_snapshot();
+        const worker = new godot_worker_1.JSWorker("jsb.editor.codegen.worker");
+        running_worker = worker;
+        const timeout = setTimeout(function () {
+            if (finish_worker(worker)) {
+                console.error(`failed to generate godot.d.ts: no response from the worker in ${CodeGenTimeout}ms`);
+            }
+        }, CodeGenTimeout);
+        worker.onmessage = function (result) {
+            clearTimeout(timeout);
+            if (!finish_worker(worker)) {
+                return;
+            }
+            if (typeof result.error === "string") {
+                console.error("failed to generate godot.d.ts:", result.error);
+            }
+            else {
+                console.log(`godot.d.ts generated successfully (${result.elapsed}ms)`);
+            }
+        };
+        worker.postMessage({ out_dir: out_dir, cache_path: cache_path });
+        return true;
+    }
+    // run as worker script
+    if (typeof godot_worker_1.JSWorkerParent !== "undefined") {
+        const parent = godot_worker_1.JSWorkerParent;
+        parent.onmessage = function (request) {
+            const start = Date.now();
+            let result;
+            try {
+                new jsb_editor_codegen_1.default(request.out_dir, request.cache_path).emit();
+                result = { elapsed: Date.now() - start };
+            }
+            catch (error) {
+                result = { error: `${error}`, elapsed: Date.now() - start };
+            }
+            parent.postMessage(result);
+        };
+    }
+});
+define("jsb.editor.main", ["require", "exports", "godot", "godot-jsb"], function (require, exports, godot_2, jsb) {
     "use strict";
     Object.defineProperty(exports, "__esModule", { value: true });
-    exports.auto_complete = auto_complete;
+    exports.repl_eval = repl_eval;
+    exports.transform_top_level_await = transform_top_level_await;
     exports.run_npm_install = run_npm_install;
-    function auto_complete(pattern) {
-        let results = new godot_2.PackedStringArray();
-        if (typeof pattern !== "string") {
-            return results;
-        }
-        let scope = null;
-        let head = '';
-        let index = pattern.lastIndexOf('.');
-        let left = '';
-        if (index >= 0) {
-            left = pattern.substring(0, index + 1);
+    jsb = __importStar(jsb);
+    /**
+     * evaluate the source as a global script (for REPL), top-level declarations (let/const/class) are visible to later inputs.
+     * if the result is a promise, the settled value is printed to the console when it arrives.
+     * `await` is allowed at the top level, see `transform_top_level_await`.
+     */
+    function repl_eval(source) {
+        const async_source = transform_top_level_await(source);
+        const result = jsb.internal.eval_script(typeof async_source !== "undefined" ? async_source : source, "repl");
+        if (result instanceof Promise) {
+            result.then(value => console.log(value), reason => console.error(reason));
+            return "Promise { <pending> }";
+        }
+        return result;
+    }
+    /**
+     * rewrite the source into an async function if `await` is used at the top level (not in nested functions or classes),
+     * top-level declarations are hoisted out of the function to keep them in the global scope (like the REPL of node.js).
+     * the value of the last expression statement is the result of the returned promise.
+     * @returns undefined if `await` is not used at the top level (or the parser is not available)
+     */
+    function transform_top_level_await(source) {
+        // the parser is only used if the word `await` appears anywhere (including strings and comments)
+        if (!/\bawait\b/.test(source)) {
+            return undefined;
+        }
+        const ts = get_typescript();
+        if (!ts) {
+            return undefined;
+        }
+        const file = ts.createSourceFile("repl.js", source, ts.ScriptTarget.Latest, false, ts.ScriptKind.JS);
+        if (!contains_top_level_await(ts, file)) {
+            return undefined;
+        }
+        const hoisted = [];
+        const edits = [];
+        const statements = file.statements;
+        for (let i = 0; i < statements.length; ++i) {
+            const statement = statements[i];
+            const start = statement.getStart(file);
+            if (ts.isVariableStatement(statement)) {
+                // `const a = 1, { b } = c;` => `let a, b;` + `void (a = 1, { b } = c);`
+                const is_block_scoped = (statement.declarationList.flags & ts.NodeFlags.BlockScoped) != 0;
+                const names = [];
+                const assignments = [];
+                for (const declaration of statement.declarationList.declarations) {
+                    collect_binding_names(ts, declaration.name, names);
+                    if (declaration.initializer) {
+                        assignments.push(`${declaration.name.getText(file)} = ${declaration.initializer.getText(file)}`);
+                    }
+                }
+                hoisted.push(`${is_block_scoped ? "let" : "var"} ${names.join(", ")};`);
+                edits.push({ start: start, end: statement.end, text: assignments.length != 0 ? `void (${assignments.join(", ")});` : "" });
+            }
+            else if ((ts.isClassDeclaration(statement) || ts.isFunctionDeclaration(statement)) && statement.name) {
+                // `class A {}` => `let A;` + `A = class A {}`
+                const name = statement.name.text;
+                hoisted.push(`${ts.isClassDeclaration(statement) ? "let" : "var"} ${name};`);
+                edits.push({ start: start, end: start, text: `${name} = ` });
+            }
+            else if (i == statements.length - 1 && ts.isExpressionStatement(statement)) {
+                edits.push({ start: start, end: statement.end, text: `return (${statement.expression.getText(file)});` });
+            }
+        }
+        let body = source;
+        for (let i = edits.length - 1; i >= 0; --i) {
+            const edit = edits[i];
+            body = body.substring(0, edit.start) + edit.text + body.substring(edit.end);
+        }
+        return `${hoisted.join(" ")}\n(async () => {\n${body}\n})()`;
+    }
+    let typescript_module;
+    // typescript (in node_modules of the project) is loaded on demand, it's only used as the parser here
+    function get_typescript() {
+        if (typeof typescript_module === "undefined") {
             try {
-                scope = eval(pattern.substring(0, index));
+                typescript_module = require("typescript");
             }
-            catch (e) {
-                return results;
+            catch (error) {
+                console.warn("top-level await in REPL requires typescript to be installed", error);
+                typescript_module = null;
             }
-            pattern = pattern.substring(index + 1);
         }
-        else {
-            scope = globalThis;
+        return typescript_module;
+    }
+    function contains_top_level_await(ts, node) {
+        if (ts.isAwaitExpression(node) || (ts.isForOfStatement(node) && node.awaitModifier)) {
+            return true;
+        }
+        // `await` in nested functions or classes is not at the top level
+        if (ts.isFunctionLike(node) || ts.isClassLike(node)) {
+            return false;
         }
-        for (let k in scope) {
-            if (k.indexOf(pattern) == 0) {
-                results.append(head + left + k);
+        return !!ts.forEachChild(node, (child) => contains_top_level_await(ts, child) || undefined);
+    }
+    function collect_binding_names(ts, name, names) {
+        if (ts.isIdentifier(name)) {
+            names.push(name.text);
+            return;
+        }
+        // object or array binding pattern
+        for (const element of name.elements) {
+            if (!ts.isOmittedExpression(element)) {
+                collect_binding_names(ts, element.name, names);
             }
         }
-        return results;
     }
     function run_npm_install() {
         let exe_path = godot_2.OS.get_name() != "Windows" ? "npm" : "npm.cmd";
@@ -1185,4 +1412,242 @@ define("jsb.editor.main", ["require", "exports", "godot"], function (require, ex
         }
     }
 });
+define("jsb.editor.transpile", ["require", "exports", "godot", "godot.worker"], function (require, exports, godot_3, godot_worker_2) {
+    "use strict";
+    Object.defineProperty(exports, "__esModule", { value: true });
+    exports.transpile_in_worker = transpile_in_worker;
+    exports.terminate_worker = terminate_worker;
+    const TranspileCacheVersion = 2;
+    // the worker is terminated if no result is received in time (ms),
+    // the master is not notified if the worker dies without a message (e.g. failed to load the typescript compiler)
+    const TranspileTimeout = 5 * 60 * 1000;
+    let transpile_worker;
+    let transpile_timeout;
+    let running = false;
+    let pending;
+    let pending_cache_path = "";
+    /**
+     * transpile (without type-checking) typescript sources one by one in a dedicated worker,
+     * the typescript compiler is loaded once in the worker and reused for all later requests.
+     * changed scripts are marked as reloading when the outputs are written.
+     * NOTE each file is transpiled in isolation (`isolatedModules`), `const enum` can not be inlined across files,
+     *      it's preserved as a real enum object instead. an ambient `declare const enum` has no value at runtime and is not supported.
+     * @returns false if the request is queued because the previous one is still in progress
+     */
+    function transpile_in_worker(files, cache_path) {
+        if (running) {
+            if (typeof pending === "undefined") {
+                pending = {};
+            }
+            for (let file of files) {
+                pending[file.source] = file;
+            }
+            pending_cache_path = cache_path;
+            return false;
+        }
+        if (typeof transpile_worker === "undefined") {
+            const worker = new godot_worker_2.JSWorker("jsb.editor.transpile");
+            transpile_worker = worker;
+            worker.onmessage = function (result) {
+                if (transpile_worker !== worker) {
+                    // a late result from a worker already given up
+                    return;
+                }
+                clearTimeout(transpile_timeout);
+                transpile_timeout = undefined;
+                running = false;
+                on_transpiled(result);
+                flush_pending();
+            };
+        }
+        running = true;
+        transpile_worker.postMessage({ files: files, cache_path: cache_path });
+        transpile_timeout = setTimeout(function () {
+            transpile_timeout = undefined;
+            console.error(`failed to transpile ${files.length} scripts: no response from the worker in ${TranspileTimeout}ms`);
+            reset_worker();
+            // the queued requests are sent to a new worker
+            flush_pending();
+        }, TranspileTimeout);
+        return true;
+    }
+    function terminate_worker() {
+        reset_worker();
+        pending = undefined;
+    }
+    function reset_worker() {
+        if (typeof transpile_timeout !== "undefined") {
+            clearTimeout(transpile_timeout);
+            transpile_timeout = undefined;
+        }
+        if (typeof transpile_worker !== "undefined") {
+            transpile_worker.terminate();
+            transpile_worker = undefined;
+        }
+        running = false;
+    }
+    function flush_pending() {
+        if (typeof pending !== "undefined") {
+            const next = Object.keys(pending).map(source => pending[source]);
+            pending = undefined;
+            transpile_in_worker(next, pending_cache_path);
+        }
+    }
+    function on_transpiled(result) {
+        for (let error of result.errors) {
+            console.error(`failed to transpile ${error.source}:`, error.message);
+        }
+        for (let source of result.transpiled) {
+            // scripts not loaded yet will read the latest output when loading
+            if (godot_3.ResourceLoader.has_cached(source)) {
+                const script = godot_3.ResourceLoader.load(source);
+                script.reload(true);
+            }
+        }
+        if (result.transpiled.length != 0) {
+            console.log(`${result.transpiled.length} scripts transpiled (${result.elapsed}ms)`);
+        }
+    }
+    function dirname(path) {
+        const index = path.lastIndexOf("/");
+        return index >= 0 ? path.substring(0, index) : "";
+    }
+    function basename(path) {
+        return path.substring(path.lastIndexOf("/") + 1);
+    }
+    // relative path between two res:// paths
+    function relative(from_dir, to) {
+        const from_parts = from_dir.substring("res://".length).split("/").filter(p => p.length != 0);
+        const to_parts = to.substring("res://".length).split("/");
+        let common = 0;
+        while (common < from_parts.length && common < to_parts.length - 1 && from_parts[common] == to_parts[common]) {
+            ++common;
+        }
+        return [...from_parts.slice(common).map(_ => ".."), ...to_parts.slice(common)].join("/");
+    }
+    class Transpiler {
+        constructor() {
+            this._config_hash = "";
+            this._cache_path = "";
+            const start = Date.now();
+            this._ts = require("typescript");
+            console.log(`typescript ${this._ts.version} loaded (${Date.now() - start}ms)`);
+        }
+        load_options() {
+            const config_path = "res://tsconfig.json";
+            const config_hash = godot_3.FileAccess.file_exists(config_path) ? godot_3.FileAccess.get_md5(config_path) : "";
+            if (typeof this._options !== "undefined" && config_hash == this._config_hash) {
+                return;
+            }
+            const ts = this._ts;
+            let compiler_options = {};
+            if (config_hash.length != 0) {
+                const parsed = ts.parseConfigFileTextToJson(config_path, godot_3.FileAccess.get_file_as_string(config_path));
+                if (parsed.error) {
+                    console.warn("failed to parse tsconfig.json", ts.flattenDiagnosticMessageText(parsed.error.messageText, "\n"));
+                }
+                else if (parsed.config && parsed.config.compilerOptions) {
+                    compiler_options = parsed.config.compilerOptions;
+                }
+            }
+            const converted = ts.convertCompilerOptionsFromJson(compiler_options, "res://");
+            this._options = converted.options;
+            // transpile-only options (outDir and declarations are handled here instead)
+            this._options.sourceMap = true;
+            this._options.inlineSourceMap = false;
+            this._options.declaration = false;
+            this._options.noEmit = false;
+            // references to a `const enum` declared in other files are not inlined by `transpileModule`,
+            // they're emitted as property accesses on the imported enum which must exist at runtime
+            this._options.preserveConstEnums = true;
+            this._config_hash = config_hash;
+        }
+        load_cache(cache_path) {
+            if (this._cache_path == cache_path && typeof this._cache !== "undefined" && this._cache.config == this._config_hash) {
+                return;
+            }
+            this._cache_path = cache_path;
+            this._cache = { version: TranspileCacheVersion, config: this._config_hash, sources: {} };
+            if (!godot_3.FileAccess.file_exists(cache_path)) {
+                return;
+            }
+            try {
+                const cache = JSON.parse(godot_3.FileAccess.get_file_as_string(cache_path));
+                if (cache.version === TranspileCacheVersion && cache.config === this._config_hash) {
+                    this._cache = cache;
+                }
+            }
+            catch (error) {
+                console.warn("failed to read transpile cache", error);
+            }
+        }
+        write_file(path, text) {
+            godot_3.DirAccess.make_dir_recursive_absolute(dirname(path));
+            const file = godot_3.FileAccess.open(path, godot_3.FileAccess.ModeFlags.WRITE);
+            if (!file) {
+                throw new Error(`can not write ${path}`);
+            }
+            file.store_string(text);
+            file.close();
+        }
+        transpile(request) {
+            const start = Date.now();
+            const result = { transpiled: [], errors: [], elapsed: 0 };
+            this.load_options();
+            this.load_cache(request.cache_path);
+            let dirty = false;
+            for (let file of request.files) {
+                try {
+                    if (!godot_3.FileAccess.file_exists(file.source)) {
+                        continue;
+                    }
+                    const hash = godot_3.FileAccess.get_md5(file.source);
+                    if (this._cache.sources[file.source] === hash && godot_3.FileAccess.file_exists(file.output)) {
+                        continue;
+                    }
+                    const output = this._ts.transpileModule(godot_3.FileAccess.get_file_as_string(file.source), {
+                        compilerOptions: this._options,
+                        fileName: basename(file.source),
+                        reportDiagnostics: false,
+                    });
+                    // locate the source in the same way as tsc does with `rootDir: "./"`
+                    const source_map = JSON.parse(output.sourceMapText);
+                    source_map.file = basename(file.output);
+                    source_map.sources = [relative(this._options.sourceRoot ? "res://" : dirname(file.output), file.source)];
+                    this.write_file(file.output, output.outputText);
+                    this.write_file(file.output + ".map", JSON.stringify(source_map));
+                    this._cache.sources[file.source] = hash;
+                    dirty = true;
+                    result.transpiled.push(file.source);
+                }
+                catch (error) {
+                    result.errors.push({ source: file.source, message: `${error}` });
+                }
+            }
+            if (dirty) {
+                this.write_file(this._cache_path, JSON.stringify(this._cache));
+            }
+            result.elapsed = Date.now() - start;
+            return result;
+        }
+    }
+    // run as worker script
+    if (typeof godot_worker_2.JSWorkerParent !== "undefined") {
+        const parent = godot_worker_2.JSWorkerParent;
+        let transpiler;
+        parent.onmessage = function (request) {
+            let result;
+            try {
+                if (typeof transpiler === "undefined") {
+                    transpiler = new Transpiler();
+                }
+                result = transpiler.transpile(request);
+            }
+            catch (error) {
+                result = { transpiled: [], errors: request.files.map(file => ({ source: file.source, message: `${error}` })), elapsed: 0 };
+            }
+            parent.postMessage(result);
+        };
+    }
+});
 //# sourceMappingURL=jsb.editor.bundle.js.map
\ No newline at end of file
@@ -9,9 +9,10 @@ declare module "godot.annotations" {
     export function TypePair(key: ClassDescriptor, value: ClassDescriptor): TypePairPlaceholder;
     export type ClassDescriptor = Function | Symbol | EnumPlaceholder | TypePairPlaceholder;
     /**
-     *
+     * @param argument_names (optional) names of the signal arguments, they're listed in the editor
+     *                       and a change of the argument count requires a full reload of live instances
      */
-    export function signal(): (target: any, key: string) => void;
+    export function signal(...argument_names: string[]): (target: any, key: string) => void;
     export function export_multiline(): (target: any, key: string) => void;
     export function export_range(min: number, max: number, step?: number, ...extra_hints: string[]): (target: any, key: string) => void;
     export function export_range_i(min: number, max: number, step?: number, ...extra_hints: string[]): (target: any, key: string) => void;
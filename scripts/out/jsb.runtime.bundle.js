@@ -79,11 +79,12 @@ define("godot.annotations", ["require", "exports", "godot", "godot-jsb"], functi
         return new EnumPlaceholderImpl([key, value]);
     }
     /**
-     *
+     * @param argument_names (optional) names of the signal arguments, they're listed in the editor
+     *                       and a change of the argument count requires a full reload of live instances
      */
-    function signal() {
+    function signal(...argument_names) {
         return function (target, key) {
-            jsb.internal.add_script_signal(target, key);
+            jsb.internal.add_script_signal(target, key, argument_names);
         };
     }
     function export_multiline() {
@@ -812,6 +813,70 @@ require("godot.typeloader").on_type_loaded("Signal", function (type) {
         });
     };
 });
+Object.defineProperty(require("godot-jsb"), "fs", {
+    value: {
+        read: function (path) {
+            return new Promise(function (resolve, reject) {
+                require("godot-jsb").internal.read_file_async(path, function (error, data) {
+                    if (typeof error !== "undefined") {
+                        reject(new Error(`failed to read ${path}: ${error}`));
+                        return;
+                    }
+                    resolve(data);
+                });
+            });
+        }
+    }
+});
+Object.defineProperty(require("godot-jsb"), "json", {
+    value: {
+        parseAsync: function (text) {
+            return new Promise(function (resolve, reject) {
+                require("godot-jsb").internal.parse_json_async(text, function (error, data) {
+                    if (typeof error !== "undefined") {
+                        reject(new SyntaxError(`failed to parse JSON: ${error}`));
+                        return;
+                    }
+                    resolve(data);
+                });
+            });
+        },
+        stringifyToBuffer: function (value, space) {
+            return require("godot-jsb").internal.stringify_json(value, space);
+        },
+        stringifyToFile: function (path, value, space) {
+            return require("godot-jsb").internal.stringify_json_to_file(path, value, space);
+        }
+    }
+});
+Object.defineProperty(require("godot-jsb"), "load", {
+    value: function (path, options) {
+        const internal = require("godot-jsb").internal;
+        let token;
+        let reject_fn;
+        const promise = new Promise(function (resolve, reject) {
+            var _a, _b;
+            reject_fn = reject;
+            token = internal.load_resource_async(path, (_a = options === null || options === void 0 ? void 0 : options.type_hint) !== null && _a !== void 0 ? _a : "", ((_b = options === null || options === void 0 ? void 0 : options.priority) !== null && _b !== void 0 ? _b : 0) > 0, function (error, resource) {
+                token = undefined;
+                if (typeof error !== "undefined") {
+                    reject(new Error(`failed to load ${path}: ${error}`));
+                    return;
+                }
+                resolve(resource);
+            });
+        });
+        promise.cancel = function () {
+            if (typeof token === "undefined" || !internal.cancel_load_resource(token)) {
+                return false;
+            }
+            token = undefined;
+            reject_fn(new Error(`loading ${path} is cancelled`));
+            return true;
+        };
+        return promise;
+    }
+});
 Object.defineProperty(require("godot"), "GLOBAL_GET", {
     value: function (entry_path) {
         return require("godot").ProjectSettings.get_setting_with_override(entry_path);
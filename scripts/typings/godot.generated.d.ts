@@ -61,6 +61,17 @@ declare module "godot" {
         }
     }
     
+    class DirAccess {
+        static make_dir_recursive_absolute(path: string): number;
+    }
+
+    class Resource { }
+    class Script extends Resource { reload(keep_state: boolean = false): number; }
+    class ResourceLoader {
+        static has_cached(path: string): boolean;
+        static load(path: string): Resource;
+    }
+
     class PackedByteArray { }
 
     class PackedStringArray { append(value: string): boolean }
@@ -78,8 +89,11 @@ declare module "godot" {
 
         static open(path: string, flags: number);
         static file_exists(path: string): boolean;
+        static get_file_as_string(path: string): string;
+        static get_md5(path: string): string;
 
         store_line(str: string);
+        store_string(str: string);
         get_position(): number;
         flush(): void;
         close() : void;
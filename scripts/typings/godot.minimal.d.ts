@@ -1,6 +1,6 @@
 
 declare module "godot-jsb" {
-    import { Object as GDObject, PackedByteArray, PropertyUsageFlags, PropertyHint, MethodFlags, Variant, Callable0, Callable1, Callable2, Callable3, Callable4, Callable5, StringName, MultiplayerAPI, MultiplayerPeer } from "godot";
+    import { Object as GDObject, PackedByteArray, PropertyUsageFlags, PropertyHint, MethodFlags, Variant, Callable0, Callable1, Callable2, Callable3, Callable4, Callable5, StringName, MultiplayerAPI, MultiplayerPeer, Resource } from "godot";
 
     const DEV_ENABLED: boolean;
     const TOOLS_ENABLED: boolean;
@@ -79,6 +79,15 @@ declare module "godot-jsb" {
      */
     function to_array_buffer(packed: PackedByteArray): ArrayBuffer;
 
+    /**
+     * Convert a `PackedByteArray` into a javascript `ArrayBuffer` which takes over the underlying memory,
+     * `packed` is left empty after the call.
+     * NOTE: No copy happens unless the memory is still shared with other `PackedByteArray` values (e.g. a value assigned from `packed`),
+     *       in that case it's copied once (copy-on-write), writing the buffer never modifies any `PackedByteArray`.
+     * NOTE: It always copies in web builds.
+     */
+    function to_shared_array_buffer(packed: PackedByteArray): ArrayBuffer;
+
     interface ScriptPropertyInfo {
         name: string;
         type: Variant.Type;
@@ -98,7 +107,7 @@ declare module "godot-jsb" {
             transfer_channel?: number, 
         }
 
-        function add_script_signal(target: any, name: string): void;
+        function add_script_signal(target: any, name: string, arguments?: string[]): void;
         function add_script_property(target: any, details: ScriptPropertyInfo): void;
         function add_script_ready(target: any, details: { name: string, evaluator: string | OnReadyEvaluatorFunc }): void;
         function add_script_tool(target: any): void;
@@ -116,6 +125,128 @@ declare module "godot-jsb" {
          * Get the transformed type name of a Variant.Type
          */
         function get_type_name(type: Variant.Type): StringName;
+
+        /**
+         * Load a file in background threads, the callback is invoked in the next frame after loaded.
+         * Use `jsb.fs.read` instead.
+         */
+        function read_file_async(path: string, callback: (error: string | undefined, data: ArrayBuffer | undefined) => void): void;
+
+        /**
+         * Parse JSON text in background threads, the callback is invoked in the next frame after parsed.
+         * Use `jsb.json.parseAsync` instead.
+         */
+        function parse_json_async(text: string | ArrayBuffer | PackedByteArray, callback: (error: string | undefined, data: any) => void): void;
+
+        /** Use `jsb.json.stringifyToBuffer` instead. */
+        function stringify_json(value: any, space?: string | number): PackedByteArray | undefined;
+
+        /** Use `jsb.json.stringifyToFile` instead. */
+        function stringify_json_to_file(path: string, value: any, space?: string | number): boolean;
+
+        /**
+         * Load a resource with `ResourceLoader` threaded loading, the callback is invoked in a later frame after loaded.
+         * Use `jsb.load` instead.
+         * @returns the token of the request for `cancel_load_resource`
+         */
+        function load_resource_async(path: string, type_hint: string, use_sub_threads: boolean, callback: (error: string | undefined, resource: Resource | undefined) => void): number;
+
+        /**
+         * Cancel a request of `load_resource_async`, the callback will never be invoked if it returns true.
+         */
+        function cancel_load_resource(token: number): boolean;
+
+        /**
+         * Evaluate the source as a global script (not in a function or a module),
+         * top-level let/const/class declarations are kept in the global lexical scope.
+         * The completion value of the script is returned, and the exception (if any) is thrown to the caller.
+         */
+        function eval_script(source: string, filename?: string): any;
+    }
+
+    interface LoadOptions {
+        /** the type hint for `ResourceLoader` (e.g. `PackedScene`) */
+        type_hint?: string;
+
+        /**
+         * load the dependencies in parallel with sub-threads if greater than 0.
+         * (`ResourceLoader` threaded loading has no priority, it's the closest option to speed up a specific request)
+         */
+        priority?: number;
+    }
+
+    interface LoadRequest<T extends Resource = Resource> extends Promise<T> {
+        /**
+         * Cancel the request, the promise will be rejected if it returns true.
+         * It returns false if the request is already finished.
+         */
+        cancel(): boolean;
+    }
+
+    /**
+     * Load a resource in background threads (with `ResourceLoader.load_threaded_request`) without stalling frames.
+     * Concurrent requests of the same path share one underlying load request.
+     * @param path the resource path (or uid://)
+     */
+    function load<T extends Resource = Resource>(path: string, options?: LoadOptions): LoadRequest<T>;
+
+    namespace fs {
+        /**
+         * Read the whole content of a file asynchronously (loaded by the thread pool).
+         * The returned `ArrayBuffer` references the loaded data directly without copying.
+         * @param path the file path (e.g. `res://data/level1.json`)
+         */
+        function read(path: string): Promise<ArrayBuffer>;
+    }
+
+    namespace json {
+        /**
+         * Parse JSON text in background threads (the same result as `JSON.parse` without reviver).
+         * Only the final materialization of JS values runs on the calling thread, all at once in the next frame.
+         * @param text the JSON text, or UTF-8 encoded JSON text (e.g. the result of `jsb.fs.read`)
+         */
+        function parseAsync(text: string | ArrayBuffer | PackedByteArray): Promise<any>;
+
+        /**
+         * The same as `JSON.stringify(value, undefined, space)`, but the UTF-8 text is written into a `PackedByteArray` directly.
+         * @returns undefined if the value is not serializable (undefined, function, symbol)
+         */
+        function stringifyToBuffer(value: any, space?: string | number): PackedByteArray | undefined;
+
+        /**
+         * The same as `JSON.stringify(value, undefined, space)`, but the UTF-8 text is written into a file.
+         * The existing file is left untouched if the value is not serializable (or an exception is thrown).
+         * @returns false if the value is not serializable (undefined, function, symbol)
+         */
+        function stringifyToFile(path: string, value: any, space?: string | number): boolean;
+    }
+
+    /**
+     * Record engine calls and execute them in one batch at the end of the current frame,
+     * it's cheaper than `call_deferred`/`set_deferred` for bulk updates (no `MessageQueue` message for each call).
+     * Commands on objects freed before flushing are skipped.
+     */
+    namespace commands {
+        /**
+         * Record a method call, the method is resolved and the arguments are converted immediately.
+         */
+        function call(target: GDObject, method: string, ...args: any[]): void;
+
+        /**
+         * Record a property assignment.
+         */
+        function set(target: GDObject, property: string, value: any): void;
+
+        /**
+         * Execute all recorded commands now (e.g. at the beginning of `_physics_process`).
+         * @returns the number of executed commands
+         */
+        function flush(): number;
+
+        /**
+         * @returns the number of recorded commands
+         */
+        function size(): number;
     }
 
     namespace editor {
@@ -259,6 +390,24 @@ declare module "godot-jsb" {
             signals: { [name: string]: { description: string } };
         }
 
+        // brief of a godot class in `ClassDump`
+        interface ClassDumpEntry {
+            name: string;
+            super: string;
+
+            /** content hash of the class info and class doc */
+            hash: string;
+
+            /** names of enums declared in this class */
+            enums: Array<string>;
+        }
+
+        interface ClassDump {
+            /** hash of the class list, singletons and global enums */
+            hash: string;
+            classes: Array<ClassDumpEntry>;
+        }
+
         function get_class_doc(class_name: string): ClassDoc | undefined;
 
         /**
@@ -266,6 +415,24 @@ declare module "godot-jsb" {
          */
         function get_classes(): Array<ClassInfo>;
 
+        /**
+         * get a brief of all classes registered in ClassDB as JSON text (`ClassDump`), it's much cheaper than `get_classes`
+         */
+        function get_class_dump(): string;
+
+        /**
+         * get the class info of a single class registered in ClassDB
+         */
+        function get_class_info(class_name: string): ClassInfo | undefined;
+
+        /**
+         * copy ClassDB and the class docs (main thread only), the functions above read the copy until it's released.
+         * ClassDB is not thread-safe, a snapshot must be taken before these functions are called in a worker.
+         */
+        function take_class_snapshot(): void;
+
+        function release_class_snapshot(): void;
+
         function get_primitive_types(): Array<PrimitiveClassInfo>;
 
         function get_singletons(): Array<SingletonInfo>;
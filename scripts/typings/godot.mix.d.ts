@@ -186,4 +186,22 @@ declare module "godot" {
         as_promise(): Promise<T1>;
     }
 
+    /**
+     * A weak reference to a godot object, it keeps neither the JS object nor the godot object (RefCounted) alive.
+     * It's cheaper than checking `is_instance_valid` on a cached object.
+     */
+    class GodotWeakRef<T extends Object = Object> {
+        /**
+         * @param target a godot object
+         * @param callback called once (at the end of the frame) after the object is deleted, e.g. to evict it from a cache.
+         *                 it's not called if this weak ref is garbage collected before that, keep it referenced (like `FinalizationRegistry`).
+         */
+        constructor(target: T, callback?: () => void);
+
+        /**
+         * @returns the object, or `undefined` if it has been deleted
+         */
+        deref(): T | undefined;
+    }
+
 }
\ No newline at end of file
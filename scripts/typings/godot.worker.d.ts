@@ -1,6 +1,6 @@
 
 declare module "godot.worker" {
-    import { Object as GDObject } from "godot";
+    import { Object as GDObject, Node as GDNode } from "godot";
 
     class JSWorker {
         constructor(path: string);
@@ -15,6 +15,33 @@ declare module "godot.worker" {
         onerror?: (error: any) => void;
 
         ontransfer?: (obj: GDObject) => void;
+
+        // called when a scene committed by `SceneBuilder` in the worker is replayed (the root node is not in the tree).
+        // the root node is owned by the script, it should be added to a parent or freed explicitly.
+        onbuild?: (root: GDNode) => void;
+    }
+
+    /**
+     * record the construction of a detached scene in a worker, nothing is created in the worker.
+     * the recorded commands are replayed in the main thread (slice by slice in each frame) after committed,
+     * and `JSWorker.onbuild` is called with the root node when all done.
+     * @note property values are converted in the worker, only values safe to share between threads should be used (primitives and resources)
+     */
+    class SceneBuilder {
+        constructor();
+
+        /**
+         * record a node creation, the first node is the root.
+         * @param parent the parent node handle (the root if not specified)
+         * @returns the node handle
+         */
+        create(class_name: string, parent?: number): number;
+
+        // record a property setting on a created node
+        set(node: number, property: string, value: any): void;
+
+        // hand the recorded commands over to the main thread, the builder is reset for the next scene
+        commit(): void;
     }
 
     // only available in worker scripts
@@ -4,6 +4,14 @@
 #include "jsb_test_helpers.h"
 #include "../bridge/jsb_essentials.h"
 #include "../bridge/jsb_type_convert.h"
+#include "../bridge/jsb_json.h"
+#include "../bridge/jsb_command_buffer.h"
+#include "../bridge/jsb_scene_builder.h"
+#ifdef TOOLS_ENABLED
+#include "../weaver-editor/jsb_export_pipeline.h"
+#endif
+
+#include "core/os/thread.h"
 
 #define JSB_TESTS_OPTION_ENABLED(OptionName) kOption_##OptionName
 #define JSB_TESTS_OPTION_DEFINE(OptionName, IsEnabled) enum { kOption_##OptionName = IsEnabled };
@@ -266,6 +274,39 @@ return 1+1;
         env.reset();
     }
 
+    TEST_CASE("[jsb] CommandBuffer")
+    {
+        constexpr int kNumCalls = 100;
+        CommandBuffer buffer;
+        Object* obj = memnew(Object);
+        Object* freed = memnew(Object);
+        const MethodBind* set_meta = ClassDB::get_method("Object", "set_meta");
+        REQUIRE(set_meta);
+
+        // the arguments are copied, the storage of recorded arguments is reallocated while recording
+        for (int index = 0; index < kNumCalls; ++index)
+        {
+            const Variant args[] = { StringName("key_" + itos(index)), index };
+            buffer.add_call(obj->get_instance_id(), index % 2 ? set_meta : nullptr, "set_meta", args, 2);
+        }
+        buffer.add_set(obj->get_instance_id(), "metadata/key_0", "overwritten");
+        buffer.add_call(freed->get_instance_id(), set_meta, "set_meta", nullptr, 0);
+        memdelete(freed);
+        CHECK(buffer.size() == kNumCalls + 2);
+
+        // nothing is executed before flushing, and the command on a freed object is skipped
+        CHECK(!obj->has_meta("key_1"));
+        CHECK(buffer.flush() == kNumCalls + 1);
+        CHECK(buffer.is_empty());
+        CHECK(obj->get_meta("key_0") == Variant("overwritten"));
+        for (int index = 1; index < kNumCalls; ++index)
+        {
+            CHECK(obj->get_meta("key_" + itos(index)) == Variant(index));
+        }
+        CHECK(buffer.flush() == 0);
+        memdelete(obj);
+    }
+
     TEST_CASE("[jsb] Godot Object Class prototype checks")
     {
         GodotJSScriptLanguageIniter initer;
@@ -505,6 +546,933 @@ file = undefined;
         CHECK(weak_ref->get_ref().is_null());
         memdelete(weak_ref);
     }
+
+    // a RefCounted object is referenced by the engine, passed to JS and released 1M times,
+    // the JS handle is kept strong during the frame instead of flipping between weak and strong on each transition.
+    TEST_CASE("[jsb] RefCounted ref/unref benchmark")
+    {
+        GodotJSScriptLanguageIniter initer;
+
+        const std::shared_ptr<Environment> env = GodotJSScriptLanguage::get_singleton()->get_environment();
+        JSB_TESTS_EXECUTION_SCOPE(env.get());
+        v8::Isolate* isolate = env->get_isolate();
+        const v8::Local<v8::Context> context = env->get_context();
+        v8::HandleScope handle_scope(isolate);
+
+        // instantiated by JS, it's only referenced by JS initially
+        Error err;
+        GodotJSScriptLanguage::get_singleton()->eval_source(R"--(
+globalThis.test_ref = new (require("godot").RefCounted)();
+globalThis.test_pass = function (ref) { return ref; };
+)--", err);
+        REQUIRE(err == OK);
+        RefCounted* ref_counted;
+        {
+            Variant ref_var;
+            const v8::Local<v8::Value> ref_val = context->Global()->Get(context, impl::Helper::new_string(isolate, "test_ref")).ToLocalChecked();
+            REQUIRE(TypeConvert::js_to_gd_var(isolate, context, ref_val, Variant::OBJECT, ref_var));
+            ref_counted = Object::cast_to<RefCounted>(ref_var);
+            REQUIRE(ref_counted);
+        }
+        REQUIRE(ref_counted->get_reference_count() == 1);
+        const v8::Local<v8::Function> pass = context->Global()->Get(context, impl::Helper::new_string(isolate, "test_pass")).ToLocalChecked().As<v8::Function>();
+
+        constexpr int kNumIterations = 1000000;
+        int num_passed = 0;
+        const uint64_t start = OS::get_singleton()->get_ticks_usec();
+        for (int index = 0; index < kNumIterations; ++index)
+        {
+            v8::HandleScope loop_scope(isolate);
+
+            // the reference count crosses 1 <-> 2 in each iteration (which triggers the reference callback)
+            const Ref<RefCounted> held = ref_counted;
+            v8::Local<v8::Value> arg;
+            v8::Local<v8::Value> rval;
+            if (!TypeConvert::gd_var_to_js(isolate, context, Variant(held), arg)
+                || !pass->Call(context, v8::Undefined(isolate), 1, &arg).ToLocal(&rval))
+            {
+                break;
+            }
+            ++num_passed;
+        }
+        const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - start;
+        CHECK(num_passed == kNumIterations);
+        CHECK(ref_counted->get_reference_count() == 1);
+        MESSAGE(kNumIterations, " RefCounted round trips in ", elapsed / 1000.0, " ms");
+
+        // still alive after weakening since it's referenced by the global variable
+        env->gc();
+        CHECK(env->verify_object(ref_counted));
+        CHECK(ref_counted->get_reference_count() == 1);
+    }
+
+    // a garbage collected binding is finalized later in `update()`, the native object may be converted to JS again before that
+    TEST_CASE("[jsb] rebind an object before finalized")
+    {
+        GodotJSScriptLanguageIniter initer;
+
+        const std::shared_ptr<Environment> env = GodotJSScriptLanguage::get_singleton()->get_environment();
+        JSB_TESTS_EXECUTION_SCOPE(env.get());
+        v8::Isolate* isolate = env->get_isolate();
+        const v8::Local<v8::Context> context = env->get_context();
+
+        Error err;
+        GodotJSScriptLanguage::get_singleton()->eval_source(R"--(
+globalThis.test_ref = new (require("godot").RefCounted)();
+)--", err);
+        REQUIRE(err == OK);
+        RefCounted* ref_counted;
+        {
+            v8::HandleScope handle_scope(isolate);
+            Variant ref_var;
+            const v8::Local<v8::Value> ref_val = context->Global()->Get(context, impl::Helper::new_string(isolate, "test_ref")).ToLocalChecked();
+            REQUIRE(TypeConvert::js_to_gd_var(isolate, context, ref_val, Variant::OBJECT, ref_var));
+            ref_counted = Object::cast_to<RefCounted>(ref_var);
+            REQUIRE(ref_counted);
+        }
+        const ObjectID instance_id = ref_counted->get_instance_id();
+
+        // released by JS, the reference held by the stale binding is not released until finalized
+        GodotJSScriptLanguage::get_singleton()->eval_source("globalThis.test_ref = undefined;", err);
+        REQUIRE(err == OK);
+        env->gc();
+        REQUIRE(!env->verify_object(ref_counted));
+        REQUIRE(ref_counted->get_reference_count() == 1);
+
+        {
+            v8::HandleScope handle_scope(isolate);
+            v8::Local<v8::Object> obj_js;
+            REQUIRE(TypeConvert::gd_obj_to_js(isolate, context, ref_counted, obj_js));
+            context->Global()->Set(context, impl::Helper::new_string(isolate, "test_ref"), obj_js).Check();
+        }
+        CHECK(ref_counted->get_reference_count() == 2);
+
+        // the rebound object is not deleted by the pending finalization, only the stale reference is released
+        env->update(0);
+        CHECK(env->verify_object(ref_counted));
+        CHECK(ref_counted->get_reference_count() == 1);
+
+        // finalized by the new binding
+        GodotJSScriptLanguage::get_singleton()->eval_source("globalThis.test_ref = undefined;", err);
+        REQUIRE(err == OK);
+        env->gc();
+        env->update(0);
+        CHECK(::ObjectDB::get_instance(instance_id) == nullptr);
+    }
+
+    TEST_CASE("[jsb] GodotWeakRef callback")
+    {
+        GodotJSScriptLanguageIniter initer;
+
+        const std::shared_ptr<Environment> env = GodotJSScriptLanguage::get_singleton()->get_environment();
+        JSB_TESTS_EXECUTION_SCOPE(env.get());
+
+        Error err;
+        GodotJSScriptLanguage::get_singleton()->eval_source(R"--(
+const gd = require("godot");
+globalThis.test_notified = [];
+globalThis.test_node_a = new gd.Node();
+globalThis.test_node_b = new gd.Node();
+// the callback captures the weak ref itself
+globalThis.test_ref_a = new gd.GodotWeakRef(test_node_a, () => test_notified.push(test_ref_a.deref() === undefined ? "a" : "a:alive"));
+globalThis.test_ref_b = new gd.GodotWeakRef(test_node_b, () => test_notified.push("b"));
+)--", err);
+        REQUIRE(err == OK);
+        env->update(0);
+        CHECK(GodotJSScriptLanguage::get_singleton()->eval_source("test_notified.join()", err).to_string() == "");
+
+        // notified at the end of the frame after deleted, only once
+        GodotJSScriptLanguage::get_singleton()->eval_source("test_node_a.free();", err);
+        REQUIRE(err == OK);
+        env->update(0);
+        env->update(0);
+        CHECK(GodotJSScriptLanguage::get_singleton()->eval_source("test_notified.join()", err).to_string() == "a");
+
+        // a garbage collected weak ref is unwatched
+        GodotJSScriptLanguage::get_singleton()->eval_source("test_ref_b = undefined;", err);
+        REQUIRE(err == OK);
+        env->gc();
+        env->update(0);
+        GodotJSScriptLanguage::get_singleton()->eval_source("test_node_b.free();", err);
+        REQUIRE(err == OK);
+        env->update(0);
+        CHECK(GodotJSScriptLanguage::get_singleton()->eval_source("test_notified.join()", err).to_string() == "a");
+    }
+
+    // lookup performance of ObjectDB with 200k bindings (without JS objects), by pointer and by NativeObjectID
+    TEST_CASE("[jsb] ObjectDB lookup benchmark")
+    {
+        constexpr int kNumObjects = 200000;
+        constexpr int kNumRounds = 5;
+
+        // unique fake pointers
+        LocalVector<uint8_t> storage;
+        storage.resize(kNumObjects);
+        LocalVector<NativeObjectID> ids;
+        ObjectDB object_db(kNumObjects);
+        for (int index = 0; index < kNumObjects; ++index)
+        {
+            ObjectHandlePtr handle;
+            ids.push_back(object_db.add_object(&storage[index], &handle));
+            handle->slot->ref_count = index & 1;
+        }
+        REQUIRE(object_db.size() == kNumObjects);
+        MESSAGE(kNumObjects, " bindings: ", object_db.get_memory_usage() / 1024, " KiB, ", (uint64_t) ObjectDB::get_bytes_per_object(), " bytes per binding");
+
+        uint64_t checksum = 0;
+        uint64_t start = OS::get_singleton()->get_ticks_usec();
+        for (int round = 0; round < kNumRounds; ++round)
+        {
+            for (int index = 0; index < kNumObjects; ++index)
+            {
+                if (const ObjectHandleConstPtr handle = object_db.try_get_object(&storage[index]))
+                {
+                    checksum += handle->slot->ref_count;
+                }
+            }
+        }
+        const uint64_t elapsed_by_pointer = OS::get_singleton()->get_ticks_usec() - start;
+        CHECK(checksum == (uint64_t) kNumRounds * (kNumObjects / 2));
+
+        checksum = 0;
+        start = OS::get_singleton()->get_ticks_usec();
+        for (int round = 0; round < kNumRounds; ++round)
+        {
+            for (int index = 0; index < kNumObjects; ++index)
+            {
+                if (const ObjectHandleConstPtr handle = object_db.try_get_object(ids[index]))
+                {
+                    checksum += handle->slot->ref_count;
+                }
+            }
+        }
+        const uint64_t elapsed_by_id = OS::get_singleton()->get_ticks_usec() - start;
+        CHECK(checksum == (uint64_t) kNumRounds * (kNumObjects / 2));
+        MESSAGE(kNumRounds * kNumObjects, " lookups by pointer: ", elapsed_by_pointer / 1000.0, " ms, by id: ", elapsed_by_id / 1000.0, " ms");
+
+        // stale ids are rejected after the slots are reused
+        for (int index = 0; index < kNumObjects; ++index)
+        {
+            object_db.remove_object(&storage[index]);
+        }
+        CHECK(!object_db.has_object(ids[0]));
+        const NativeObjectID reused = object_db.add_object(&storage[0], nullptr);
+        CHECK(reused.get_index() == ids[kNumObjects - 1].get_index());
+        CHECK(!object_db.has_object(ids[kNumObjects - 1]));
+        CHECK(object_db.has_object(reused));
+        object_db.remove_object(&storage[0]);
+    }
+
+    // objects are freed in 8 threads (where only the pointer index is queried) while the main thread keeps converting other objects
+    TEST_CASE("[jsb] free objects in background threads")
+    {
+        GodotJSScriptLanguageIniter initer;
+
+        const std::shared_ptr<Environment> env = GodotJSScriptLanguage::get_singleton()->get_environment();
+        JSB_TESTS_EXECUTION_SCOPE(env.get());
+        v8::Isolate* isolate = env->get_isolate();
+        const v8::Local<v8::Context> context = env->get_context();
+
+        constexpr int kNumThreads = 8;
+        constexpr int kNumObjectsPerThread = 2000;
+        constexpr int kNumConverted = 1000;
+
+        struct FreeTask
+        {
+            LocalVector<Object*> objects;
+            SafeNumeric<int>* num_finished = nullptr;
+
+            static void run(void* p_userdata)
+            {
+                FreeTask* task = (FreeTask*) p_userdata;
+                for (Object* obj : task->objects) memdelete(obj);
+                task->num_finished->increment();
+            }
+        };
+
+        Statistics stats;
+        env->get_statistics(stats);
+        const int num_initial = stats.objects;
+
+        SafeNumeric<int> num_finished;
+        FreeTask tasks[kNumThreads];
+        LocalVector<Object*> converted;
+        for (int index = 0; index < kNumThreads * kNumObjectsPerThread + kNumConverted; ++index)
+        {
+            v8::HandleScope handle_scope(isolate);
+            Object* obj = memnew(Object);
+            v8::Local<v8::Object> obj_js;
+            REQUIRE(TypeConvert::gd_obj_to_js(isolate, context, obj, obj_js));
+            if (index < kNumConverted) converted.push_back(obj);
+            else tasks[index % kNumThreads].objects.push_back(obj);
+        }
+        for (FreeTask& task : tasks) task.num_finished = &num_finished;
+        env->get_statistics(stats);
+        REQUIRE(stats.objects == num_initial + kNumThreads * kNumObjectsPerThread + kNumConverted);
+
+        Thread threads[kNumThreads];
+        const uint64_t start = OS::get_singleton()->get_ticks_usec();
+        for (int index = 0; index < kNumThreads; ++index)
+        {
+            threads[index].start(&FreeTask::run, &tasks[index]);
+        }
+        int num_conversions = 0;
+        int num_failed = 0;
+        while (num_finished.get() != kNumThreads)
+        {
+            for (Object* obj : converted)
+            {
+                v8::HandleScope handle_scope(isolate);
+                v8::Local<v8::Object> obj_js;
+                if (!TypeConvert::gd_obj_to_js(isolate, context, obj, obj_js)) ++num_failed;
+                ++num_conversions;
+            }
+        }
+        const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - start;
+        for (Thread& thread : threads) thread.wait_to_finish();
+        CHECK(num_failed == 0);
+        MESSAGE(kNumThreads * kNumObjectsPerThread, " objects freed in ", kNumThreads, " threads in ", elapsed / 1000.0, " ms, ", num_conversions, " conversions in the main thread");
+
+        // the bindings are removed in the owner thread
+        env->update(0);
+        env->get_statistics(stats);
+        CHECK(stats.objects == num_initial + kNumConverted);
+        for (Object* obj : converted)
+        {
+            CHECK(env->verify_object(obj));
+            memdelete(obj);
+        }
+        env->get_statistics(stats);
+        CHECK(stats.objects == num_initial);
+    }
+
+    TEST_CASE("[jsb] object identity cache")
+    {
+        // permanent entries are never evicted, even by another permanent one
+        {
+            const std::unique_ptr<ObjectIdentityCache> cache = std::make_unique<ObjectIdentityCache>();
+            uint8_t* base = (uint8_t*) 0x10000;
+            uint8_t* collided = base + 16;
+            while (&cache->get_entry(collided) != &cache->get_entry(base)) collided += 16;
+
+            CHECK(cache->put_permanent(base, NativeObjectID(1, 1)));
+            ObjectIdentityCache::put(cache->get_entry(collided), collided, NativeObjectID(2, 1));
+            CHECK(!cache->put_permanent(collided, NativeObjectID(2, 1)));
+            const ObjectIdentityCache::Entry& entry = cache->get_entry(base);
+            CHECK(entry.pointer == base);
+            CHECK(entry.object_id == NativeObjectID(1, 1));
+            cache->clear();
+            CHECK(!cache->get_entry(base).pointer);
+        }
+
+        GodotJSScriptLanguageIniter initer;
+
+        const std::shared_ptr<Environment> env = GodotJSScriptLanguage::get_singleton()->get_environment();
+        JSB_TESTS_EXECUTION_SCOPE(env.get());
+        v8::Isolate* isolate = env->get_isolate();
+        const v8::Local<v8::Context> context = env->get_context();
+        v8::HandleScope handle_scope(isolate);
+
+        Object* obj = memnew(Object);
+        v8::Local<v8::Object> obj_js;
+        REQUIRE(TypeConvert::gd_obj_to_js(isolate, context, obj, obj_js));
+        const ObjectIdentityCache::Entry& entry = env->get_identity_cache().get_entry(obj);
+        REQUIRE(entry.pointer == obj);
+        const NativeObjectID object_id = entry.object_id;
+
+        // hit, the same JS object is returned
+        v8::Local<v8::Object> cached;
+        REQUIRE(env->try_get_object_cached(obj, cached));
+        CHECK(cached == obj_js);
+
+        // the entry is left as it is after the binding released, it's rejected by the revision of NativeObjectID
+        memdelete(obj);
+        env->update(0);
+        CHECK(entry.pointer == obj);
+        CHECK(entry.object_id == object_id);
+        CHECK(!env->try_get_object(object_id, cached));
+        CHECK(!env->try_get_object_cached(obj, cached));
+    }
+
+    // the 10 MB and 50 MB rounds take seconds, they're only for profiling locally
+    JSB_TESTS_OPTION_DEFINE(LargeJSONBenchmark, 0)
+
+    // compare `JSON.parse` (blocking) with `jsb.json.parseAsync` (parsed in worker thread, materialized in main thread)
+    TEST_CASE("[jsb] JSON parse benchmark: sync vs async")
+    {
+        GodotJSScriptLanguageIniter initer;
+
+        const std::shared_ptr<Environment> env = GodotJSScriptLanguage::get_singleton()->get_environment();
+        JSB_TESTS_EXECUTION_SCOPE(env.get());
+        v8::Isolate* isolate = env->get_isolate();
+        const v8::Local<v8::Context> context = env->get_context();
+
+        const v8::Local<v8::Object> json_obj = context->Global()->Get(context, impl::Helper::new_string(isolate, "JSON")).ToLocalChecked().As<v8::Object>();
+        const v8::Local<v8::Function> json_parse = json_obj->Get(context, impl::Helper::new_string(isolate, "parse")).ToLocalChecked().As<v8::Function>();
+
+        constexpr int kSizesMB[] = { 1, 10, 50 };
+        const int num_sizes = JSB_TESTS_OPTION_ENABLED(LargeJSONBenchmark) ? (int) std::size(kSizesMB) : 1;
+        for (int size_index = 0; size_index < num_sizes; ++size_index)
+        {
+            const int size_mb = kSizesMB[size_index];
+            // a typical layout of level data
+            const size_t size = (size_t) size_mb * 1024 * 1024;
+            std::string text = "[";
+            for (int64_t index = 0; text.size() < size; ++index)
+            {
+                if (index != 0) text += ",";
+                text += R"--({"id":)--" + std::to_string(index) + R"--(,"name":"node_)--" + std::to_string(index) + R"--(","position":[1.5,-2.25,3e2],"tags":["a","é"],"visible":true,"parent":null})--";
+            }
+            text += "]";
+
+            Vector<uint8_t> utf8;
+            utf8.resize((int64_t) text.size());
+            memcpy(utf8.ptrw(), text.data(), text.size());
+
+            uint32_t sync_len;
+            uint64_t sync_usec;
+            {
+                v8::HandleScope handle_scope(isolate);
+                const v8::Local<v8::String> source = impl::Helper::new_string_utf8(isolate, text.data(), text.size());
+                const uint64_t start = OS::get_singleton()->get_ticks_usec();
+                v8::Local<v8::Value> argv[] = { source };
+                const v8::Local<v8::Value> rval = json_parse->Call(context, v8::Undefined(isolate), std::size(argv), argv).ToLocalChecked();
+                sync_usec = OS::get_singleton()->get_ticks_usec() - start;
+                REQUIRE(rval->IsArray());
+                sync_len = rval.As<v8::Array>()->Length();
+            }
+
+            uint32_t async_len;
+            uint64_t parse_usec, materialize_usec;
+            {
+                internal::AsyncJSONParser parser;
+                const uint64_t start = OS::get_singleton()->get_ticks_usec();
+                parser.parse_async(utf8, 1);
+                Variant data;
+                while (!parser.is_empty())
+                {
+                    std::vector<internal::AsyncJSONParser::ParseResult>& results = parser.poll();
+                    for (const internal::AsyncJSONParser::ParseResult& result : results)
+                    {
+                        REQUIRE(result.error == OK);
+                        data = result.data;
+                    }
+                    results.clear();
+                    OS::get_singleton()->delay_usec(100);
+                }
+                parse_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+                v8::HandleScope handle_scope(isolate);
+                const uint64_t materialize_start = OS::get_singleton()->get_ticks_usec();
+                const v8::Local<v8::Value> rval = JSONHelper::to_js(isolate, context, data);
+                materialize_usec = OS::get_singleton()->get_ticks_usec() - materialize_start;
+                REQUIRE(rval->IsArray());
+                async_len = rval.As<v8::Array>()->Length();
+            }
+
+            CHECK(sync_len == async_len);
+            MESSAGE(size_mb, " MB, ", sync_len, " elements: JSON.parse ", sync_usec / 1000, " ms (blocking) | parseAsync ", parse_usec / 1000, " ms (worker) + ", materialize_usec / 1000, " ms (blocking)");
+        }
+    }
+
+    // the whole subtree is detached in one pass and transferred as a single batch, descendants are rebound lazily
+    TEST_CASE("[jsb] transfer a 5k-node subtree")
+    {
+        GodotJSScriptLanguageIniter initer;
+
+        const std::shared_ptr<Environment> env = GodotJSScriptLanguage::get_singleton()->get_environment();
+        JSB_TESTS_EXECUTION_SCOPE(env.get());
+        v8::Isolate* isolate = env->get_isolate();
+        const v8::Local<v8::Context> context = env->get_context();
+
+        // a native object as the worker handle which receives 'ontransfer'
+        Object* worker = memnew(Object);
+        v8::Local<v8::Object> worker_obj;
+        REQUIRE(TypeConvert::gd_obj_to_js(isolate, context, worker, worker_obj));
+        context->Global()->Set(context, impl::Helper::new_string(isolate, "test_worker"), worker_obj).Check();
+        Error err;
+        GodotJSScriptLanguage::get_singleton()->eval_source(R"--(
+test_worker.ontransfer = function (root) { globalThis.transferred_children = root.get_child_count(); };
+)--", err);
+        REQUIRE(err == OK);
+        const NativeObjectID worker_id = env->try_get_object_id(worker);
+        REQUIRE(worker_id);
+
+        // a balanced tree (8 children for each node), all nodes are bound to JS
+        constexpr int kNumNodes = 5000;
+        LocalVector<Node*> nodes;
+        for (int index = 0; index < kNumNodes; ++index)
+        {
+            Node* node = memnew(Node);
+            if (index != 0) nodes[(index - 1) / 8]->add_child(node);
+            nodes.push_back(node);
+            v8::Local<v8::Object> node_obj;
+            REQUIRE(TypeConvert::gd_obj_to_js(isolate, context, node, node_obj));
+        }
+
+        // the target environment is the same one, the batch is applied immediately
+        const uint64_t start = OS::get_singleton()->get_ticks_usec();
+        Environment::transfer_object(env.get(), env.get(), worker_id, nodes[0]);
+        const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - start;
+
+        CHECK(env->verify_object(nodes[0]));
+        int num_bound = 0;
+        for (int index = 1; index < kNumNodes; ++index)
+        {
+            if (env->verify_object(nodes[index])) ++num_bound;
+        }
+        CHECK(num_bound == 0);
+        const v8::Local<v8::Value> transferred_children = context->Global()->Get(context, impl::Helper::new_string(isolate, "transferred_children")).ToLocalChecked();
+        CHECK(transferred_children->IsInt32());
+        CHECK(transferred_children.As<v8::Int32>()->Value() == 8);
+        MESSAGE(kNumNodes, " nodes transferred in ", elapsed / 1000.0, " ms");
+
+        memdelete(nodes[0]);
+        memdelete(worker);
+    }
+
+    TEST_CASE("[jsb] JSON stringify into PackedByteArray")
+    {
+        GodotJSScriptLanguageIniter initer;
+
+        const std::shared_ptr<Environment> env = GodotJSScriptLanguage::get_singleton()->get_environment();
+        JSB_TESTS_EXECUTION_SCOPE(env.get());
+        v8::Isolate* isolate = env->get_isolate();
+        const v8::Local<v8::Context> context = env->get_context();
+
+        const String source = String::utf8(R"--({"a":[1,-2.5,"x\"y\né😀",true,null],"b":{"c":{}},"d":[]})--");
+        const internal::AsyncJSONParser::ParseResult parsed = internal::AsyncJSONParser::parse(source, 0);
+        REQUIRE(parsed.error == OK);
+
+        v8::HandleScope handle_scope(isolate);
+        const v8::Local<v8::Value> value = JSONHelper::to_js(isolate, context, parsed.data);
+        PackedByteArray buffer;
+        REQUIRE(JSONHelper::stringify(isolate, context, value, v8::Undefined(isolate), buffer));
+        String output;
+        output.parse_utf8((const char*) buffer.ptr(), buffer.size());
+        CHECK(output == String::utf8(R"--({"a":[1,-2.5,"x\"y\né😀",true,null],"b":{"c":{}},"d":[]})--"));
+    }
+
+    TEST_CASE("[jsb] JSON stringify to file")
+    {
+        GodotJSScriptLanguageIniter initer;
+
+        const std::shared_ptr<Environment> env = GodotJSScriptLanguage::get_singleton()->get_environment();
+        JSB_TESTS_EXECUTION_SCOPE(env.get());
+        const String path = "res://jsb_json_stringify_test.json";
+        const auto stringify = [&](const String& p_value)
+        {
+            Error err;
+            const String rval = GodotJSScriptLanguage::get_singleton()->eval_source(jsb_format(R"--(
+(function () {
+    try { return require("godot-jsb").internal.stringify_json_to_file("%s", %s); }
+    catch (e) { return "error"; }
+})())--", path, p_value), err).to_string();
+            CHECK(err == OK);
+            return rval;
+        };
+
+        // boxed primitives are unwrapped (the same as JSON.stringify)
+        CHECK(stringify(R"--({ s: new String("x"), n: new Number(1.5), b: [new Boolean(false)] })--") == "true");
+        CHECK(FileAccess::get_file_as_string(path) == R"--({"s":"x","n":1.5,"b":[false]})--");
+
+        // the existing file is left untouched if it fails
+        CHECK(stringify("(function () { const o = {}; o.o = o; return o; })()") == "error");
+        CHECK(stringify("undefined") == "false");
+        CHECK(FileAccess::get_file_as_string(path) == R"--({"s":"x","n":1.5,"b":[false]})--");
+
+        DirAccess::remove_absolute(path);
+    }
+
+#if JSB_WITH_ESSENTIALS
+    TEST_CASE("[jsb] performance timing and animation frames")
+    {
+        GodotJSScriptLanguageIniter initer;
+
+        const std::shared_ptr<Environment> env = GodotJSScriptLanguage::get_singleton()->get_environment();
+        JSB_TESTS_EXECUTION_SCOPE(env.get());
+        v8::Isolate* isolate = env->get_isolate();
+        const v8::Local<v8::Context> context = env->get_context();
+        const auto get_number = [&](const char* p_name)
+        {
+            const v8::Local<v8::Value> value = context->Global()->Get(context, impl::Helper::new_string(isolate, p_name)).ToLocalChecked();
+            REQUIRE(value->IsNumber());
+            return value.As<v8::Number>()->Value();
+        };
+
+        env->get_measure_recorder().set_enabled(true);
+        Error err;
+        GodotJSScriptLanguage::get_singleton()->eval_source(R"--(
+globalThis.frames = 0;
+requestAnimationFrame(() => { globalThis.frames += 1; });
+cancelAnimationFrame(requestAnimationFrame(() => { globalThis.frames += 100; }));
+globalThis.origin_delta = Math.abs(performance.timeOrigin + performance.now() - Date.now());
+performance.mark("start");
+globalThis.measured = performance.measure("from_start", "start");
+)--", err);
+        REQUIRE(err == OK);
+
+        // the cancelled callback is removed immediately
+        CHECK(env->get_frame_callbacks().size() == 1);
+        env->update(0);
+        CHECK(env->get_frame_callbacks().size() == 0);
+        CHECK(get_number("frames") == 1);
+
+        // timeOrigin is an epoch timestamp in milliseconds
+        CHECK(get_number("origin_delta") < 1000);
+
+        // the measure is reported to the script profiler
+        CHECK(get_number("measured") >= 0);
+        ScriptLanguage::ProfilingInfo infos[4];
+        REQUIRE(env->get_measure_recorder().get_accumulated_data(infos, std::size(infos)) == 1);
+        CHECK(infos[0].call_count == 1);
+        CHECK(String(infos[0].signature).ends_with("::from_start"));
+        env->get_measure_recorder().reset_frame();
+        CHECK(env->get_measure_recorder().get_frame_data(infos, std::size(infos)) == 0);
+        env->get_measure_recorder().set_enabled(false);
+    }
+
+    TEST_CASE("[jsb] TextEncoder/TextDecoder round-trip")
+    {
+        GodotJSScriptLanguageIniter initer;
+
+        const std::shared_ptr<Environment> env = GodotJSScriptLanguage::get_singleton()->get_environment();
+        JSB_TESTS_EXECUTION_SCOPE(env.get());
+
+        Error err;
+        const String results = GodotJSScriptLanguage::get_singleton()->eval_source(R"--(
+const encoder = new TextEncoder();
+const decoder = new TextDecoder();
+const round_trip = s => decoder.decode(encoder.encode(s)) === s;
+const into = (s, n) => { const r = encoder.encodeInto(s, new Uint8Array(n)); return [r.read, r.written]; };
+JSON.stringify([
+    round_trip(""),
+    round_trip("hello".repeat(20)),
+    round_trip("\u00e9\u4e2d\u6587"),
+    round_trip("a\ud83d\ude00b"),
+    Array.from(encoder.encode("\ud800")),
+    decoder.decode(encoder.encode("x\udc00y")) === "x\ufffdy",
+    into("\ud800", 3),
+    into("a\ud83d\ude00", 4),
+    into("a\ud83d\ude00", 5),
+])
+)--", err);
+        REQUIRE(err == OK);
+        CHECK(results == R"--([true,true,true,true,[239,191,189],true,[1,3],[1,1],[3,5]])--");
+    }
+#endif
+
+    // writing a shared ArrayBuffer never modifies other PackedByteArray values which share the same memory
+    TEST_CASE("[jsb] shared ArrayBuffer of PackedByteArray")
+    {
+        GodotJSScriptLanguageIniter initer;
+
+        const std::shared_ptr<Environment> env = GodotJSScriptLanguage::get_singleton()->get_environment();
+        JSB_TESTS_EXECUTION_SCOPE(env.get());
+        v8::Isolate* isolate = env->get_isolate();
+        v8::HandleScope handle_scope(isolate);
+
+        Vector<uint8_t> origin;
+        origin.resize(4);
+        memset(origin.ptrw(), 1, origin.size());
+        Vector<uint8_t> packed = origin;
+        const v8::Local<v8::ArrayBuffer> buffer = impl::Helper::to_shared_array_buffer(isolate, packed);
+        CHECK(packed.is_empty());
+        REQUIRE(buffer->ByteLength() == 4);
+        ((uint8_t*) buffer->Data())[0] = 2;
+        CHECK(origin[0] == 1);
+
+#if !JSB_WITH_WEB
+        // the memory of a PackedByteArray wrapper is taken over without copying
+        const v8::Local<v8::Context> context = env->get_context();
+        const uint8_t* data = origin.ptr();
+        v8::Local<v8::Value> wrapper;
+        REQUIRE(TypeConvert::gd_var_to_js(isolate, context, Variant(origin), wrapper));
+        origin = Vector<uint8_t>();
+        context->Global()->Set(context, impl::Helper::new_string(isolate, "shared_source"), wrapper).Check();
+        Error err;
+        CHECK(GodotJSScriptLanguage::get_singleton()->eval_source(R"--(
+globalThis.shared_buffer = require("godot-jsb").to_shared_array_buffer(shared_source);
+shared_source.size()
+)--", err).to_string() == "0");
+        REQUIRE(err == OK);
+        const v8::Local<v8::Value> shared = context->Global()->Get(context, impl::Helper::new_string(isolate, "shared_buffer")).ToLocalChecked();
+        REQUIRE(shared->IsArrayBuffer());
+        CHECK(shared.As<v8::ArrayBuffer>()->Data() == data);
+        GodotJSScriptLanguage::get_singleton()->eval_source("delete globalThis.shared_source; delete globalThis.shared_buffer;", err);
+#endif
+    }
+
+#if !JSB_WITH_WEB && !JSB_WITH_JAVASCRIPTCORE
+    TEST_CASE("[jsb] SceneCommandBuffer replay")
+    {
+        SceneCommandBuffer buffer;
+        const uint32_t root = buffer.create("Node", SceneCommandBuffer::kNoParent);
+        const uint32_t child = buffer.create("Node2D", root);
+        const uint32_t grandchild = buffer.create("Node", child);
+        buffer.set(child, "name", "Child");
+        buffer.set(grandchild, "name", "Grandchild");
+        CHECK(buffer.is_valid_node(grandchild));
+        CHECK(!buffer.is_valid_node(grandchild + 1));
+
+        // at least one command is replayed in each slice even if the deadline is already reached
+        int slices = 1;
+        while (!buffer.replay(0)) ++slices;
+        CHECK(slices == 5);
+        CHECK(buffer.is_empty());
+
+        Node* node = buffer.take_root();
+        REQUIRE(node);
+        REQUIRE(node->get_child_count() == 1);
+        CHECK(node->get_child(0)->get_name() == StringName("Child"));
+        CHECK(node->get_child(0)->get_class_name() == StringName("Node2D"));
+        CHECK(node->get_node_or_null(NodePath("Child/Grandchild")));
+        CHECK(!buffer.take_root());
+        memdelete(node);
+    }
+
+    TEST_CASE("[jsb] SceneCommandBuffer failures")
+    {
+        const int num_objects = ObjectDB::get_object_count();
+        {
+            SceneCommandBuffer buffer;
+            const uint32_t root = buffer.create("Node", SceneCommandBuffer::kNoParent);
+            // not a node class, the descendants are discarded too
+            const uint32_t resource = buffer.create("Resource", root);
+            buffer.create("Node", resource);
+            buffer.set(root, "name", "Root");
+            buffer.set(resource, "name", "Nothing");
+            REQUIRE(buffer.replay(UINT64_MAX));
+
+            Node* node = buffer.take_root();
+            REQUIRE(node);
+            CHECK(node->get_name() == StringName("Root"));
+            CHECK(node->get_child_count() == 0);
+            memdelete(node);
+        }
+        CHECK(ObjectDB::get_object_count() == num_objects);
+
+        // the root is freed with the buffer if it's not taken
+        {
+            SceneCommandBuffer buffer;
+            const uint32_t root = buffer.create("Node", SceneCommandBuffer::kNoParent);
+            buffer.create("Node", root);
+            REQUIRE(buffer.replay(UINT64_MAX));
+        }
+        CHECK(ObjectDB::get_object_count() == num_objects);
+    }
+
+    // a scene recorded by `SceneBuilder` in a worker is replayed in `update()` and handed to `onbuild`
+    TEST_CASE("[jsb] SceneBuilder in worker")
+    {
+        GodotJSScriptLanguageIniter initer;
+
+        const std::shared_ptr<Environment> env = GodotJSScriptLanguage::get_singleton()->get_environment();
+        JSB_TESTS_EXECUTION_SCOPE(env.get());
+
+        const String dir = "res://jsb_scene_builder_test";
+        const String path = dir.path_join("builder.js");
+        REQUIRE(DirAccess::make_dir_recursive_absolute(dir) == OK);
+        {
+            const Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+            REQUIRE(f.is_valid());
+            f->store_string(R"--(
+const { SceneBuilder } = require("godot.worker");
+const builder = new SceneBuilder();
+const root = builder.create("Node");
+builder.set(root, "name", "BuiltRoot");
+builder.set(builder.create("Node2D", root), "name", "Child");
+builder.create("Node", root);
+builder.commit();
+)--");
+        }
+
+        const auto eval = [&](const String& p_source)
+        {
+            Error err;
+            const String result = GodotJSScriptLanguage::get_singleton()->eval_source(p_source, err).to_string();
+            REQUIRE(err == OK);
+            return result;
+        };
+        eval(vformat(R"--(
+globalThis.scene_worker = new (require("godot.worker").JSWorker)("%s");
+scene_worker.onbuild = function (root) { globalThis.built_root = root; };
+)--", path));
+
+        const uint64_t deadline = OS::get_singleton()->get_ticks_usec() + 10 * 1000 * 1000;
+        while (eval("typeof globalThis.built_root") == "undefined" && OS::get_singleton()->get_ticks_usec() < deadline)
+        {
+            env->update(0);
+            OS::get_singleton()->delay_usec(1000);
+        }
+        REQUIRE(eval("typeof globalThis.built_root") == "object");
+        CHECK(eval("built_root.name + '/' + built_root.get_child(0).name + ':' + built_root.get_child_count()") == "BuiltRoot/Child:2");
+        CHECK(eval("built_root.get_child(0).get_class()") == "Node2D");
+
+        // the parentless root is still owned by the script after `onbuild`
+        env->update(0);
+        CHECK(eval("require(\"godot\").is_instance_valid(built_root) && built_root.get_parent() === null") == "true");
+
+        eval("built_root.free(); scene_worker.terminate(); delete globalThis.built_root; delete globalThis.scene_worker;");
+        DirAccess::remove_absolute(path);
+        DirAccess::remove_absolute(dir);
+    }
+#endif
+
+#ifdef TOOLS_ENABLED
+    // REPL inputs are evaluated as global scripts, top-level declarations are visible to later inputs
+    TEST_CASE("[jsb] REPL evaluation")
+    {
+        GodotJSScriptLanguageIniter initer;
+
+        const std::shared_ptr<Environment> env = GodotJSScriptLanguage::get_singleton()->get_environment();
+        JSB_TESTS_EXECUTION_SCOPE(env.get());
+
+        Error err;
+        const String results = GodotJSScriptLanguage::get_singleton()->eval_source(R"--(
+const { repl_eval, transform_top_level_await } = require("jsb.editor.main");
+JSON.stringify([
+    repl_eval("let repl_a = 1; const repl_b = 2; class ReplC { get value() { return repl_a + repl_b; } }"),
+    repl_eval("new ReplC().value"),
+    // `await` in strings, comments and nested functions is not at the top level
+    transform_top_level_await("'await'; // await"),
+    transform_top_level_await("async function repl_f() { await 0; }"),
+    repl_eval("'await' /* await */"),
+]);
+)--", err).to_string();
+        REQUIRE(err == OK);
+        CHECK(results == R"--([null,3,null,null,"await"])--");
+
+        // top-level await requires typescript (as the parser) in node_modules
+        const String has_typescript = GodotJSScriptLanguage::get_singleton()->eval_source(R"--(
+(() => { try { require("typescript"); return true; } catch (error) { return false; } })();
+)--", err).to_string();
+        if (has_typescript == "true")
+        {
+            const String pending = GodotJSScriptLanguage::get_singleton()->eval_source(R"--(
+repl_eval("const repl_d = await Promise.resolve(4), { repl_e } = { repl_e: 5 }; repl_d + repl_e");
+)--", err).to_string();
+            CHECK(pending == "Promise { <pending> }");
+            env->update(0);
+            CHECK(GodotJSScriptLanguage::get_singleton()->eval_source("repl_d + repl_e", err).to_string() == "9");
+        }
+    }
+
+    TEST_CASE("[jsb] export pipeline drops unreachable modules")
+    {
+        GodotJSScriptLanguageIniter initer;
+
+        const std::shared_ptr<Environment> env = GodotJSScriptLanguage::get_singleton()->get_environment();
+        JSB_TESTS_EXECUTION_SCOPE(env.get());
+
+        const String dir = "res://jsb_export_test";
+        REQUIRE(DirAccess::make_dir_recursive_absolute(dir) == OK);
+        const auto write_module = [&](const String& p_name, const String& p_source)
+        {
+            const Ref<FileAccess> f = FileAccess::open(dir.path_join(p_name), FileAccess::WRITE);
+            REQUIRE(f.is_valid());
+            f->store_string(p_source);
+        };
+        write_module("root.js", "exports.value = require(\"./used\").value + require(\"godot\").PI;");
+        write_module("used.js", "exports.value = 1;");
+        write_module("unused.js", "exports.value = require(\"./used\").value;");
+
+        weaver::ExportPipeline pipeline;
+        pipeline.begin(env, false);
+        pipeline.build({ dir.path_join("root.js"), dir.path_join("unused.js") });
+        CHECK(pipeline.get_modules().size() == 3);
+
+        HashSet<String> reachable;
+        pipeline.collect_reachable({ dir.path_join("root.js") }, reachable);
+        CHECK(reachable.size() == 2);
+        CHECK(reachable.has(dir.path_join("root.js")));
+        CHECK(reachable.has(dir.path_join("used.js")));
+        CHECK(!reachable.has(dir.path_join("unused.js")));
+        pipeline.end();
+
+        const Ref<DirAccess> dir_access = DirAccess::open(dir);
+        REQUIRE(dir_access.is_valid());
+        for (const char* name : { "root.js", "used.js", "unused.js" }) dir_access->remove(name);
+        DirAccess::remove_absolute(dir);
+    }
+
+#if JSB_SUPPORT_RELOAD
+    // prototypes of live instances are patched in place if the shape of the class is unchanged
+    TEST_CASE("[jsb] reload script class in place")
+    {
+        GodotJSScriptLanguageIniter initer;
+
+        const std::shared_ptr<Environment> env = GodotJSScriptLanguage::get_singleton()->get_environment();
+        JSB_TESTS_EXECUTION_SCOPE(env.get());
+
+        const String dir = "res://jsb_reload_test";
+        const String path = dir.path_join("reload.js");
+        REQUIRE(DirAccess::make_dir_recursive_absolute(dir) == OK);
+        const auto reload = [&](int p_value, const char* p_signal_arguments)
+        {
+            {
+                const Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+                REQUIRE(f.is_valid());
+                f->store_string(vformat(R"--(
+class ReloadTest extends require("godot").Node { value() { return %d; } }
+require("godot-jsb").internal.add_script_signal(ReloadTest.prototype, "changed", [%s]);
+exports.default = ReloadTest;
+)--", p_value, p_signal_arguments));
+            }
+            if (JavaScriptModule* module = env->get_module_cache().find(path)) module->reload_requested = true;
+            Error err;
+            GodotJSScriptLanguage::get_singleton()->eval_source(vformat("require(\"%s\");", path), err);
+            REQUIRE(err == OK);
+        };
+        const auto get_class_info = [&]()
+        {
+            const JavaScriptModule* module = env->get_module_cache().find(path);
+            REQUIRE(module);
+            return env->get_script_class(module->script_class_id);
+        };
+        const auto eval = [&](const char* p_source)
+        {
+            Error err;
+            const String result = GodotJSScriptLanguage::get_singleton()->eval_source(p_source, err).to_string();
+            REQUIRE(err == OK);
+            return result;
+        };
+        const String track_live_instance = vformat("globalThis.reload_obj = Object.create(require(\"%s\").default.prototype);", path);
+
+        reload(1, "\"a\"");
+        eval(track_live_instance.utf8().get_data());
+        CHECK(get_class_info()->live_prototypes.size() == 1);
+
+        // unchanged shape, the previous prototype is patched
+        reload(2, "\"b\"");
+        CHECK((get_class_info()->flags & ScriptClassFlags::_Patched) != 0);
+        CHECK(get_class_info()->live_prototypes.size() == 2);
+        CHECK(eval("reload_obj.value()") == "2");
+
+        // the argument count of a signal changed
+        reload(3, "\"a\", \"b\"");
+        CHECK((get_class_info()->flags & ScriptClassFlags::_Patched) == 0);
+        CHECK(get_class_info()->live_prototypes.size() == 1);
+        CHECK(get_class_info()->signals.get("changed").arguments.size() == 2);
+        CHECK(eval("reload_obj.value()") == "2");
+
+        // prototypes not referenced by any instance are pruned
+        eval(track_live_instance.utf8().get_data());
+        reload(4, "\"a\", \"b\"");
+        reload(5, "\"a\", \"b\"");
+        CHECK(get_class_info()->live_prototypes.size() == 3);
+        env->gc();
+        reload(6, "\"a\", \"b\"");
+        CHECK((get_class_info()->flags & ScriptClassFlags::_Patched) != 0);
+        CHECK(get_class_info()->live_prototypes.size() < 4);
+        CHECK(eval("reload_obj.value()") == "6");
+
+        eval("delete globalThis.reload_obj;");
+        DirAccess::remove_absolute(path);
+        DirAccess::remove_absolute(dir);
+    }
+#endif
+#endif
 }
 
 #endif
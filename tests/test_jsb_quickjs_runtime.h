@@ -41,6 +41,133 @@ namespace jsb::tests
         JS_FreeContext(ctx);
         JS_FreeRuntime(rt);
     }
+
+#if JSB_VALUETYPE_RECYCLING
+    struct ValuetypePoolTestScope
+    {
+        std::shared_ptr<Environment> env;
+
+        ValuetypePoolTestScope() : env(GodotJSScriptLanguage::get_singleton()->get_environment())
+        {
+            // start with an empty pool
+            env->update(0);
+            env->get_valuetype_pool().clear(env->get_isolate());
+            eval("globalThis.src = new (require(\"godot\").Vector2)(-1, -2);");
+        }
+
+        ~ValuetypePoolTestScope()
+        {
+            eval("delete globalThis.src;");
+        }
+
+        String eval(const String& p_source) const
+        {
+            Error err;
+            const String result = GodotJSScriptLanguage::get_singleton()->eval_source(p_source, err).to_string();
+            REQUIRE(err == OK);
+            return result;
+        }
+
+        // the Variant bound to a global wrapper
+        const Variant* get_variant(const char* p_name) const
+        {
+            v8::Isolate* isolate = env->get_isolate();
+            const v8::Local<v8::Context> context = env->get_context();
+            const v8::Local<v8::Value> value = context->Global()->Get(context, impl::Helper::new_string(isolate, p_name)).ToLocalChecked();
+            REQUIRE(value->IsObject());
+            return (const Variant*) value.As<v8::Object>()->GetAlignedPointerFromInternalField(IF_Pointer);
+        }
+
+        uint32_t get_recycled() const
+        {
+            Statistics stats;
+            env->get_statistics(stats);
+            return stats.valuetypes_recycled;
+        }
+    };
+
+    TEST_CASE("[jsb] quickjs.valuetype_recycling")
+    {
+        GodotJSScriptLanguageIniter initer;
+        JSB_TESTS_EXECUTION_SCOPE(GodotJSScriptLanguage::get_singleton()->get_environment().get());
+        const ValuetypePoolTestScope scope;
+        const ValuetypePool& pool = scope.env->get_valuetype_pool();
+
+        // a wrapper kept by scripts keeps its value, the unreferenced one goes into the pool
+        scope.eval("globalThis.kept = src.abs(); src.abs(); undefined");
+        scope.env->update(0);
+        CHECK(pool.get_free_num() == 1);
+        CHECK(scope.get_recycled() == 0);
+
+        // the pooled wrapper is reused (and returned to the pool again)
+        CHECK(scope.eval("String(src.abs().y)") == "2");
+        scope.env->update(0);
+        CHECK(scope.get_recycled() == 1);
+        CHECK(pool.get_free_num() == 1);
+        CHECK(scope.eval("kept.x + ',' + kept.y") == "1,2");
+
+        // a wrapper with an own property is not reused
+        scope.eval("src.abs().tag = 1; undefined");
+        scope.env->update(0);
+        CHECK(pool.get_free_num() == 0);
+
+        // a wrapper used as a WeakMap key is not reused
+        scope.eval("globalThis.wm = new WeakMap(); wm.set(src.abs(), 'stale'); undefined");
+        scope.env->update(0);
+        CHECK(pool.get_free_num() == 0);
+        CHECK(scope.eval("String(wm.has(src.abs()))") == "false");
+
+        scope.eval("delete globalThis.kept; delete globalThis.wm;");
+        scope.env->update(0);
+    }
+
+    // the Variants of tracked wrappers are allocated in the nursery, the survivors are promoted into VariantAllocator at the end of frame
+    TEST_CASE("[jsb] quickjs.valuetype_nursery")
+    {
+        GodotJSScriptLanguageIniter initer;
+        JSB_TESTS_EXECUTION_SCOPE(GodotJSScriptLanguage::get_singleton()->get_environment().get());
+        const ValuetypePoolTestScope scope;
+        ValuetypePool& pool = scope.env->get_valuetype_pool();
+#if JSB_DEBUG
+        Statistics stats;
+        scope.env->get_statistics(stats);
+        const uint32_t num_allocated = stats.allocated_variants;
+#endif
+
+        // one survivor, one pooled, and one temporary with a property (dies in the nursery)
+        scope.eval("globalThis.kept = src.abs(); src.abs(); src.abs().tag = 1; undefined");
+        const Variant* nursery_variant = scope.get_variant("kept");
+        CHECK(pool.owns_variant(nursery_variant));
+        scope.env->update(0);
+
+        // IF_Pointer of the survivor is rewritten to a Variant allocated by VariantAllocator
+        const Variant* promoted = scope.get_variant("kept");
+        CHECK(promoted != nursery_variant);
+        CHECK(!pool.owns_variant(promoted));
+        CHECK(*promoted == Variant(Vector2(1, 2)));
+        CHECK(pool.get_free_num() == 1);
+#if JSB_DEBUG
+        scope.env->get_statistics(stats);
+        CHECK(stats.allocated_variants == num_allocated + 2);
+#endif
+
+        // the nursery is reused in the next frame, the promoted one is intact
+        scope.eval("for (let i = 0; i < 16; ++i) src.abs().tag = i; undefined");
+        CHECK(scope.eval("kept.x + ',' + kept.y") == "1,2");
+        scope.env->update(0);
+        CHECK(scope.eval("kept.x + ',' + kept.y") == "1,2");
+
+        // dropped wrappers are released once (the allocator is balanced after all released)
+        scope.eval("delete globalThis.kept;");
+        scope.env->gc();
+        scope.env->update(0);
+        pool.clear(scope.env->get_isolate());
+#if JSB_DEBUG
+        scope.env->get_statistics(stats);
+        CHECK(stats.allocated_variants == num_allocated);
+#endif
+    }
+#endif
 }
 #endif
 
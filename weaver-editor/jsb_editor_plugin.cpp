@@ -5,6 +5,7 @@
 #include "editor/editor_node.h"
 #include "scene/gui/popup_menu.h"
 #include "editor/gui/editor_toaster.h"
+#include "core/io/json.h"
 
 #define JSB_TYPE_ROOT "typings"
 
@@ -40,6 +41,12 @@ void GodotJSEditorPlugin::_notification(int p_what)
 {
     switch (p_what)
     {
+    case NOTIFICATION_ENTER_TREE:
+        EditorFileSystem::get_singleton()->connect("filesystem_changed", callable_mp(this, &GodotJSEditorPlugin::_on_filesystem_changed));
+        break;
+    case NOTIFICATION_EXIT_TREE:
+        EditorFileSystem::get_singleton()->disconnect("filesystem_changed", callable_mp(this, &GodotJSEditorPlugin::_on_filesystem_changed));
+        break;
     case NOTIFICATION_APPLICATION_FOCUS_IN:
         if (GodotJSScriptLanguage* lang = GodotJSScriptLanguage::get_singleton())
         {
@@ -50,6 +57,62 @@ void GodotJSEditorPlugin::_notification(int p_what)
     }
 }
 
+void GodotJSEditorPlugin::_on_filesystem_changed()
+{
+#if JSB_USE_TYPESCRIPT && !JSB_WITH_WEB && !JSB_WITH_JAVASCRIPTCORE
+    if (!jsb::internal::Settings::is_transpile_on_change_enabled()) return;
+    if (!FileAccess::exists("res://node_modules/typescript/lib/typescript.js")) return;
+
+    EditorFileSystemDirectory* root = EditorFileSystem::get_singleton()->get_filesystem();
+    if (!root) return;
+
+    Vector<String> changed;
+    collect_changed_typescripts(root, changed);
+    typescript_scanned_ = true;
+    if (!changed.is_empty())
+    {
+        transpile_typescripts(changed);
+    }
+#endif
+}
+
+void GodotJSEditorPlugin::collect_changed_typescripts(EditorFileSystemDirectory* p_dir, Vector<String>& r_changed)
+{
+    for (int index = 0, num = p_dir->get_file_count(); index < num; ++index)
+    {
+        const String path = p_dir->get_file_path(index);
+        if (!path.ends_with("." JSB_TYPESCRIPT_EXT) || path.ends_with(".d." JSB_TYPESCRIPT_EXT)) continue;
+
+        const uint64_t modified_time = p_dir->get_file_modified_time(index);
+        if (const uint64_t* last_modified_time = typescript_modified_times_.getptr(path))
+        {
+            if (*last_modified_time != modified_time)
+            {
+                r_changed.push_back(path);
+            }
+        }
+        else if (typescript_scanned_)
+        {
+            // newly added
+            r_changed.push_back(path);
+        }
+        else
+        {
+            // the first scan, only outdated outputs (changed while the editor is not running) are transpiled
+            const uint64_t output_modified_time = FileAccess::get_modified_time(jsb::internal::PathUtil::convert_typescript_path(path));
+            if (output_modified_time < modified_time)
+            {
+                r_changed.push_back(path);
+            }
+        }
+        typescript_modified_times_[path] = modified_time;
+    }
+    for (int index = 0, num = p_dir->get_subdir_count(); index < num; ++index)
+    {
+        collect_changed_typescripts(p_dir->get_subdir(index), r_changed);
+    }
+}
+
 void GodotJSEditorPlugin::_on_menu_pressed(int p_what)
 {
     switch (p_what)
@@ -372,14 +435,49 @@ void GodotJSEditorPlugin::generate_godot_dts()
     GodotJSScriptLanguage* lang = GodotJSScriptLanguage::get_singleton();
     jsb_check(lang);
     Error err;
-    const String code = jsb_format(R"--((function(){const mod = require("jsb.editor.codegen"); (new mod.default("%s")).emit();})())--", "./" JSB_TYPE_ROOT);
+    const String cache_path = jsb::internal::Settings::get_codegen_cache_path();
+#if !JSB_WITH_WEB && !JSB_WITH_JAVASCRIPTCORE
+    // generate in a JSWorker to keep the editor responsive, the result is reported by the worker when finished
+    const String code = jsb_format(R"--(require("jsb.editor.codegen.worker").emit_in_worker("%s", "%s"))--", "./" JSB_TYPE_ROOT, cache_path);
+    const bool started = lang->eval_source(code, err).to_variant();
+    ERR_FAIL_COND_MSG(err != OK, "failed to evaluate jsb.editor.codegen.worker");
+
+    const String toast_message = started ? TTR("generating godot.d.ts in background") : TTR("godot.d.ts generation is already in progress");
+#else
+    const String code = jsb_format(R"--((function(){const mod = require("jsb.editor.codegen"); (new mod.default("%s", "%s")).emit();})())--", "./" JSB_TYPE_ROOT, cache_path);
     lang->eval_source(code, err).ignore();
     ERR_FAIL_COND_MSG(err != OK, "failed to evaluate jsb.editor.codegen");
 
     const String toast_message = TTR("godot.d.ts generated successfully");
+#endif
     EditorToaster::get_singleton()->popup_str(toast_message, EditorToaster::SEVERITY_INFO);
 }
 
+void GodotJSEditorPlugin::transpile_typescripts(const Vector<String>& p_paths)
+{
+#if !JSB_WITH_WEB && !JSB_WITH_JAVASCRIPTCORE
+    GodotJSScriptLanguage* lang = GodotJSScriptLanguage::get_singleton();
+    jsb_check(lang);
+
+    Array files;
+    for (const String& path : p_paths)
+    {
+        Dictionary file;
+        file["source"] = path;
+        file["output"] = jsb::internal::PathUtil::convert_typescript_path(path);
+        files.push_back(file);
+    }
+    JSB_LOG(Verbose, "transpile %d changed typescripts", p_paths.size());
+
+    Error err;
+    const String code = jsb_format(R"--(require("jsb.editor.transpile").transpile_in_worker(%s, "%s"))--", JSON::stringify(files), jsb::internal::Settings::get_transpile_cache_path());
+    lang->eval_source(code, err).ignore();
+    ERR_FAIL_COND_MSG(err != OK, "failed to evaluate jsb.editor.transpile");
+#else
+    JSB_LOG(Warning, "transpiling in editor is not supported without JSWorker");
+#endif
+}
+
 void GodotJSEditorPlugin::load_editor_entry_module()
 {
     GodotJSScriptLanguage* lang = GodotJSScriptLanguage::get_singleton();
@@ -419,6 +517,13 @@ void GodotJSEditorPlugin::start_tsc_watch()
     List<String> args;
     args.push_back("./node_modules/typescript/bin/tsc");
     args.push_back("-w");
+#if !JSB_WITH_WEB && !JSB_WITH_JAVASCRIPTCORE
+    if (jsb::internal::Settings::is_transpile_on_change_enabled())
+    {
+        // changed sources are transpiled in the editor, tsc is only used for type-checking
+        args.push_back("--noEmit");
+    }
+#endif
 
 #ifdef WINDOWS_ENABLED
     const String exe_path = "node.exe";
@@ -53,12 +53,19 @@ private:
 
     std::shared_ptr<jsb::internal::Process> tsc_;
 
+    // last seen modified time of typescript sources (to find changed sources after the filesystem is scanned)
+    HashMap<String, uint64_t> typescript_modified_times_;
+    bool typescript_scanned_ = false;
+
 protected:
     static void _bind_methods();
 
     void _notification(int p_what);
     void _on_menu_pressed(int p_what);
     void _on_confirm_overwrite();
+    void _on_filesystem_changed();
+
+    void collect_changed_typescripts(EditorFileSystemDirectory* p_dir, Vector<String>& r_changed);
 
     // Add install file info.
     // Crash if the given info is invalid, ensure to update the preset list in C++ code after it changed in SCsub.
@@ -87,6 +94,9 @@ public:
     static GodotJSEditorPlugin* get_singleton();
 
     static void generate_godot_dts();
+
+    // transpile typescript sources in a dedicated worker without type-checking, the changed scripts are reloaded after written
+    static void transpile_typescripts(const Vector<String>& p_paths);
     static void ignore_node_modules();
     static void collect_invalid_files(Vector<String>& r_invalid_files);
     static void collect_invalid_files(const String& p_path, Vector<String>& r_invalid_files);
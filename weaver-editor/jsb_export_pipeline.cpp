@@ -0,0 +1,293 @@
+#include "jsb_export_pipeline.h"
+#include "../internal/jsb_script_lexer.h"
+#include "../bridge/jsb_environment.h"
+#include "../bridge/jsb_module_resolver.h"
+
+#define JSB_EXPORTER_LOG(Severity, Format, ...) JSB_LOG_IMPL(JSExporter, Severity, Format, ##__VA_ARGS__)
+
+namespace jsb::weaver
+{
+    namespace
+    {
+        constexpr uint32_t kCacheMagic = 0x4542534A; // 'JSBE'
+        constexpr uint32_t kCacheVersion = 2;
+
+        constexpr char kSourceMappingURL[] = "//# sourceMappingURL=";
+
+        // remove the trailing `//# sourceMappingURL=...` line, the runtime locates source maps by path instead
+        void strip_source_mapping_url(Vector<uint8_t>& p_content)
+        {
+            int64_t end = p_content.size();
+            const uint8_t* ptr = p_content.ptr();
+            while (end > 0 && (ptr[end - 1] == '\n' || ptr[end - 1] == '\r' || ptr[end - 1] == ' ')) --end;
+            int64_t begin = end;
+            while (begin > 0 && ptr[begin - 1] != '\n') --begin;
+            constexpr int64_t len = (int64_t) sizeof(kSourceMappingURL) - 1;
+            if (end - begin >= len && memcmp(ptr + begin, kSourceMappingURL, len) == 0)
+            {
+                p_content.resize(begin);
+            }
+        }
+    }
+
+    void ExportPipeline::begin(const std::shared_ptr<Environment>& p_env, bool p_with_source_map)
+    {
+        env_ = p_env;
+        with_source_map_ = p_with_source_map;
+        modules_.clear();
+        used_paths_.clear();
+        load_cache();
+    }
+
+    void ExportPipeline::end()
+    {
+        save_cache();
+        modules_.clear();
+        cache_.clear();
+        used_paths_.clear();
+        env_.reset();
+    }
+
+    void ExportPipeline::scan_requires(const uint8_t* p_source, size_t p_len, ModuleDependencyInfo& r_info)
+    {
+        ScriptLexer lexer(p_source, p_len);
+        ScriptToken last;
+        for (ScriptToken token = lexer.next(); token.kind != ScriptToken::End; last = token, token = lexer.next())
+        {
+            // `require(...)`, but not `obj.require(...)`
+            if (!lexer.is_identifier(token, "require") || lexer.is_punct(last, '.')) continue;
+            last = token;
+            token = lexer.next();
+            if (!lexer.is_punct(token, '(')) continue;
+
+            last = token;
+            token = lexer.next();
+            String specifier;
+            if (lexer.get_literal_string(token, specifier))
+            {
+                last = token;
+                token = lexer.next();
+                if (lexer.is_punct(token, ')'))
+                {
+                    r_info.requires.push_back(specifier);
+                    continue;
+                }
+            }
+            r_info.has_dynamic_require = true;
+        }
+    }
+
+    void ExportPipeline::_process(void* p_userdata, uint32_t p_index)
+    {
+        const Wave* wave = (const Wave*) p_userdata;
+        ExportModule& module = *wave->modules[p_index];
+
+        module.modified_time = FileAccess::get_modified_time(module.path);
+        module.content = FileAccess::get_file_as_bytes(module.path, &module.error);
+        if (module.error != OK) return;
+
+        if (wave->pipeline->with_source_map_)
+        {
+            Error err;
+            module.source_map = FileAccess::get_file_as_bytes(module.path + ".map", &err);
+        }
+
+        // `cache_` is not modified until all tasks in the wave are finished
+        const CacheEntry* cached = wave->pipeline->cache_.getptr(module.path);
+        if (cached && cached->modified_time == module.modified_time && cached->size == (uint64_t) module.content.size())
+        {
+            module.dependency_info = cached->dependency_info;
+        }
+        else
+        {
+            scan_requires(module.content.ptr(), module.content.size(), module.dependency_info);
+            module.scanned = true;
+        }
+
+        if (!wave->pipeline->with_source_map_)
+        {
+            strip_source_mapping_url(module.content);
+        }
+    }
+
+    bool ExportPipeline::resolve(const ExportModule& p_parent, const String& p_specifier, ModuleSourceInfo& r_source_info) const
+    {
+        // modules provided by module loaders (godot, godot-jsb etc.) are not files
+        if (env_->find_module_loader(p_specifier))
+        {
+            return false;
+        }
+
+        String normalized_id;
+        if (p_specifier.begins_with("./") || p_specifier.begins_with("../"))
+        {
+            const String combined_id = internal::PathUtil::combine(internal::PathUtil::dirname(p_parent.path), p_specifier);
+            if (internal::PathUtil::extract(combined_id, normalized_id) != OK || normalized_id.is_empty())
+            {
+                return false;
+            }
+        }
+        else
+        {
+            normalized_id = p_specifier;
+        }
+
+        if (!env_->find_module_resolver(normalized_id, r_source_info))
+        {
+            JSB_EXPORTER_LOG(Warning, "unresolved module '%s' required by %s", p_specifier, p_parent.path);
+            return false;
+        }
+        return r_source_info.source_filepath.begins_with("res://");
+    }
+
+    void ExportPipeline::build(const Vector<String>& p_paths)
+    {
+        jsb_check(env_);
+        Wave wave = { this, {} };
+        for (const String& path : p_paths)
+        {
+            if (modules_.has(path)) continue;
+            ExportModule& module = modules_[path];
+            module.path = path;
+            wave.modules.push_back(&module);
+        }
+
+        while (!wave.modules.is_empty())
+        {
+#if JSB_THREADING
+            WorkerThreadPool* pool = WorkerThreadPool::get_singleton();
+            const WorkerThreadPool::GroupID group_id = pool->add_native_group_task(&_process, &wave, (int) wave.modules.size(), -1, true, "jsb.export");
+            pool->wait_for_group_task_completion(group_id);
+#else
+            for (uint32_t index = 0; index < wave.modules.size(); ++index)
+            {
+                _process(&wave, index);
+            }
+#endif
+
+            // resolve dependencies in the main thread, and collect the next wave
+            LocalVector<ExportModule*> next;
+            for (ExportModule* module : wave.modules)
+            {
+                if (module->error != OK)
+                {
+                    JSB_EXPORTER_LOG(Error, "can't read JS source from %s, please ensure that 'tsc' has being executed properly.", module->path);
+                    continue;
+                }
+                if (module->scanned)
+                {
+                    cache_.insert(module->path, { module->modified_time, (uint64_t) module->content.size(), module->dependency_info });
+                    cache_dirty_ = true;
+                }
+                used_paths_.insert(module->path);
+                if (module->dependency_info.has_dynamic_require)
+                {
+                    JSB_EXPORTER_LOG(Verbose, "dynamic require in %s", module->path);
+                }
+
+                for (const String& specifier : module->dependency_info.requires)
+                {
+                    ModuleSourceInfo source_info;
+                    if (!resolve(*module, specifier, source_info)) continue;
+                    module->dependencies.push_back(source_info.source_filepath);
+                    if (modules_.has(source_info.source_filepath)) continue;
+
+                    ExportModule& dependency = modules_[source_info.source_filepath];
+                    dependency.path = source_info.source_filepath;
+                    dependency.package_filepath = source_info.package_filepath;
+                    next.push_back(&dependency);
+                }
+            }
+            JSB_EXPORTER_LOG(Verbose, "%d modules processed, %d dependencies to process", wave.modules.size(), next.size());
+            wave.modules = next;
+        }
+    }
+
+    void ExportPipeline::collect_reachable(const Vector<String>& p_roots, HashSet<String>& r_paths) const
+    {
+        LocalVector<const ExportModule*> stack;
+        for (const String& path : p_roots)
+        {
+            if (r_paths.has(path)) continue;
+            if (const ExportModule* module = modules_.getptr(path))
+            {
+                r_paths.insert(path);
+                stack.push_back(module);
+            }
+        }
+        while (!stack.is_empty())
+        {
+            const ExportModule* module = stack[stack.size() - 1];
+            stack.resize(stack.size() - 1);
+            for (const String& dependency : module->dependencies)
+            {
+                if (r_paths.has(dependency)) continue;
+                if (const ExportModule* dependent_module = modules_.getptr(dependency))
+                {
+                    r_paths.insert(dependency);
+                    stack.push_back(dependent_module);
+                }
+            }
+        }
+    }
+
+    void ExportPipeline::load_cache()
+    {
+        cache_.clear();
+        cache_dirty_ = false;
+        const Ref<FileAccess> file = FileAccess::open(internal::Settings::get_export_cache_path(), FileAccess::READ);
+        if (file.is_null()) return;
+        if (file->get_32() != kCacheMagic || file->get_32() != kCacheVersion)
+        {
+            JSB_EXPORTER_LOG(Verbose, "export cache is outdated");
+            return;
+        }
+        const uint32_t count = file->get_32();
+        for (uint32_t index = 0; index < count && !file->eof_reached(); ++index)
+        {
+            const String path = file->get_pascal_string();
+            CacheEntry entry;
+            entry.modified_time = file->get_64();
+            entry.size = file->get_64();
+            entry.dependency_info.has_dynamic_require = file->get_8() != 0;
+            const uint32_t num = file->get_32();
+            for (uint32_t i = 0; i < num && !file->eof_reached(); ++i)
+            {
+                entry.dependency_info.requires.push_back(file->get_pascal_string());
+            }
+            cache_.insert(path, entry);
+        }
+        JSB_EXPORTER_LOG(Verbose, "%d entries loaded from export cache", cache_.size());
+    }
+
+    void ExportPipeline::save_cache()
+    {
+        // entries not used in this export are dropped
+        if (!cache_dirty_ && used_paths_.size() == cache_.size()) return;
+
+        const Ref<FileAccess> file = FileAccess::open(internal::Settings::get_export_cache_path(), FileAccess::WRITE);
+        if (file.is_null())
+        {
+            JSB_EXPORTER_LOG(Warning, "failed to write export cache");
+            return;
+        }
+        file->store_32(kCacheMagic);
+        file->store_32(kCacheVersion);
+        file->store_32(used_paths_.size());
+        for (const String& path : used_paths_)
+        {
+            const CacheEntry& entry = cache_[path];
+            const ModuleDependencyInfo& info = entry.dependency_info;
+            file->store_pascal_string(path);
+            file->store_64(entry.modified_time);
+            file->store_64(entry.size);
+            file->store_8(info.has_dynamic_require ? 1 : 0);
+            file->store_32(info.requires.size());
+            for (const String& specifier : info.requires)
+            {
+                file->store_pascal_string(specifier);
+            }
+        }
+        cache_dirty_ = false;
+    }
+}
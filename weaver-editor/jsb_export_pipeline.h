@@ -0,0 +1,110 @@
+#ifndef GODOTJS_EXPORT_PIPELINE_H
+#define GODOTJS_EXPORT_PIPELINE_H
+
+#include "jsb_editor_pch.h"
+
+namespace jsb
+{
+    class Environment;
+}
+
+namespace jsb::weaver
+{
+    // static dependencies of a compiled script, scanned from `require("...")` calls
+    struct ModuleDependencyInfo
+    {
+        // specifiers of `require` calls with a string literal
+        Vector<String> requires;
+
+        // true if `require` is called with a non-literal argument (it can not be resolved statically)
+        bool has_dynamic_require = false;
+    };
+
+    struct ExportModule
+    {
+        // the compiled script path (also used as the module id)
+        String path;
+
+        // [optional] filepath of package.json which the module is resolved from
+        String package_filepath;
+
+        Error error = OK;
+
+        // the transformed content to pack
+        Vector<uint8_t> content;
+
+        // [optional] the source map (only if packaging with source map)
+        Vector<uint8_t> source_map;
+
+        // modification time of the compiled script, it's the key of the cache with the path and the content size
+        uint64_t modified_time = 0;
+
+        // true if not found in the cache
+        bool scanned = false;
+        ModuleDependencyInfo dependency_info;
+
+        // resolved paths of `dependency_info.requires` (modules provided by module loaders are excluded)
+        Vector<String> dependencies;
+    };
+
+    // read, transform and scan compiled scripts for exporting.
+    //   * the dependency graph is walked wave by wave, all modules in a wave are processed in WorkerThreadPool.
+    //   * scanned dependencies are cached by path, modification time and size (between exports), unchanged modules are not scanned again.
+    //   * modules are only resolved but never executed (unlike loading them in the Environment).
+    class ExportPipeline
+    {
+    public:
+        // clear all built modules and load the cache
+        void begin(const std::shared_ptr<Environment>& p_env, bool p_with_source_map);
+
+        // write the cache and release all built modules
+        void end();
+
+        // process all modules reachable from the given paths (already built modules are skipped)
+        void build(const Vector<String>& p_paths);
+
+        // return nullptr if the module is not built
+        const ExportModule* get(const String& p_path) const { return modules_.getptr(p_path); }
+
+        const HashMap<String, ExportModule>& get_modules() const { return modules_; }
+
+        // collect the built modules reachable from the given paths through the resolved dependencies
+        void collect_reachable(const Vector<String>& p_roots, HashSet<String>& r_paths) const;
+
+        static void scan_requires(const uint8_t* p_source, size_t p_len, ModuleDependencyInfo& r_info);
+
+    private:
+        struct Wave
+        {
+            ExportPipeline* pipeline;
+            LocalVector<ExportModule*> modules;
+        };
+
+        static void _process(void* p_userdata, uint32_t p_index);
+
+        bool resolve(const ExportModule& p_parent, const String& p_specifier, ModuleSourceInfo& r_source_info) const;
+
+        void load_cache();
+        void save_cache();
+
+        std::shared_ptr<Environment> env_;
+        bool with_source_map_ = false;
+
+        //NOTE elements of godot HashMap are stable in memory
+        HashMap<String, ExportModule> modules_;
+
+        struct CacheEntry
+        {
+            uint64_t modified_time = 0;
+            uint64_t size = 0;
+            ModuleDependencyInfo dependency_info;
+        };
+
+        // scanned dependencies by path, it's read-only while a wave is processing
+        HashMap<String, CacheEntry> cache_;
+        HashSet<String> used_paths_;
+        bool cache_dirty_ = false;
+    };
+}
+
+#endif
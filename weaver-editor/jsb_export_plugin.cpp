@@ -1,7 +1,26 @@
 ﻿#include "jsb_export_plugin.h"
+#include "editor/editor_file_system.h"
 
 #define JSB_EXPORTER_LOG(Severity, Format, ...) JSB_LOG_IMPL(JSExporter, Severity, Format, ##__VA_ARGS__)
 
+namespace
+{
+    bool is_script_path(const String& p_path)
+    {
+        return p_path.ends_with("." JSB_TYPESCRIPT_EXT) || p_path.ends_with("." JSB_JAVASCRIPT_EXT);
+    }
+
+    // the path of the module to export for a script (.ts or .js), empty if it's not a script
+    String get_compiled_script_path(const String& p_path)
+    {
+        if (p_path.ends_with("." JSB_TYPESCRIPT_EXT))
+        {
+            return jsb::internal::PathUtil::convert_typescript_path(p_path);
+        }
+        return p_path.ends_with("." JSB_JAVASCRIPT_EXT) ? p_path : String();
+    }
+}
+
 GodotJSExportPlugin::GodotJSExportPlugin() : super()
 {
     // explicitly ignored files (not used by runtime)
@@ -27,24 +46,149 @@ void GodotJSExportPlugin::_export_begin(const HashSet<String>& p_features, bool
 {
     JSB_EXPORTER_LOG(Verbose, "export_begin path: %s", p_path);
     exported_paths_.clear();
+    eliminate_dead_modules_ = jsb::internal::Settings::is_packaging_dead_module_elimination();
+
+    // all scripts in the project, and the roots of the require graph
+    Vector<String> scripts;
+    Vector<String> roots;
+    if (EditorFileSystemDirectory* root = EditorFileSystem::get_singleton()->get_filesystem())
+    {
+        collect_scripts(root, scripts, roots);
+    }
 
     // add all explicitly included file paths in settings
+    // in this situation, we do not call `load module` to avoid unexpected side effects
+    // (for example, it's impossible to directly load worker scripts in main env).
+    // scripts are exported with their static dependencies resolved by the pipeline.
     const PackedStringArray file_paths = jsb::internal::Settings::get_packaging_include_files();
     for (const String& file_path : file_paths)
     {
-        // in this situation, we do not call `load module` to avoid unexpected side effects
-        // (for example, it's impossible to directly load worker scripts in main env).
-
-        if (file_path.ends_with("." JSB_TYPESCRIPT_EXT))
+        if (is_script_path(file_path))
         {
-            const String compiled_script_path = jsb::internal::PathUtil::convert_typescript_path(p_path);
-            export_raw_file(compiled_script_path);
+            roots.push_back(get_compiled_script_path(file_path));
         }
         else
         {
             export_raw_file(file_path);
         }
     }
+
+    // scripts which are not referenced by any resource but still loaded at runtime
+    if (eliminate_dead_modules_)
+    {
+        if (const String entry_script_path = jsb::internal::Settings::get_entry_script_path(); is_script_path(entry_script_path))
+        {
+            roots.push_back(get_compiled_script_path(entry_script_path));
+        }
+
+        List<PropertyInfo> properties;
+        ProjectSettings::get_singleton()->get_property_list(&properties);
+        for (const PropertyInfo& property : properties)
+        {
+            if (!property.name.begins_with("autoload/")) continue;
+            String autoload_path = GLOBAL_GET(property.name);
+            if (autoload_path.begins_with("*"))
+            {
+                autoload_path = autoload_path.substr(1);
+            }
+            if (is_script_path(autoload_path))
+            {
+                roots.push_back(get_compiled_script_path(autoload_path));
+            }
+        }
+    }
+
+    // read and scan all scripts (and their dependencies) in parallel, only once.
+    // the reachable modules are exported here, `_export_file` only skips the script files then.
+    scripts.append_array(roots);
+    pipeline_.begin(env_, jsb::internal::Settings::is_packaging_with_source_map());
+    pipeline_.build(scripts);
+    export_reachable_scripts(roots);
+}
+
+void GodotJSExportPlugin::collect_scripts(EditorFileSystemDirectory* p_dir, Vector<String>& r_scripts, Vector<String>& r_roots) const
+{
+    for (int index = 0, num = p_dir->get_file_count(); index < num; ++index)
+    {
+        const String path = p_dir->get_file_path(index);
+        if (path.ends_with("." JSB_TYPESCRIPT_EXT))
+        {
+            if (!path.ends_with(".d." JSB_TYPESCRIPT_EXT))
+            {
+                r_scripts.push_back(get_compiled_script_path(path));
+            }
+            continue;
+        }
+        if (path.ends_with("." JSB_JAVASCRIPT_EXT))
+        {
+            // candidates to report if unreachable
+            if (eliminate_dead_modules_)
+            {
+                r_scripts.push_back(path);
+            }
+            continue;
+        }
+        if (!eliminate_dead_modules_ || ignored_paths_.has(path)) continue;
+
+        // scripts attached to resources (scenes, sub-resources etc.), the dependencies are cached by EditorFileSystem
+        for (const String& dependency : p_dir->get_file_deps(index))
+        {
+            if (dependency.begins_with("res://") && is_script_path(dependency))
+            {
+                r_roots.push_back(get_compiled_script_path(dependency));
+            }
+        }
+    }
+    for (int index = 0, num = p_dir->get_subdir_count(); index < num; ++index)
+    {
+        collect_scripts(p_dir->get_subdir(index), r_scripts, r_roots);
+    }
+}
+
+void GodotJSExportPlugin::_export_end()
+{
+    report_dead_modules();
+    pipeline_.end();
+}
+
+void GodotJSExportPlugin::report_dead_modules()
+{
+    int dead_modules = 0;
+    uint64_t dead_bytes = 0;
+    for (const KeyValue<String, jsb::weaver::ExportModule>& pair : pipeline_.get_modules())
+    {
+        const jsb::weaver::ExportModule& module = pair.value;
+        if (module.error != OK) continue;
+        if (exported_paths_.has(module.path))
+        {
+            // modules required dynamically can not be found by the static analysis
+            if (module.dependency_info.has_dynamic_require)
+            {
+                JSB_EXPORTER_LOG(Warning, "dynamic require in %s, modules required dynamically are not exported unless explicitly included", module.path);
+            }
+            continue;
+        }
+        ++dead_modules;
+        dead_bytes += module.content.size() + module.source_map.size();
+        JSB_EXPORTER_LOG(Verbose, "unreachable module: %s", module.path);
+    }
+
+    if (dead_modules == 0) return;
+    if (eliminate_dead_modules_)
+    {
+        JSB_EXPORTER_LOG(Log, "%d unreachable modules eliminated (%s saved)", dead_modules, String::humanize_size(dead_bytes));
+    }
+    else
+    {
+        JSB_EXPORTER_LOG(Verbose, "%d unreachable modules (%s) could be eliminated by enabling %s", dead_modules, String::humanize_size(dead_bytes),
+            JSB_MODULE_NAME_STRING "/editor/packaging/eliminate_dead_modules");
+    }
+}
+
+void GodotJSExportPlugin::export_content(const String& p_path, const Vector<uint8_t>& p_content)
+{
+    exported_paths_.insert(p_path);
+    add_file(p_path, p_content, false);
 }
 
 bool GodotJSExportPlugin::export_raw_file(const String& p_path)
@@ -59,32 +203,35 @@ bool GodotJSExportPlugin::export_raw_file(const String& p_path)
     {
         return false;
     }
-    exported_paths_.insert(p_path);
-    add_file(p_path, content, false);
+    export_content(p_path, content);
     JSB_EXPORTER_LOG(Verbose, "include raw: %s", p_path);
     return true;
 }
 
-bool GodotJSExportPlugin::export_module_files(const jsb::JavaScriptModule& p_module)
+bool GodotJSExportPlugin::export_module_files(const jsb::weaver::ExportModule& p_module)
 {
-    if (!export_raw_file(p_module.source_info.source_filepath))
+    if (p_module.error != OK)
     {
-        JSB_EXPORTER_LOG(Error, "can't read JS source from %s, please ensure that 'tsc' has being executed properly.", p_module.source_info.source_filepath);
         return false;
     }
+    export_content(p_module.path, p_module.content);
 
     if (jsb::internal::Settings::is_packaging_with_source_map())
     {
-        const String source_map_path = p_module.source_info.source_filepath + ".map";
-        if (!export_raw_file(source_map_path))
+        const String source_map_path = p_module.path + ".map";
+        if (p_module.source_map.is_empty())
         {
             JSB_EXPORTER_LOG(Verbose, "can't read the sourcemap from %s, please ensure that 'tsc' has being executed properly.", source_map_path);
         }
+        else
+        {
+            export_content(source_map_path, p_module.source_map);
+        }
     }
 
-    if (!p_module.source_info.package_filepath.is_empty() && !export_raw_file(p_module.source_info.package_filepath))
+    if (!p_module.package_filepath.is_empty() && !export_raw_file(p_module.package_filepath))
     {
-        JSB_EXPORTER_LOG(Error, "can't read the package.json from %s", p_module.source_info.package_filepath);
+        JSB_EXPORTER_LOG(Error, "can't read the package.json from %s", p_module.package_filepath);
         return false;
     }
     return true;
@@ -102,45 +249,27 @@ bool GodotJSExportPlugin::export_compiled_script(const String& p_path)
         return false;
     }
 
-    // export dependent files.
-    // force module loading. ensure the module hierarchy available.
-    if (jsb::JavaScriptModule* module; env_->load(p_path, &module) == OK)
+    // all modules are built in `_export_begin`
+    const jsb::weaver::ExportModule* module = pipeline_.get(p_path);
+    if (!module || !export_module_files(*module))
     {
-        v8::Isolate* isolate = env_->get_isolate();
-        v8::Isolate::Scope isolate_scope(isolate);
-        v8::HandleScope handle_scope(isolate);
-        const v8::Local<v8::Context> context = env_->get_context();
-        v8::Context::Scope context_scope(context);
+        JSB_EXPORTER_LOG(Warning, "failed to include module: %s", p_path);
+    }
+    return true;
+}
 
-        export_module_files(*module);
-        jsb::Environment* environment = jsb::Environment::wrap(isolate);
-        const v8::Local<v8::Object> module_obj = module->module.Get(isolate);
-        if (v8::Local<v8::Value> temp; module_obj->Get(context, jsb_name(environment, children)).ToLocal(&temp) && temp->IsArray())
+void GodotJSExportPlugin::export_reachable_scripts(const Vector<String>& p_roots)
+{
+    // dependencies are resolved statically by the pipeline, modules are not loaded
+    HashSet<String> reachable;
+    pipeline_.collect_reachable(p_roots, reachable);
+    for (const String& path : reachable)
+    {
+        if (export_compiled_script(path))
         {
-            const v8::Local<v8::Array> children = temp.As<v8::Array>();
-            const int32_t len = (int32_t) children->Length();
-            for (int i = 0; i < len; i++)
-            {
-                if (children->Get(context, i).ToLocal(&temp) && temp->IsObject())
-                {
-                    const v8::Local<v8::Object> child = temp.As<v8::Object>();
-                    if (child->Get(context, jsb_name(environment, filename)).ToLocal(&temp))
-                    {
-                        const String filename = jsb::impl::Helper::to_string(isolate, temp);
-                        if (export_compiled_script(filename))
-                        {
-                            JSB_EXPORTER_LOG(Verbose, "export dependent source: %s", filename);
-                        }
-                    }
-                }
-            }
+            JSB_EXPORTER_LOG(Verbose, "export source: %s", path);
         }
     }
-    else
-    {
-        JSB_EXPORTER_LOG(Warning, "failed to include module: %s", p_path);
-    }
-    return true;
 }
 
 void GodotJSExportPlugin::_export_file(const String& p_path, const String& p_type, const HashSet<String>& p_features)
@@ -149,26 +278,27 @@ void GodotJSExportPlugin::_export_file(const String& p_path, const String& p_typ
 
     if (p_path.ends_with("." JSB_TYPESCRIPT_EXT))
     {
-        const String compiled_script_path = jsb::internal::PathUtil::convert_typescript_path(p_path);
-        export_compiled_script(compiled_script_path);
-
         // always skip the typescript source from packing
         skip();
-        JSB_EXPORTER_LOG(Verbose, "export source: %s => %s", p_path, compiled_script_path);
+        if (eliminate_dead_modules_)
+        {
+            // already exported in `_export_begin` if it's reached from the roots
+            return;
+        }
+        export_reachable_scripts({ get_compiled_script_path(p_path) });
     }
-    else
+    else if (p_path.ends_with("." JSB_JAVASCRIPT_EXT))
     {
-        if (ignored_paths_.has(p_path))
+        if (eliminate_dead_modules_)
         {
+            // already exported in `_export_begin` if it's reached from the roots (reported if not)
             skip();
-            JSB_EXPORTER_LOG(Verbose, "ignored: %s", p_path);
         }
-
-        //TODO handle module deps if it's a .js file ?
-        // if (p_path.ends_with("." JSB_JAVASCRIPT_EXT))
-        // {
-        //     export_compiled_script(p_path);
-        // }
+    }
+    else if (ignored_paths_.has(p_path))
+    {
+        skip();
+        JSB_EXPORTER_LOG(Verbose, "ignored: %s", p_path);
     }
 }
 
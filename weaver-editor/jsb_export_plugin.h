@@ -2,12 +2,15 @@
 #define GODOTJS_EXPORT_PLUGIN_H
 
 #include "jsb_editor_pch.h"
+#include "jsb_export_pipeline.h"
 
 namespace jsb
 {
     class Environment;
 }
 
+class EditorFileSystemDirectory;
+
 // improve the pipeline of using typescripts
 class GodotJSExportPlugin: public EditorExportPlugin
 {
@@ -22,17 +25,26 @@ public:
 protected:
     virtual void _export_begin(const HashSet<String>& p_features, bool p_debug, const String& p_path, int p_flags) override;
     virtual void _export_file(const String& p_path, const String& p_type, const HashSet<String>& p_features) override;
+    virtual void _export_end() override;
 
     virtual PackedStringArray _get_export_features(const Ref<EditorExportPlatform>& p_export_platform, bool p_debug) const override;
 
 private:
+    // collect all scripts (compiled paths) in the project and the scripts referenced by resources (roots)
+    void collect_scripts(EditorFileSystemDirectory* p_dir, Vector<String>& r_scripts, Vector<String>& r_roots) const;
     bool export_compiled_script(const String& p_path);
-    bool export_module_files(const jsb::JavaScriptModule& p_module);
+    // export the modules (compiled paths) and all modules they require statically
+    void export_reachable_scripts(const Vector<String>& p_roots);
+    void report_dead_modules();
+    bool export_module_files(const jsb::weaver::ExportModule& p_module);
     bool export_raw_file(const String& p_path);
+    void export_content(const String& p_path, const Vector<uint8_t>& p_content);
 
     HashSet<String> ignored_paths_;
     HashSet<String> exported_paths_;
+    bool eliminate_dead_modules_ = false;
     std::shared_ptr<jsb::Environment> env_;
+    jsb::weaver::ExportPipeline pipeline_;
 };
 
 #endif
@@ -2,15 +2,18 @@
 #include "jsb_editor_pch.h"
 #include "jsb_editor_plugin.h"
 #include "../weaver/jsb_weaver_compat.h"
+#include "../internal/jsb_script_lexer.h"
 
 void GodotJSREPL::_bind_methods()
 {
     ClassDB::bind_method(D_METHOD("_backlog_flush"), &GodotJSREPL::_backlog_flush);
+    ClassDB::bind_method(D_METHOD("_evaluate", "text"), &GodotJSREPL::_evaluate);
 }
 
 GodotJSREPL::GodotJSREPL()
 {
     sn_backlog_flush_ = _scs_create("_backlog_flush");
+    sn_evaluate_ = _scs_create("_evaluate");
     //TODO list all created realm instances in REPL, interact with the currently selected one.
 
     input_submitting_ = false;
@@ -205,31 +208,83 @@ void GodotJSREPL::_generate_dts_pressed()
     GodotJSEditorPlugin::generate_godot_dts();
 }
 
-String GodotJSREPL::encode_string(const String& p_text)
+// static analysis of the input, match the trailing member access chain `a.b.c` (the last name could be incomplete).
+// nothing is matched if the chain contains calls, computed members or any other expressions,
+// since they can not be resolved without evaluating.
+static bool parse_completion_path(const String& p_text, Vector<String>& r_path, String& r_prefix)
 {
-    return p_text.replace("'", "\\'");
+    const CharString utf8 = p_text.utf8();
+    jsb::internal::ScriptLexer lexer((const uint8_t*) utf8.get_data(), utf8.length());
+    LocalVector<jsb::internal::ScriptToken> names;
+    jsb::internal::ScriptToken last;
+    bool valid = true;
+    bool expect_name = false;
+    for (jsb::internal::ScriptToken token = lexer.next(); token.kind != jsb::internal::ScriptToken::End; last = token, token = lexer.next())
+    {
+        if (lexer.is_identifier(token))
+        {
+            if (!expect_name)
+            {
+                // a new chain starts
+                names.clear();
+                valid = true;
+            }
+            names.push_back(token);
+            expect_name = false;
+        }
+        else if (lexer.is_punct(token, '.'))
+        {
+            // `f().x`, `a[0].x` and `?.x` are not resolvable
+            if (names.is_empty() || expect_name) valid = false;
+            expect_name = true;
+        }
+        else
+        {
+            names.clear();
+            valid = true;
+            expect_name = false;
+        }
+    }
+
+    // the chain must be at the end of the input, and not start with a number
+    if (!valid || last.kind == jsb::internal::ScriptToken::End || last.end != (size_t) utf8.length()) return false;
+    if (names.is_empty() || is_digit(utf8[names[0].begin])) return false;
+    const uint32_t path_len = expect_name ? names.size() : names.size() - 1;
+    r_prefix = expect_name ? String() : lexer.to_string(names[path_len]);
+    for (uint32_t index = 0; index < path_len; ++index)
+    {
+        r_path.push_back(lexer.to_string(names[index]));
+    }
+    return true;
 }
 
-static bool is_auto_complete_allowed(const String& p_text)
+Vector<String> GodotJSREPL::collect_candidates(const String& p_text)
 {
+    Vector<String> candidates;
 #if JSB_REPL_AUTO_COMPLETE
-    // a rough rule to allow auto-complete
-    return !p_text.is_empty() && !p_text.contains("(");
-#else
-    return false;
+    Vector<String> path;
+    String prefix;
+    if (p_text.is_empty() || !parse_completion_path(p_text, path, prefix)) return candidates;
+
+    GodotJSScriptLanguage* lang = GodotJSScriptLanguage::get_singleton();
+    jsb_check(lang);
+    Vector<String> names;
+    if (lang->get_environment()->enumerate_properties(path, prefix, kAutoCompleteBudgetMs, names) != OK) return candidates;
+
+    names.sort();
+    const String head = p_text.substr(0, p_text.length() - prefix.length());
+    for (const String& name : names)
+    {
+        candidates.push_back(head + name);
+    }
 #endif
+    return candidates;
 }
 
 void GodotJSREPL::_input_changed(const String &p_text)
 {
-    // if (input_submitting_) return;
-
-    //TODO we haven't implemented the js function invocation from outside of Realm, just temporarily call as source code eval
-    const PackedStringArray results =
-        is_auto_complete_allowed(p_text)
-            ? (PackedStringArray) eval_source(jsb_format("require('jsb.editor.main').auto_complete('%s')", encode_string(p_text))).to_variant()
-            : PackedStringArray();
-    _show_candidates(results);
+    // nothing is evaluated for auto-complete, properties are only enumerated from the statically resolved object
+    _show_candidates(collect_candidates(p_text));
 }
 
 void GodotJSREPL::_show_candidates(const Vector<String>& p_items)
@@ -303,12 +358,19 @@ void GodotJSREPL::_input_submitted(const String& p_text)
     if (p_text.is_empty()) return;
 
     check_install();
-    input_submitting_ = true;
     add_line(p_text);
     input_box_->clear();
-    const jsb::JSValueMove value = eval_source(p_text);
-    add_string(value.to_string());
     add_history(p_text);
+
+    // evaluate after the input is echoed, a promise result is printed when it's settled (see `repl_eval`)
+    call_deferred(sn_evaluate_, p_text);
+}
+
+void GodotJSREPL::_evaluate(const String& p_text)
+{
+    input_submitting_ = true;
+    const jsb::JSValueMove value = eval_source(jsb_format("require('jsb.editor.main').repl_eval(%s)", JSON::stringify(p_text)));
+    add_string(value.to_string());
     input_submitting_ = false;
 }
 
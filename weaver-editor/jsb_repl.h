@@ -28,10 +28,14 @@ private:
     Vector<OutputLine> lines_;
 
     enum { kMaxHistoryCount = 10 };
+
+    // time budget of enumerating properties for auto-complete
+    enum { kAutoCompleteBudgetMs = 20 };
     Vector<String> history_;
 
     jsb::internal::DoubleBuffered<String> output_backlog_;
     StringName sn_backlog_flush_;
+    StringName sn_evaluate_;
 
 private:
     void _update_theme();
@@ -51,12 +55,13 @@ protected:
     void _notification(int p_what);
     void _show_candidates(const Vector<String>& p_items);
     void _backlog_flush();
+    void _evaluate(const String& p_text);
 
     void add_string(const String& p_str);
     void add_line(const String& p_line);
     void add_history(const String& p_text);
     jsb::JSValueMove eval_source(const String& p_code);
-    String encode_string(const String& p_text);
+    Vector<String> collect_candidates(const String& p_text);
     void check_install();
     void check_tsc();
 
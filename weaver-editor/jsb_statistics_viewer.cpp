@@ -54,12 +54,13 @@ void GodotJSStatisticsViewer::on_timer()
     {
         add_row(index++, field);
     }
-    add_row(index++, "jsb:objects", jsb_format("%d (%s)", stats.objects, String::humanize_size(stats.objects * jsb::internal::SArray<jsb::ObjectHandle>::get_slot_size())));
+    add_row(index++, "jsb:objects", jsb_format("%d (%s, %d bytes per binding)", stats.objects, String::humanize_size(stats.objects_memory), (uint64_t) jsb::ObjectDB::get_bytes_per_object()));
     add_row(index++, "jsb:native_classes", itos(stats.native_classes));
     add_row(index++, "jsb:script_classes", itos(stats.script_classes));
     add_row(index++, "jsb:cached_string_names", itos(stats.cached_string_names));
     add_row(index++, "jsb:persistent_objects", uitos(stats.persistent_objects));
     add_row(index++, "jsb:allocated_variants", uitos(stats.allocated_variants));
+    add_row(index++, "jsb:valuetypes", jsb_format("%d created, %d recycled (last frame), %d pooled", stats.valuetypes_created, stats.valuetypes_recycled, stats.pooled_valuetypes));
     for (; index < tree_root->get_child_count(); ++index)
     {
         tree_root->get_child(index)->set_visible(false);
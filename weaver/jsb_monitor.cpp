@@ -28,11 +28,15 @@
 GodotJSMonitor::GodotJSMonitor()
 {
     JSB_NEW_MONITOR(objects);
+    JSB_NEW_MONITOR(objects_memory);
     JSB_NEW_MONITOR(native_classes);
     JSB_NEW_MONITOR(script_classes);
     JSB_NEW_MONITOR(cached_string_names);
     JSB_NEW_MONITOR(persistent_objects);
     JSB_NEW_MONITOR(allocated_variants);
+    JSB_NEW_MONITOR(valuetypes_created);
+    JSB_NEW_MONITOR(valuetypes_recycled);
+    JSB_NEW_MONITOR(pooled_valuetypes);
 #if JSB_WITH_V8
     JSB_NEW_MONITOR(heap_size);
 #elif JSB_WITH_QUICKJS
@@ -43,11 +47,15 @@ GodotJSMonitor::GodotJSMonitor()
 void GodotJSMonitor::_bind_methods()
 {
     JSB_BIND_MONITOR(objects);
+    JSB_BIND_MONITOR(objects_memory);
     JSB_BIND_MONITOR(native_classes);
     JSB_BIND_MONITOR(script_classes);
     JSB_BIND_MONITOR(cached_string_names);
     JSB_BIND_MONITOR(persistent_objects);
     JSB_BIND_MONITOR(allocated_variants);
+    JSB_BIND_MONITOR(valuetypes_created);
+    JSB_BIND_MONITOR(valuetypes_recycled);
+    JSB_BIND_MONITOR(pooled_valuetypes);
 #if JSB_WITH_V8
     JSB_BIND_MONITOR(heap_size);
 #elif JSB_WITH_QUICKJS
@@ -56,11 +64,15 @@ void GodotJSMonitor::_bind_methods()
 }
 
 JSB_DEFINE_MONITOR(objects);
+JSB_DEFINE_MONITOR(objects_memory);
 JSB_DEFINE_MONITOR(native_classes);
 JSB_DEFINE_MONITOR(script_classes);
 JSB_DEFINE_MONITOR(cached_string_names);
 JSB_DEFINE_MONITOR(persistent_objects);
 JSB_DEFINE_MONITOR(allocated_variants);
+JSB_DEFINE_MONITOR(valuetypes_created);
+JSB_DEFINE_MONITOR(valuetypes_recycled);
+JSB_DEFINE_MONITOR(pooled_valuetypes);
 
 #if JSB_WITH_V8
     JSB_DEFINE_CUSTOM_MONITOR(heap_size, u.u64_cap[0]);
@@ -21,11 +21,15 @@ protected:
     void flush();
 
     JSB_DECLARE_MONITOR(objects);
+    JSB_DECLARE_MONITOR(objects_memory);
     JSB_DECLARE_MONITOR(native_classes);
     JSB_DECLARE_MONITOR(script_classes);
     JSB_DECLARE_MONITOR(cached_string_names);
     JSB_DECLARE_MONITOR(persistent_objects);
     JSB_DECLARE_MONITOR(allocated_variants);
+    JSB_DECLARE_MONITOR(valuetypes_created);
+    JSB_DECLARE_MONITOR(valuetypes_recycled);
+    JSB_DECLARE_MONITOR(pooled_valuetypes);
 
 #if JSB_WITH_V8
     JSB_DECLARE_MONITOR(heap_size);
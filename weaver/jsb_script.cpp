@@ -413,9 +413,12 @@ void GodotJSScript::get_script_signal_list(List<MethodInfo>* r_signals) const
 
     for (const auto& it : script_class_info_.signals)
     {
-        //TODO details?
         MethodInfo item = {};
         item.name = it.key;
+        for (const String& argument : it.value.arguments)
+        {
+            item.arguments.push_back(PropertyInfo(Variant::NIL, argument));
+        }
         r_signals->push_back(item);
     }
 }
@@ -555,6 +558,12 @@ void GodotJSScript::load_module_immediately()
     if (_is_valid())
     {
         JSB_LOG(VeryVerbose, "GodotJSScript module loaded %s", path);
+        if (script_class_info_.flags & jsb::ScriptClassFlags::_Patched)
+        {
+            // prototypes of live instances are already patched in place, nothing to rebind
+            JSB_LOG(Verbose, "script instances of %s are reloaded in place", path);
+        }
+        else
         {
             //TODO a dirty but approaching solution for hot-reloading
             //TODO will crash if reloading script instances in worker threads
@@ -12,8 +12,6 @@
 #include "editor/editor_settings.h"
 #include "main/performance.h"
 
-#include "modules/regex/regex.h"
-
 #ifdef TOOLS_ENABLED
 #include "../weaver-editor/templates/templates.gen.h"
 #endif
@@ -24,10 +22,6 @@ GodotJSScriptLanguage::GodotJSScriptLanguage()
     JSB_BENCHMARK_SCOPE(GodotJSScriptLanguage, Construct);
     jsb_check(!singleton_);
     singleton_ = this;
-    js_class_name_matcher1_ = RegEx::create_from_string(R"(\s*exports.default\s*=\s*class\s*(\w+)\s*extends\s*(\w+)\s*\{?)");
-    js_class_name_matcher2_ = RegEx::create_from_string(R"(\s*exports.default\s*=\s*(\w+)\s*;?)");
-    ts_class_name_matcher_ = RegEx::create_from_string(R"(\s*export\s+default\s+class\s+(\w+)\s+extends\s+(\w+))");
-    ts_class_name_tool_matcher_ = RegEx::create_from_string(R"(\s*@tool\s*\(\s*\)\s*\n*\s*export\s+default\s+class\s+(\w+)\s+extends\s+(\w+))");
     jsb::internal::StringNames::create();
 }
 
@@ -82,6 +76,12 @@ void GodotJSScriptLanguage::finish()
     memdelete(monitor_);
 #endif
     once_inited_ = false;
+#ifdef TOOLS_ENABLED
+    if (Engine::get_singleton()->is_editor_hint())
+    {
+        class_header_index_.save();
+    }
+#endif
     environment_->dispose();
     environment_.reset();
 #if !JSB_WITH_WEB && !JSB_WITH_JAVASCRIPTCORE
@@ -97,10 +97,43 @@ void GodotJSScriptLanguage::frame()
     const uint64_t elapsed_milli = (base_ticks - last_ticks_) / 1000ULL; // milliseconds
 
     last_ticks_ = base_ticks;
+#if JSB_WITH_ESSENTIALS
+    environment_->get_measure_recorder().reset_frame();
+#endif
     environment_->update(elapsed_milli);
     jsb::Environment::exec_sync_delete();
 }
 
+void GodotJSScriptLanguage::profiling_start()
+{
+#if JSB_WITH_ESSENTIALS
+    if (environment_) environment_->get_measure_recorder().set_enabled(true);
+#endif
+}
+
+void GodotJSScriptLanguage::profiling_stop()
+{
+#if JSB_WITH_ESSENTIALS
+    if (environment_) environment_->get_measure_recorder().set_enabled(false);
+#endif
+}
+
+int GodotJSScriptLanguage::profiling_get_accumulated_data(ProfilingInfo* p_info_arr, int p_info_max)
+{
+#if JSB_WITH_ESSENTIALS
+    if (environment_) return environment_->get_measure_recorder().get_accumulated_data(p_info_arr, p_info_max);
+#endif
+    return 0;
+}
+
+int GodotJSScriptLanguage::profiling_get_frame_data(ProfilingInfo* p_info_arr, int p_info_max)
+{
+#if JSB_WITH_ESSENTIALS
+    if (environment_) return environment_->get_measure_recorder().get_frame_data(p_info_arr, p_info_max);
+#endif
+    return 0;
+}
+
 void GodotJSScriptLanguage::get_reserved_words(List<String>* p_words) const
 {
     static const char* keywords[] = {
@@ -245,82 +278,25 @@ String GodotJSScriptLanguage::get_global_class_name(const String& p_path, String
 {
     // GodotJSScript implementation do not really support threaded access for now.
     // So, we can not load the script module in-place because `get_global_class_name` could be called from EditorFileSystem (background) scan.
-    // And for simplicity, we use regex to extract the class name from the source code instead of using ANTLR or similar.
+    // And for simplicity, we scan the class declaration from the source code with a lightweight tokenizer instead of using ANTLR or similar.
     // Please follow the rules of the class name declaration in the source code.
     //     * .ts files: `export default class ClassName extends BaseClassName`
     //     * .js files: `class ClassName extends BaseClassName` and `exports.default = ClassName` (with or without `;`)
+    // The results are cached by path (and validated by modified time and size), since the editor rescans all files frequently.
 
     // And, we do not support `r_is_abstract` here, please define all abstract class by not exporting it as `default`.
     // It should be equivalent and enough for TS/JS since we do not rely on GodotJSScript to use abstract classes in TS/JS sources.
 
-    Error err;
-    const Ref<FileAccess> file_access = FileAccess::open(p_path, FileAccess::READ, &err);
-    if (err)
+    jsb::internal::ScriptClassHeader header;
+    if (!class_header_index_.get(p_path, header))
     {
-        return String();
+        return {};
     }
-
-    const String source = file_access->get_as_utf8_string();
-    if (jsb::internal::PathUtil::is_recognized_javascript_extension(p_path))
-    {
-        // check if the class id defined in a single line (export default class ClassName extends BaseClassName)
-        jsb_check(!js_class_name_matcher1_.is_null());
-        const Ref<RegExMatch> match1 = js_class_name_matcher1_->search(source);
-        if (match1.is_valid() && match1->get_group_count() == 2)
-        {
-            const String class_name = match1->get_string(1);
-            if (r_base_type) *r_base_type = match1->get_string(2);
-            return class_name;
-        }
-
-        // otherwise, it probably defined in separated lines (firstly, check 'class ClassName extends BaseClassName')
-        jsb_check(!js_class_name_matcher2_.is_null());
-        const Ref<RegExMatch> match2 = js_class_name_matcher2_->search(source);
-        if (match2.is_valid() && match2->get_group_count() == 1)
-        {
-            const String class_name = match2->get_string(1);
-            if (r_base_type)
-            {
-                // then, check 'exports.default = ClassName'
-                const Ref<RegEx> base_matcher = RegEx::create_from_string(jsb::internal::format(R"(\s*class\s*%s\s*extends\s*(\w+)\s*\{?)", class_name));
-                const Ref<RegExMatch> base_match = base_matcher->search(source);
-                if (base_match.is_valid() && base_match->get_group_count() == 1)
-                {
-                    *r_base_type = base_match->get_string(1);
-                }
-            }
-            return class_name;
-        }
-    }
-    else
-    {
-        // hope it's a typescript file
-        jsb_check(!ts_class_name_matcher_.is_null());
-        jsb_check(!ts_class_name_tool_matcher_.is_null());
-
-        // check if it's a tool script (`@tool \n export default class ClassName extends BaseName { `)
-        Ref<RegExMatch> match =  ts_class_name_tool_matcher_->search(source);
-        if (match.is_valid() && match->get_group_count() == 2)
-        {
+    if (r_base_type) *r_base_type = header.base_type;
 #if GODOT_4_4_OR_NEWER
-            if (r_is_tool) *r_is_tool = true;
+    if (r_is_tool) *r_is_tool = header.is_tool;
 #endif
-        }
-        else
-        {
-            // check if it's a normal script (without `@tool`)
-            match = ts_class_name_matcher_->search(source);
-            if (!match.is_valid() || match->get_group_count() != 2)
-            {
-                return {};
-            }
-        }
-
-        const String class_name = match->get_string(1);
-        if (r_base_type) *r_base_type = match->get_string(2);
-        return class_name;
-    }
-    return {};
+    return header.class_name;
 }
 
 bool GodotJSScriptLanguage::handles_global_class_type(const String& p_type) const
@@ -2,6 +2,7 @@
 #define GODOTJS_SCRIPT_LANGUAGE_H
 
 #include "../bridge/jsb_bridge.h"
+#include "../internal/jsb_class_header_index.h"
 
 #include "core/object/script_language.h"
 
@@ -28,15 +29,8 @@ private:
     GodotJSMonitor* monitor_;
 #endif
 
-    // [TS] matches 'export default class ClassName extends BaseName {'
-    Ref<RegEx> ts_class_name_matcher_;
-    Ref<RegEx> ts_class_name_tool_matcher_;
-
-    // [JS] export & declare in two lines, matches 'class ClassName extends BaseName' + 'exports.default = ClassName'
-    Ref<RegEx> js_class_name_matcher2_;
-
-    // [JS] export & declare in a single line, matches 'exports.default = class ClassName extends BaseName'
-    Ref<RegEx> js_class_name_matcher1_;
+    // cached class headers of scripts (for `get_global_class_name`), only changed files are scanned again
+    mutable jsb::internal::ScriptClassHeaderIndex class_header_index_;
 
 public:
     jsb_force_inline static GodotJSScriptLanguage* get_singleton() { return singleton_; }
@@ -150,15 +144,12 @@ public:
     {
     }
 
-    virtual void profiling_start() override
-    {
-    }
-    virtual void profiling_stop() override
-    {
-    }
+    // only `performance.measure` records are reported (see `jsb::JavaScriptMeasureRecorder`)
+    virtual void profiling_start() override;
+    virtual void profiling_stop() override;
 
-    virtual int profiling_get_accumulated_data(ProfilingInfo* p_info_arr, int p_info_max) override { return 0; }
-    virtual int profiling_get_frame_data(ProfilingInfo* p_info_arr, int p_info_max) override { return 0; }
+    virtual int profiling_get_accumulated_data(ProfilingInfo* p_info_arr, int p_info_max) override;
+    virtual int profiling_get_frame_data(ProfilingInfo* p_info_arr, int p_info_max) override;
 
     virtual bool handles_global_class_type(const String& p_type) const override;
 